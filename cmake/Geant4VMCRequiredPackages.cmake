@@ -26,6 +26,9 @@ endif()
 if(Geant4VMC_USE_GEANT4_G3TOG4)
   list(APPEND _components g3tog4)
 endif()
+if(Geant4VMC_USE_GEANT4_GDML)
+  list(APPEND _components gdml)
+endif()
 find_package(Geant4 REQUIRED ${_components})
 
 #-- VGM (optional) -------------------------------------------------------------
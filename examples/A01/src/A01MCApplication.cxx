@@ -467,7 +467,7 @@ void A01MCApplication::FinishEvent()
   }    
  
   if ( fWriteStack || fWriteHits ) {
-    fRootManager->Fill();
+    fRootManager->Fill(gMC->CurrentEvent());
   }  
 
   // Print info about primary particle
@@ -145,5 +145,20 @@ test_g4_vmc_tgeo.out  - G4, geometry defined via VMC,  TGeo navigation
 run_suite.sh
 </pre>  
   which saves all output in run_*.out files.
+
+\section exa_s7 Benchmark macros:
+
+  The benchmark macros in the macro directory are run on the E03 and A01
+  outputs via the run suite script, which saves their output in 
+  bench_*.out files:
+<pre>
+bench_read.C - sequential reading with all or selected branches, 
+               without and with the tree cache
+bench_truth.C - writing and reading the stack particles as a TClonesArray
+                of TParticle and with TMCTruthWriter, and the file sizes
+</pre>
+  When the g4root_NavBench program from the G4Root test is found in PATH,
+  the native Geant4 navigation over the A01 geometry converted with G4Root
+  is timed with the Geant4 voxelization on and off.
   
 */
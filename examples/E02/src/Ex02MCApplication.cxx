@@ -378,7 +378,7 @@ void Ex02MCApplication::FinishEvent()
      gGeoManager->DrawTracks("/*");  // this means all tracks
   }    
 
-  fRootManager->Fill();
+  fRootManager->Fill(gMC->CurrentEvent());
 
   fTrackerSD->EndOfEvent();
 
@@ -526,7 +526,7 @@ void Ex03MCApplication::FinishEvent()
     }	  
   }    
  
-  fRootManager->Fill();
+  fRootManager->Fill(gMC->CurrentEvent());
 
   if (fEventNo % fPrintModulo == 0) 
     fCalorimeterSD->PrintTotal();
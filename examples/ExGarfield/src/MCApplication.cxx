@@ -380,7 +380,7 @@ void MCApplication::FinishEvent()
 
   // update hit info from Garfield
   fSensitiveDetector->UpdateFromGarfield();
-  fRootManager->Fill();
+  fRootManager->Fill(gMC->CurrentEvent());
 
   // reset data
   fSensitiveDetector->EndOfEvent();
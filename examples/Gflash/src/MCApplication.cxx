@@ -463,7 +463,7 @@ void MCApplication::FinishEvent()
 
   fVerbose.FinishEvent();
 
-  fRootManager->Fill();
+  fRootManager->Fill(gMC->CurrentEvent());
 // The application code
 
   fEventTimer->Stop();
@@ -466,7 +466,7 @@ void MCApplication::FinishEvent()
   // cout << "Filling in h0 " << fSensitiveDetector->GetHit(0)->GetEdep()*1e+03 << endl;
   fHistograms[0]->Fill(fSensitiveDetector->GetEdep()*1e+03);
 
-  fRootManager->Fill();
+  fRootManager->Fill(gMC->CurrentEvent());
 
   if (fEventNo % fPrintModulo == 0) {
     fSensitiveDetector->Print();
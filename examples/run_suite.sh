@@ -50,6 +50,30 @@ do
     root.exe -q -b load_g4.C run_g4.C\(\"g4Config2.C\"\)  >& run_g4pl.out
   fi
 
+  # sequential read and MC truth benchmarks on the example output
+  if [ "$EXAMPLE" = "E03" -o "$EXAMPLE" = "A01" ]; then 
+    PROJECT="ExampleA01"
+    BRANCHES="EmCalorimeter HadCalorimeter"
+    if [ "$EXAMPLE" = "E03" ]; then PROJECT="Example03"; BRANCHES="hits"; fi
+    echo "... Running sequential read benchmark on $EXAMPLE output" 
+    root.exe -q -b load_g4.C ../macro/bench_read.C\(\"$PROJECT\",\"$BRANCHES\"\)  >& bench_read.out
+    grep "^   " bench_read.out
+    echo "... Running MC truth write/read/size benchmark on $EXAMPLE output" 
+    root.exe -q -b load_g4.C ../macro/bench_truth.C\(\"$PROJECT\"\)  >& bench_truth.out
+    grep "^   " bench_truth.out
+  fi
+
+  # navigation benchmark: native G4 navigation over the geometry converted 
+  # with G4Root, with voxelization on and off (run if g4root_NavBench, 
+  # built with the G4Root test, is found in PATH)
+  if [ "$EXAMPLE" = "A01" ]; then 
+    if command -v g4root_NavBench > /dev/null 2>&1; then
+      echo "... Running navigation benchmark on $EXAMPLE geometry" 
+      g4root_NavBench A01geometry.root >& bench_nav.out
+      grep "^   " bench_nav.out
+    fi
+  fi
+
 done
         
 cd $CURDIR
@@ -30,6 +30,12 @@ BUILDDIR=""
 RUNG3="root.exe -b -q load_g3.C"
 RUNG4="root.exe -b -q load_g4.C"
 
+# Executable for merging the per-thread output files
+MTROOTMERGE="mtrootMerge"
+
+# Executable for testing the event pipeline
+MTROOTPIPELINETEST=""
+
 # Process script arguments
 for arg in "${@}"
 do
@@ -59,6 +65,12 @@ fi
 if [ "x${BUILDDIR}" != "x" ]; then
   LIBS_FROM_BUILDDIR=$(find ${BUILDDIR} -iname "*.so" -exec dirname {} \; | tr '\r\n' ':')
   export LD_LIBRARY_PATH=${LD_LIBRARY_PATH}:${LIBS_FROM_BUILDDIR}
+  if [ -x ${BUILDDIR}/mtroot/mtrootMerge ]; then
+    MTROOTMERGE=${BUILDDIR}/mtroot/mtrootMerge
+  fi
+  if [ -x ${BUILDDIR}/mtroot/mtrootPipelineTest ]; then
+    MTROOTPIPELINETEST=${BUILDDIR}/mtroot/mtrootPipelineTest
+  fi
 fi
 
 for EXAMPLE in E01 E02 E03 E06 A01 ExGarfield Gflash TR
@@ -301,6 +313,45 @@ do
       cat tmpfile >> $OUT/test_g4_tgeo_nat_pl.out
       rm tmpfile
       if [ "$TMP_FAILED" -ne "0" ]; then FAILED=`expr $FAILED + 1`; else PASSED=`expr $PASSED + 1`; fi
+
+      # merging test, performed only in multi-threading mode, 
+      # when the per-thread files are produced
+      rm -f Example03_*.root
+      $RUNG4 "test_E03_1.C(\"g4Config.C\", kFALSE)" >& $OUT/test_g4_merge.out
+      if [ -f Example03_0.root ]; then
+        echo "... Running test with G4, merging per-thread files" 
+        TMP_FAILED="0"
+        $MTROOTMERGE Example03 Example03.root 0 eventNumber >> $OUT/test_g4_merge.out 2>&1
+        if [ "$?" -ne "0" ]; then TMP_FAILED="1" ; fi
+        $RUNG4 "test_E03_read.C(\"Example03\")" >& tmpfile
+        if [ "$?" -ne "0" ]; then TMP_FAILED="1" ; fi
+        cat tmpfile >> $OUT/test_g4_merge.out
+        $RUNG4 "test_E03_order.C(\"Example03\")" >& tmpfile
+        if [ "$?" -ne "0" ]; then TMP_FAILED="1" ; fi
+        cat tmpfile >> $OUT/test_g4_merge.out
+        rm tmpfile
+        if [ "$TMP_FAILED" -ne "0" ]; then FAILED=`expr $FAILED + 1`; else PASSED=`expr $PASSED + 1`; fi
+      fi
+
+      echo "... Running test with G4, reading hits only with the tree cache" 
+      $RUNG4 "test_E03_read.C(\"Example03\", 5, 10000000, kFALSE)" >& $OUT/test_g4_read_cache.out
+      if [ "$?" -ne "0" ]; then FAILED=`expr $FAILED + 1`; else PASSED=`expr $PASSED + 1`; fi
+
+      echo "... Running test with G4, writing and reading MC truth" 
+      $RUNG4 "test_E03_truth.C(\"Example03\")" >& $OUT/test_g4_truth.out
+      if [ "$?" -ne "0" ]; then FAILED=`expr $FAILED + 1`; else PASSED=`expr $PASSED + 1`; fi
+
+      echo "... Running test with G4, writing and reading hit stream" 
+      $RUNG4 "test_E03_hits.C(\"Example03\")" >& $OUT/test_g4_hits.out
+      if [ "$?" -ne "0" ]; then FAILED=`expr $FAILED + 1`; else PASSED=`expr $PASSED + 1`; fi
+
+      # event pipeline test, performed only when the test executable
+      # is found in the build directory
+      if [ "x${MTROOTPIPELINETEST}" != "x" ]; then
+        echo "... Running test of the event pipeline with several producer threads"
+        $MTROOTPIPELINETEST >& $OUT/test_pipeline.out
+        if [ "$?" -ne "0" ]; then FAILED=`expr $FAILED + 1`; else PASSED=`expr $PASSED + 1`; fi
+      fi
     fi 
   fi   
 
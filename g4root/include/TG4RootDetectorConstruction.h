@@ -35,7 +35,15 @@
 #include "TGeoNode.h"
 #endif
 
-#include <map>
+#ifndef G4LOGICALVOLUME_HH
+#include "G4LogicalVolume.hh"
+#endif
+
+#ifndef G4VPHYSICALVOLUME_HH
+#include "G4VPhysicalVolume.hh"
+#endif
+
+#include <vector>
 
 class TObjArray;
 class TGeoManager;
@@ -51,6 +59,9 @@ class G4VPhysicalVolume;
 class G4Material;
 class TVirtualUserPostDetConstruction;
 
+struct TG4RootMaterialData;
+struct TG4RootVolumeData;
+
 /// \brief Builder creating a pseudo G4 geometry starting from a TGeo geometry.
 ///
 /// To invoke the method Construct() the ROOT geometry must be in memory.
@@ -62,67 +73,55 @@ class TVirtualUserPostDetConstruction;
 ///  - TGeoShape           ---> TG4RootSolid  : public G4Solid           
 ///  - TGeoNode            ---> G4PVPlacement : public G4VPhysicalVolume 
 ///                                                                      
+/// The data of materials and volumes are first extracted from TGeo
+/// by up to GetNconversionThreads() threads; the G4 objects, which
+/// register themselves in the G4 stores, are then created sequentially
+/// in a fixed order, so that the result does not depend on the number
+/// of threads.
+///
 /// \author A. Gheata; CERN
 
 class TG4RootDetectorConstruction : public G4VUserDetectorConstruction {
 
 private:
-   /// the map from TGeoMaterial to G4Material
-   typedef std::map<const TGeoMaterial *, G4Material *>   G4MaterialMap_t;
-   /// the constant iterator for the map from TGeoMaterial to G4Material
-   typedef G4MaterialMap_t::const_iterator            G4MaterialIt_t;
-   /// the value type for the map from TGeoMaterial to G4Material
-   typedef G4MaterialMap_t::value_type                G4MaterialVal_t;
-   G4MaterialMap_t       fG4MaterialMap; //!< map of G4 materials
-
-   /// the map from TGeoVolume to G4LogicalVolume
-   typedef std::map<const TGeoVolume *, G4LogicalVolume *> G4VolumeMap_t;
-   /// the constant iterator for the map from TGeoVolume to G4LogicalVolume
-   typedef G4VolumeMap_t::const_iterator              G4VolumeIt_t;
-   /// the value type for the map from TGeoVolume to G4LogicalVolume
-   typedef G4VolumeMap_t::value_type                  G4VolumeVal_t;
-   G4VolumeMap_t         fG4VolumeMap; //!< map of G4 volumes
-
-   /// the map from G4LogicalVolume to TGeoVolume
-   typedef std::map<const G4LogicalVolume *, TGeoVolume *> VolumeMap_t;
-   /// the constant iterator for the map from G4LogicalVolume to TGeoVolume
-   typedef VolumeMap_t::const_iterator                VolumeIt_t;
-   /// the value type for the map from  G4LogicalVolume to TGeoVolume
-   typedef VolumeMap_t::value_type                    VolumeVal_t;
-   VolumeMap_t           fVolumeMap; //!< map of TGeo volumes
-
-   /// the map from TGeoNode to G4VPhysicalVolume
-   typedef std::map<const TGeoNode *, G4VPhysicalVolume *> G4PVolumeMap_t;
-   /// the constant iterator for the map from TGeoNode to G4VPhysicalVolume
-   typedef G4PVolumeMap_t::const_iterator             G4PVolumeIt_t;
-   /// the value type for the map from TGeoNode to G4VPhysicalVolume
-   typedef G4PVolumeMap_t::value_type                 G4PVolumeVal_t;
-   G4PVolumeMap_t        fG4PVolumeMap; //!< map of G4 physical volumes
-
-   /// the map from G4VPhysicalVolume to TGeoNode
-   typedef std::map<const G4VPhysicalVolume *, TGeoNode *> PVolumeMap_t;
-   /// the constant iterator for the map from G4VPhysicalVolume to TGeoNode
-   typedef PVolumeMap_t::const_iterator               PVolumeIt_t;
-   /// the value type for the map from G4VPhysicalVolume to TGeoNode
-   typedef PVolumeMap_t::value_type                   PVolumeVal_t;
-   PVolumeMap_t          fPVolumeMap; //!< map of TGeo volumes
+   // The mapping tables are dense vectors, so that the lookups done by
+   // TG4RootNavigator at each locate and boundary crossing are a single load.
+   // The TGeo nodes are indexed by the node index stored in their unique ID
+   // (index+1), the G4 volumes by their instance ID.
+   std::vector<G4Material *>        fG4Materials; //!< G4 materials by TGeoMaterial::GetIndex()
+   std::vector<G4LogicalVolume *>   fG4Volumes;   //!< G4 volumes by TGeoVolume::GetNumber()
+   std::vector<TGeoVolume *>        fVolumes;     //!< TGeo volumes by G4 volume instance ID
+   std::vector<TGeoNode *>          fNodes;       //!< TGeo nodes by node index
+   std::vector<G4VPhysicalVolume *> fG4PVolumes;  //!< G4 physical volumes by node index
+   std::vector<TGeoNode *>          fPVNodes;     //!< TGeo nodes by G4 physical volume instance ID
 
 protected:
    Bool_t                fIsConstructed;   ///< flag Construct() called
    TGeoManager          *fGeometry;        ///< TGeo geometry manager
    G4VPhysicalVolume    *fTopPV;           ///< World G4 physical volume
    TVirtualUserPostDetConstruction        *fSDInit;          ///< Sensitive detector hook
+   Int_t                 fNconversionThreads; ///< Max number of threads preparing the conversion
    // Geometry creators
-   void                  CreateG4LogicalVolumes();
-   void                  CreateG4Materials();
+   void                  PrepareConversion(const std::vector<TGeoVolume *> &volumes,
+                                           std::vector<TG4RootMaterialData> &materials,
+                                           std::vector<TG4RootVolumeData> &g4volumes) const;
+   static void          *RunConversionTask(void *task);
+   void                  CreateG4LogicalVolumes(const std::vector<TG4RootVolumeData> &volumes);
+   void                  CreateG4Materials(const std::vector<TG4RootMaterialData> &materials);
    void                  CreateG4Elements();
-   void                  CreateG4PhysicalVolumes();
+   void                  CreateG4PhysicalVolumes(const std::vector<TGeoVolume *> &volumes);
+   void                  CollectVolumes(std::vector<TGeoVolume *> &volumes) const;
    // Converters TGeo->G4 for basic types
    G4VSolid             *CreateG4Solid(TGeoShape *shape);
    G4LogicalVolume      *CreateG4LogicalVolume(TGeoVolume *vol);
+   void                  PrepareG4LogicalVolume(TGeoVolume *vol, TG4RootVolumeData &data) const;
+   G4LogicalVolume      *CreateG4LogicalVolume(const TG4RootVolumeData &data);
    G4VPhysicalVolume    *CreateG4PhysicalVolume(TGeoNode *node);
    G4Material           *CreateG4Material(const TGeoMaterial *mat);
+   void                  PrepareG4Material(const TGeoMaterial *mat, TG4RootMaterialData &data) const;
+   G4Material           *CreateG4Material(const TG4RootMaterialData &data);
    G4RotationMatrix     *CreateG4Rotation(const TGeoMatrix *matrix);
+   void                  AddG4Material(const TGeoMaterial *mat, G4Material *g4mat);
 
 public:
    TG4RootDetectorConstruction();
@@ -146,12 +145,54 @@ public:
    TVirtualUserPostDetConstruction        *GetSDInit() const {return fSDInit;}
                          /// Return the flag Construct() called
    Bool_t                IsConstructed() const {return fIsConstructed;}
+                         /// Return the max number of threads preparing the conversion
+   Int_t                 GetNconversionThreads() const {return fNconversionThreads;}
+                         /// Set the max number of threads preparing the conversion
+   void                  SetNconversionThreads(Int_t nthreads) {fNconversionThreads = nthreads;}
 
    void                  Initialize(TVirtualUserPostDetConstruction *sdinit=0);         
 
 //   ClassDef(TG4RootDetectorConstruction,0)  // Class creating a G4 gometry based on ROOT geometry
 };
 
+//______________________________________________________________________________
+inline G4LogicalVolume *TG4RootDetectorConstruction::GetG4Volume(const TGeoVolume *vol) const
+{
+/// Retreive a G4 logical volume mapped to a ROOT volume.
+   Int_t id = vol->GetNumber();
+   if (id < 0 || id >= Int_t(fG4Volumes.size())) return NULL;
+   return fG4Volumes[id];
+}   
+
+//______________________________________________________________________________
+inline TGeoVolume *TG4RootDetectorConstruction::GetVolume(const G4LogicalVolume *g4vol) const
+{
+/// Retreive a TGeo logical volume mapped to a G4 volume.
+   G4int id = g4vol->GetInstanceID();
+   if (id < 0 || id >= G4int(fVolumes.size())) return NULL;
+   return fVolumes[id];
+}   
+
+//______________________________________________________________________________
+inline G4VPhysicalVolume *TG4RootDetectorConstruction::GetG4VPhysicalVolume(const TGeoNode *node) const
+{
+/// Retreive a G4 physical volume mapped to a ROOT node.
+/// The node index is validated against the node, as the unique ID 
+/// may be modified outside this class.
+   UInt_t id = node->GetUniqueID();
+   if (id == 0 || id > fNodes.size() || fNodes[id-1] != node) return NULL;
+   return fG4PVolumes[id-1];
+}   
+
+//______________________________________________________________________________
+inline TGeoNode *TG4RootDetectorConstruction::GetNode(const G4VPhysicalVolume *g4pvol) const
+{
+/// Retreive a TGeo node mapped to a G4 physical volume.
+   G4int id = g4pvol->GetInstanceID();
+   if (id < 0 || id >= G4int(fPVNodes.size())) return NULL;
+   return fPVNodes[id];
+}   
+
 /// \brief Abstract class for defining links to G4 geometry
 ///
 /// Like sensitive detectors, G4 material properties, user cuts,...
@@ -38,6 +38,8 @@ class TG4RootDetectorConstruction;
 
 class TG4RootNavigator : public G4Navigator {
 
+   enum { kSafetyCacheSize = 8 };
+
 protected:
    TGeoManager          *fGeometry;        ///< TGeo geometry manager
    TGeoNavigator        *fNavigator;       ///< TGeo navigator
@@ -49,8 +51,26 @@ protected:
    G4ThreeVector         fSafetyOrig;      ///< Last computed safety origin
    G4double              fLastSafety;      ///< Last computed safety
    Int_t                 fNzeroSteps;      ///< Number of zero steps in ComputeStep
+   // Navigation counters (per navigator, so per thread in MT mode)
+   Long64_t              fNcomputeStep;    ///< Number of ComputeStep calls
+   Long64_t              fNcomputeSafety;  ///< Number of ComputeSafety calls
+   Long64_t              fNlocate;         ///< Number of LocateGlobalPointAndSetup calls
+   Long64_t              fNtotalZeroSteps; ///< Number of zero steps
+   Long64_t              fNcrossings;      ///< Number of boundary crossings
+   Long64_t              fNfusedCrossings; ///< Number of crossings with history tail update
+   Long64_t              fNsameLocation;   ///< Number of relocations within the same volume
+   Long64_t              fNsafetyCacheHits;///< Number of safeties taken from cache
+   // Safety cache: ring of safety spheres in the current volume
+   G4ThreeVector         fSafetyCachePoints[kSafetyCacheSize]; ///< Safety spheres centers
+   G4double              fSafetyCacheValues[kSafetyCacheSize]; ///< Safety spheres radii
+   Int_t                 fNsafetyCached;   ///< Number of cached safety spheres
+   Int_t                 fSafetyCacheNext; ///< Next cache entry to be overwritten
 private:
    G4VPhysicalVolume *SynchronizeHistory();
+   G4VPhysicalVolume *UpdateHistoryTail(Int_t keptLevel);
+   G4double           GetCachedSafety(const G4ThreeVector &point, 
+                                      G4double proposedMaxLength) const;
+   void               AddCachedSafety(const G4ThreeVector &point, G4double safety);
    TGeoNode          *SynchronizeGeoManager();
       
 public:
@@ -62,6 +82,26 @@ public:
    
    /// Return the navigation history
    G4NavigationHistory *GetHistory() {return &fHistory;}
+
+   // Navigation counters
+                     /// Return the number of ComputeStep calls
+   Long64_t          GetNcomputeStep() const     {return fNcomputeStep;}
+                     /// Return the number of ComputeSafety calls
+   Long64_t          GetNcomputeSafety() const   {return fNcomputeSafety;}
+                     /// Return the number of LocateGlobalPointAndSetup calls
+   Long64_t          GetNlocate() const          {return fNlocate;}
+                     /// Return the number of zero steps
+   Long64_t          GetNzeroSteps() const       {return fNtotalZeroSteps;}
+                     /// Return the number of boundary crossings
+   Long64_t          GetNcrossings() const       {return fNcrossings;}
+                     /// Return the number of crossings with history tail update
+   Long64_t          GetNfusedCrossings() const  {return fNfusedCrossings;}
+                     /// Return the number of relocations within the same volume
+   Long64_t          GetNsameLocation() const    {return fNsameLocation;}
+                     /// Return the number of safeties taken from cache
+   Long64_t          GetNsafetyCacheHits() const {return fNsafetyCacheHits;}
+   void              ResetCounters();
+   void              PrintCounters() const;
    
    // Virtual methods for navigation
    virtual  G4double ComputeStep(const G4ThreeVector &pGlobalPoint,
@@ -31,6 +31,8 @@ class TGeoShape;
 /// \brief GEANT4 solid implemented by a ROOT shape. 
 ///
 /// Visualization methods not implemented.     
+/// The extent used by Geant4 voxelization is computed from 
+/// the TGeo shape bounding box.
 ///
 /// \author A. Gheata; CERN
 
@@ -39,6 +41,8 @@ class TG4RootSolid : public G4VSolid {
 protected:
    TGeoShape            *fShape;      ///< TGeo associated shape
 
+   void GetBoundingBox(G4ThreeVector& pMin, G4ThreeVector& pMax) const;
+
 public:
    TG4RootSolid() : G4VSolid(""), fShape(0) {} ///< Default ctor
    TG4RootSolid(TGeoShape *shape);
@@ -48,6 +52,9 @@ public:
 			   const G4VoxelLimits& pVoxelLimit,
 			   const G4AffineTransform& pTransform,
 			   G4double& pMin, G4double& pMax) const;
+#if G4VERSION_NUMBER >= 1030
+   virtual void BoundingLimits(G4ThreeVector& pMin, G4ThreeVector& pMax) const;
+#endif
    virtual EInside Inside(const G4ThreeVector& p) const;
    virtual G4ThreeVector SurfaceNormal(const G4ThreeVector& p) const;
    virtual G4double DistanceToIn(const G4ThreeVector& p,
@@ -16,6 +16,7 @@
 
 #include "TGeoManager.h"
 #include "TGeoMatrix.h"
+#include "TStopwatch.h"
 #include "G4UnitsTable.hh"
 #include "G4Material.hh"
 #include "G4PVPlacement.hh"
@@ -26,6 +27,8 @@
 #include "G4GeometryManager.hh"
 #include "G4PhysicalConstants.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
+#include "TMath.h"
 
 #include "TG4RootNavMgr.h"
 #include "TList.h"
@@ -35,13 +38,60 @@
 
 //ClassImp(TG4RootDetectorConstruction)
 
+/// Minimum number of materials and volumes per conversion thread
+static const Int_t gMinItemsPerConversionThread = 1000;
+
+/// The G4 material data extracted from a TGeo material
+struct TG4RootMaterialData {
+   const TGeoMaterial   *fMaterial;    ///< the TGeo material
+   G4String              fName;        ///< the material name
+   G4double              fDensity;     ///< the density
+   G4State               fState;       ///< the state
+   G4double              fTemperature; ///< the temperature
+   G4double              fPressure;    ///< the pressure
+   Bool_t                fIsVacuum;    ///< if converted in the vacuum
+   Bool_t                fIsMixture;   ///< if mixture
+   Int_t                 fMissingZ;    ///< Z of a mixture element not found (0 if none)
+   std::vector<G4String> fElNames;     ///< the elements names (mixture only)
+   std::vector<G4String> fElSymbols;   ///< the elements symbols (mixture only)
+   std::vector<G4double> fZ;           ///< the elements Z
+   std::vector<G4double> fA;           ///< the elements A
+   std::vector<G4double> fW;           ///< the elements weights (mixture only)
+};
+
+/// The G4 logical volume data extracted from a TGeo volume
+struct TG4RootVolumeData {
+   TGeoVolume           *fVolume;      ///< the TGeo volume
+   G4String              fName;        ///< the volume name
+   TGeoShape            *fShape;       ///< the shape
+   const TGeoMaterial   *fMaterial;    ///< the material
+};
+
+/// The range of materials and volumes for which a conversion thread 
+/// extracts the data
+struct TG4RootConversionTask {
+   const TG4RootDetectorConstruction *fConstruction; ///< the detector construction
+   const std::vector<TGeoVolume *>   *fVolumes;      ///< the volumes
+   std::vector<TG4RootMaterialData>  *fMaterialsData;///< the materials data
+   std::vector<TG4RootVolumeData>    *fVolumesData;  ///< the volumes data
+   Int_t                              fFirst;        ///< the first item
+   Int_t                              fLast;         ///< the last item + 1
+};
+
 //______________________________________________________________________________
 TG4RootDetectorConstruction::TG4RootDetectorConstruction() 
                             :G4VUserDetectorConstruction(),
+                             fG4Materials(),
+                             fG4Volumes(),
+                             fVolumes(),
+                             fNodes(),
+                             fG4PVolumes(),
+                             fPVNodes(),
                              fIsConstructed(kFALSE),
                              fGeometry(0),
                              fTopPV(0),
-                             fSDInit(0)
+                             fSDInit(0),
+                             fNconversionThreads(1)
 {
 /// Dummy ctor.
 }
@@ -49,12 +99,20 @@ TG4RootDetectorConstruction::TG4RootDetectorConstruction()
 //______________________________________________________________________________
 TG4RootDetectorConstruction::TG4RootDetectorConstruction(TGeoManager *geom) 
                             :G4VUserDetectorConstruction(),
+                             fG4Materials(),
+                             fG4Volumes(),
+                             fVolumes(),
+                             fNodes(),
+                             fG4PVolumes(),
+                             fPVNodes(),
                              fIsConstructed(kFALSE),
                              fGeometry(geom),
                              fTopPV(0),
-                             fSDInit(0)
+                             fSDInit(0),
+                             fNconversionThreads(1)
 {
 /// Default ctor.
+   fNconversionThreads = G4Threading::G4GetNumberOfCores();
    if (!geom || !geom->IsClosed()) {
       G4Exception("TG4RootDetectorConstruction::TG4RootDetectorConstruction",
                   "G4Root_F001", FatalException, 
@@ -144,9 +202,14 @@ G4VPhysicalVolume *TG4RootDetectorConstruction::Construct()
    if (fTopPV) return fTopPV; 
    // Convert reflections via TGeo reflection factory
    fGeometry->ConvertReflections();
-   CreateG4Materials();
-//   CreateG4LogicalVolumes();
-   CreateG4PhysicalVolumes();
+   std::vector<TGeoVolume *> volumes;
+   CollectVolumes(volumes);
+   std::vector<TG4RootMaterialData> materialsData;
+   std::vector<TG4RootVolumeData> volumesData;
+   PrepareConversion(volumes, materialsData, volumesData);
+   CreateG4Materials(materialsData);
+   CreateG4LogicalVolumes(volumesData);
+   CreateG4PhysicalVolumes(volumes);
    TG4RootNavMgr *navMgr = TG4RootNavMgr::GetInstance(fGeometry);
    TG4RootNavigator *nav = navMgr->GetNavigator();
    nav->SetDetectorConstruction(this);
@@ -165,47 +228,152 @@ void TG4RootDetectorConstruction::ConstructSDandField()
 }  
 
 //______________________________________________________________________________
-void TG4RootDetectorConstruction::CreateG4LogicalVolumes()
+void TG4RootDetectorConstruction::PrepareConversion(const std::vector<TGeoVolume *> &volumes,
+                                                    std::vector<TG4RootMaterialData> &materials,
+                                                    std::vector<TG4RootVolumeData> &g4volumes) const
 {
-/// Create logical volumes for GEANT4 based on TGeo volumes.
-   TIter next(fGeometry->GetListOfVolumes());
-   TGeoVolume *vol;
-   while ((vol=(TGeoVolume*)next())) {
-      CreateG4LogicalVolume(vol);
+/// Extract the data of all materials and of the given volumes needed 
+/// to create the G4 objects. The work is shared by up to fNconversionThreads
+/// threads, as it only reads the TGeo objects; the G4 objects are then 
+/// created sequentially, as their constructors register them in the G4 stores.
+   TStopwatch timer;
+   // Build the element table before starting threads
+   fGeometry->GetElementTable();
+   TList *listOfMaterials = fGeometry->GetListOfMaterials();
+   Int_t nmaterials = listOfMaterials->GetSize();
+   Int_t nvolumes = volumes.size();
+   materials.resize(nmaterials);
+   g4volumes.resize(nvolumes);
+   TIter next(listOfMaterials);
+   TGeoMaterial *mat;
+   Int_t imat = 0;
+   while ((mat=(TGeoMaterial*)next())) materials[imat++].fMaterial = mat;
+   for (Int_t i=0; i<nvolumes; i++) g4volumes[i].fVolume = volumes[i];
+
+   Int_t nitems = nmaterials + nvolumes;
+   Int_t nthreads = TMath::Min(fNconversionThreads, nitems/gMinItemsPerConversionThread);
+   if (nthreads < 1) nthreads = 1;
+   std::vector<TG4RootConversionTask> tasks(nthreads);
+   for (Int_t i=0; i<nthreads; i++) {
+      tasks[i].fConstruction = this;
+      tasks[i].fVolumes = &volumes;
+      tasks[i].fMaterialsData = &materials;
+      tasks[i].fVolumesData = &g4volumes;
+      tasks[i].fFirst = Long64_t(nitems)*i/nthreads;
+      tasks[i].fLast = Long64_t(nitems)*(i+1)/nthreads;
    }
-   G4cout << "===> GEANT4 logical volumes created and mapped to TGeo ones..." << G4endl;
+#ifdef G4MULTITHREADED
+   std::vector<G4Thread> threads(nthreads);
+   for (Int_t i=1; i<nthreads; i++) 
+      G4THREADCREATE(&threads[i], &TG4RootDetectorConstruction::RunConversionTask, &tasks[i]);
+   RunConversionTask(&tasks[0]);
+   for (Int_t i=1; i<nthreads; i++) G4THREADJOIN(threads[i]);
+#else
+   for (Int_t i=0; i<nthreads; i++) RunConversionTask(&tasks[i]);
+#endif
+   G4cout << "===> GEANT4 conversion data of " << nmaterials << " materials and " 
+          << nvolumes << " volumes prepared by " << nthreads << " thread(s) in " 
+          << timer.RealTime() << " s" << G4endl;
 }
 
 //______________________________________________________________________________
-void TG4RootDetectorConstruction::CreateG4PhysicalVolumes()
+void *TG4RootDetectorConstruction::RunConversionTask(void *object)
+{
+/// The conversion thread function: extract the data of the materials
+/// and volumes in the task range. The materials come first in the range.
+   TG4RootConversionTask *task = static_cast<TG4RootConversionTask*>(object);
+   Int_t nmaterials = task->fMaterialsData->size();
+   for (Int_t i=task->fFirst; i<task->fLast; i++) {
+      if (i < nmaterials) {
+         TG4RootMaterialData &data = (*task->fMaterialsData)[i];
+         task->fConstruction->PrepareG4Material(data.fMaterial, data);
+      } else {
+         TG4RootVolumeData &data = (*task->fVolumesData)[i-nmaterials];
+         task->fConstruction->PrepareG4LogicalVolume(data.fVolume, data);
+      }
+   }
+   return 0;
+}
+
+//______________________________________________________________________________
+void TG4RootDetectorConstruction::CreateG4LogicalVolumes(const std::vector<TG4RootVolumeData> &volumes)
+{
+/// Create logical volumes for GEANT4 based on the prepared TGeo volumes
+/// data. Only the volumes used in the geometry tree (see CollectVolumes())
+/// are converted.
+   TStopwatch timer;
+   for (size_t i=0; i<volumes.size(); i++) {
+      if (!GetG4Volume(volumes[i].fVolume)) CreateG4LogicalVolume(volumes[i]);
+   }   
+   G4cout << "===> GEANT4 logical volumes created and mapped to TGeo ones in " 
+          << timer.RealTime() << " s" << G4endl;
+}
+
+//______________________________________________________________________________
+void TG4RootDetectorConstruction::CollectVolumes(std::vector<TGeoVolume *> &volumes) const
+{
+/// Collect the volumes of the geometry tree starting from the top volume,
+/// each volume once, in a breadth-first order. The mother volume of
+/// the daughter nodes is fixed if it was not set to the volume containing
+/// the node. 
+   std::vector<Bool_t> isCollected(fGeometry->GetListOfVolumes()->GetEntriesFast(), kFALSE);
+   TGeoVolume *top = fGeometry->GetTopVolume();
+   isCollected[top->GetNumber()] = kTRUE;
+   volumes.push_back(top);
+   for (size_t i=0; i<volumes.size(); i++) {
+      TGeoVolume *vol = volumes[i];
+      for (Int_t id=0; id<vol->GetNdaughters(); id++) {
+         TGeoNode *node = vol->GetNode(id);
+         if (node->GetMotherVolume() != vol) node->SetMotherVolume(vol);
+         TGeoVolume *daughter = node->GetVolume();
+         Int_t number = daughter->GetNumber();
+         if (number >= Int_t(isCollected.size())) isCollected.resize(number+1, kFALSE);
+         if (isCollected[number]) continue;
+         isCollected[number] = kTRUE;
+         volumes.push_back(daughter);
+      }
+   }
+}
+
+//______________________________________________________________________________
+void TG4RootDetectorConstruction::CreateG4PhysicalVolumes(const std::vector<TGeoVolume *> &volumes)
 {
 /// Create physical volumes for GEANT4 based on TGeo hierarchy.
+/// As the TGeo nodes are shared by all instances of their mother volume,
+/// one G4 physical volume is created per node; the nodes are taken
+/// from the volumes of the geometry tree (see CollectVolumes()), 
+/// so that each volume is traversed once.
+   TStopwatch timer;
    TGeoNode *node = fGeometry->GetTopNode();
    fTopPV = CreateG4PhysicalVolume(node);
-   TGeoIterator next(fGeometry->GetTopVolume());
-   TGeoNode *mother;
-   while ((node=next())) {
-      mother = next.GetNode(next.GetLevel()-1);
-      if (mother && node->GetMotherVolume() != mother->GetVolume())
-         node->SetMotherVolume(mother->GetVolume());
-      CreateG4PhysicalVolume(node);
+   Int_t nplacements = 0;
+   for (size_t i=0; i<volumes.size(); i++) {
+      for (Int_t id=0; id<volumes[i]->GetNdaughters(); id++) {
+         CreateG4PhysicalVolume(volumes[i]->GetNode(id));
+         nplacements++;
+      }   
    }
    
    G4cout << "===> GEANT4 physical volumes created and mapped to TGeo hierarchy..." << G4endl;
+   G4cout << "     " << nplacements << " placements created in " 
+          << timer.RealTime() << " s" << G4endl;
 }
 
 //______________________________________________________________________________
-void TG4RootDetectorConstruction::CreateG4Materials()
+void TG4RootDetectorConstruction::CreateG4Materials(const std::vector<TG4RootMaterialData> &materials)
 {
-/// Create GEANT4 native materials and map them to the corresponding TGeo ones.
+/// Create GEANT4 native materials based on the prepared TGeo materials data
+/// and map them to the corresponding TGeo ones.
+   TStopwatch timer;
    if (G4UnitDefinition::GetUnitsTable().size()==0) G4UnitDefinition::BuildUnitsTable();
 //   G4cout << "Units table: " << G4endl;
 //   G4UnitDefinition::PrintUnitsTable();
 //   CreateG4Elements();
-   TIter next(fGeometry->GetListOfMaterials());
-   TGeoMaterial *mat;
-   while ((mat=(TGeoMaterial*)next())) CreateG4Material(mat);
-   G4cout << "===> GEANT4 materials created and mapped to TGeo ones..." << G4endl;
+   for (size_t i=0; i<materials.size(); i++) {
+      if (!GetG4Material(materials[i].fMaterial)) CreateG4Material(materials[i]);
+   }   
+   G4cout << "===> GEANT4 materials created and mapped to TGeo ones in " 
+          << timer.RealTime() << " s" << G4endl;
 }   
 
 //______________________________________________________________________________
@@ -237,21 +405,44 @@ G4LogicalVolume *TG4RootDetectorConstruction::CreateG4LogicalVolume(TGeoVolume *
    if (!vol) return NULL;
    G4LogicalVolume *pVolume = GetG4Volume(vol);
    if (pVolume) return pVolume;
-   G4String sname(vol->GetName());
-   G4VSolid *pSolid = CreateG4Solid(vol->GetShape());
+   TG4RootVolumeData data;
+   PrepareG4LogicalVolume(vol, data);
+   return CreateG4LogicalVolume(data);
+}
+
+//______________________________________________________________________________
+void TG4RootDetectorConstruction::PrepareG4LogicalVolume(TGeoVolume *vol, 
+                                                         TG4RootVolumeData &data) const
+{
+/// Extract the data needed to create a G4LogicalVolume from a TGeo volume.
+/// The TGeo volume is only read, so that this method can be called 
+/// in parallel for different volumes.
+   data.fVolume = vol;
+   data.fName = vol->GetName();
+   data.fShape = vol->GetShape();
+   if (vol->IsAssembly()) {
+      // First() does not update the list cache, unlike At()
+      data.fMaterial = (TGeoMaterial*)fGeometry->GetListOfMaterials()->First();
+   } else {
+      data.fMaterial = vol->GetMedium()->GetMaterial();
+   }
+}
+
+//______________________________________________________________________________
+G4LogicalVolume *TG4RootDetectorConstruction::CreateG4LogicalVolume(const TG4RootVolumeData &data)
+{
+/// Create a G4LogicalVolume object and its solid from the prepared TGeo
+/// volume data.
+   TGeoVolume *vol = data.fVolume;
+   G4VSolid *pSolid = CreateG4Solid(data.fShape);
    if (!pSolid) {
       G4ExceptionDescription description;
       description << "      " 
-        << "Cannot make solid from shape: " << vol->GetShape()->GetName();
+        << "Cannot make solid from shape: " << data.fShape->GetName();
       G4Exception("TG4RootDetectorConstruction::CreateG4LogicalVolume",
                   "G4Root_F002", FatalException, description);
    }   
-   G4Material *pMaterial = 0;
-   if (vol->IsAssembly()) {
-      pMaterial = GetG4Material((TGeoMaterial*)fGeometry->GetListOfMaterials()->At(0));
-   } else {
-      pMaterial = GetG4Material(vol->GetMedium()->GetMaterial());
-   }
+   G4Material *pMaterial = GetG4Material(data.fMaterial);
    if (!pMaterial) {
       G4ExceptionDescription description;
       description << "      " 
@@ -259,10 +450,14 @@ G4LogicalVolume *TG4RootDetectorConstruction::CreateG4LogicalVolume(TGeoVolume *
       G4Exception("TG4RootDetectorConstruction::CreateG4LogicalVolume",
                   "G4Root_F003", FatalException, description);
    }   
-   pVolume = new G4LogicalVolume(pSolid, pMaterial, sname, 
+   G4LogicalVolume *pVolume = new G4LogicalVolume(pSolid, pMaterial, data.fName, 
                                                   NULL, NULL, NULL, false);
-   fG4VolumeMap.insert(G4VolumeVal_t(vol, pVolume));
-   fVolumeMap.insert(VolumeVal_t(pVolume, vol));
+   Int_t volId = vol->GetNumber();
+   if (volId >= Int_t(fG4Volumes.size())) fG4Volumes.resize(volId+1, 0);
+   if (volId >= 0) fG4Volumes[volId] = pVolume;
+   G4int g4VolId = pVolume->GetInstanceID();
+   if (g4VolId >= G4int(fVolumes.size())) fVolumes.resize(g4VolId+1, 0);
+   fVolumes[g4VolId] = vol;
    return pVolume;
 }
    
@@ -300,8 +495,12 @@ G4VPhysicalVolume *TG4RootDetectorConstruction::CreateG4PhysicalVolume(TGeoNode
    
    pPhysicalVolume = new G4PVPlacement(pRot,tlate,pCurrentLogical,pName,
                                        pMotherLogical,pMany,pCopyNo);
-   fG4PVolumeMap.insert(G4PVolumeVal_t(node, pPhysicalVolume));
-   fPVolumeMap.insert(PVolumeVal_t(pPhysicalVolume, node));
+   fNodes.push_back(node);
+   fG4PVolumes.push_back(pPhysicalVolume);
+   node->SetUniqueID(fNodes.size());
+   G4int pvId = pPhysicalVolume->GetInstanceID();
+   if (pvId >= G4int(fPVNodes.size())) fPVNodes.resize(pvId+1, 0);
+   fPVNodes[pvId] = node;
    return pPhysicalVolume;                                             
 }
 
@@ -312,66 +511,109 @@ G4Material *TG4RootDetectorConstruction::CreateG4Material(const TGeoMaterial *ma
 /// just a pointer to the existing one.
    G4Material *pMaterial = GetG4Material(mat);
    if (pMaterial) return pMaterial;
-   G4State state = kStateUndefined;
-   G4double temp = mat->GetTemperature();
-   G4double pressure = mat->GetPressure();
+   TG4RootMaterialData data;
+   PrepareG4Material(mat, data);
+   return CreateG4Material(data);
+}
+
+//______________________________________________________________________________
+void TG4RootDetectorConstruction::PrepareG4Material(const TGeoMaterial *mat,
+                                                    TG4RootMaterialData &data) const
+{
+/// Extract the data needed to create a GEANT4 material from a TGeo one.
+/// The TGeo material and element table are only read, so that this method
+/// can be called in parallel for different materials.
+   data.fMaterial = mat;
+   data.fName = mat->GetName();
+   data.fState = kStateUndefined;
+   data.fTemperature = mat->GetTemperature();
+   data.fPressure = mat->GetPressure();
    switch (mat->GetState()) {
       case TGeoMaterial::kMatStateUndefined :
-         state = kStateUndefined;
+         data.fState = kStateUndefined;
          break;
       case TGeoMaterial::kMatStateSolid :
-         state = kStateSolid;
+         data.fState = kStateSolid;
          break;
       case TGeoMaterial::kMatStateLiquid :
-         state = kStateLiquid;
+         data.fState = kStateLiquid;
          break;
       case TGeoMaterial::kMatStateGas :
-         state = kStateGas;
+         data.fState = kStateGas;
          break;
    }
-   G4String elname, symbol;
-   TGeoElementTable *table = fGeometry->GetElementTable();
-   G4String name(mat->GetName());
-   G4double density = mat->GetDensity()*(g/cm3);
-   if (density<universe_mean_density || mat->GetZ()<1.) {
-      density = universe_mean_density;
-      pMaterial = new G4Material(name, 1., 1.01*g/mole, density, kStateGas, 
-                                 STP_Temperature, 3.e-18*pascal);
-      fG4MaterialMap.insert(G4MaterialVal_t(mat, pMaterial));
-//      G4cout << pMaterial << G4endl;
-      return pMaterial;
-   }   
+   data.fDensity = mat->GetDensity()*(g/cm3);
+   data.fIsVacuum = (data.fDensity<universe_mean_density || mat->GetZ()<1.);
+   data.fIsMixture = mat->IsMixture();
+   data.fMissingZ = 0;
+   if (data.fIsVacuum) return;
                                  
-   if (mat->IsMixture()) {
+   if (data.fIsMixture) {
       // Mixtures
+      TGeoElementTable *table = fGeometry->GetElementTable();
       const TGeoMixture *mixt = (const TGeoMixture *)mat;
       G4int nComponents = mixt->GetNelements();
-//      G4cout << "Creating G4 mixture "<< name << G4endl;
-      pMaterial = new G4Material(name, density, nComponents,state,temp,pressure);
       for (Int_t i=0; i<nComponents; i++) {
 //         TGeoElement *elem = mixt->GetElement(i);
 //         name = elem->GetTitle();
 //         G4Element *pElement = G4Element::GetElement(name);
          TGeoElement *elem = table->GetElement(Int_t(mixt->GetZmixt()[i]));
          if (!elem) {
-            G4ExceptionDescription description;
-            description << "      " 
-              << "Woops: no element corresponding to Z=" << Int_t(mixt->GetZmixt()[i]);
-            G4Exception("TG4RootDetectorConstruction::CreateG4Material",
-                        "G4Root_F006", FatalException, description);
+            data.fMissingZ = Int_t(mixt->GetZmixt()[i]);
+            return;
          }   
-         elname = elem->GetTitle();
-         symbol = elem->GetName();
-         G4Element *pElement = new G4Element(elname, symbol, G4double(mixt->GetZmixt()[i]), G4double(mixt->GetAmixt()[i])*(g/mole));
-         pMaterial->AddElement(pElement, mixt->GetWmixt()[i]);
+         data.fElNames.push_back(elem->GetTitle());
+         data.fElSymbols.push_back(elem->GetName());
+         data.fZ.push_back(G4double(mixt->GetZmixt()[i]));
+         data.fA.push_back(G4double(mixt->GetAmixt()[i])*(g/mole));
+         data.fW.push_back(mixt->GetWmixt()[i]);
+      }   
+   } else {
+      // Materials with 1 element.
+      data.fZ.push_back(G4double(mat->GetZ()));
+      data.fA.push_back(mat->GetA()*g/mole);
+   }  
+}
+
+//______________________________________________________________________________
+G4Material *TG4RootDetectorConstruction::CreateG4Material(const TG4RootMaterialData &data)
+{
+/// Create a GEANT4 material from the prepared TGeo material data
+/// and map it to the TGeo material.
+   G4Material *pMaterial = 0;
+   if (data.fIsVacuum) {
+      pMaterial = new G4Material(data.fName, 1., 1.01*g/mole, universe_mean_density, 
+                                 kStateGas, STP_Temperature, 3.e-18*pascal);
+      AddG4Material(data.fMaterial, pMaterial);
+//      G4cout << pMaterial << G4endl;
+      return pMaterial;
+   }   
+   if (data.fMissingZ) {
+      G4ExceptionDescription description;
+      description << "      " 
+        << "Woops: no element corresponding to Z=" << data.fMissingZ;
+      G4Exception("TG4RootDetectorConstruction::CreateG4Material",
+                  "G4Root_F006", FatalException, description);
+   }   
+                                 
+   if (data.fIsMixture) {
+      // Mixtures
+      G4int nComponents = data.fZ.size();
+//      G4cout << "Creating G4 mixture "<< data.fName << G4endl;
+      pMaterial = new G4Material(data.fName, data.fDensity, nComponents, data.fState,
+                                 data.fTemperature, data.fPressure);
+      for (Int_t i=0; i<nComponents; i++) {
+         G4Element *pElement = new G4Element(data.fElNames[i], data.fElSymbols[i], 
+                                             data.fZ[i], data.fA[i]);
+         pMaterial->AddElement(pElement, data.fW[i]);
       }   
    } else {
       // Materials with 1 element.
-//      G4cout << "Creating G4 material "<< name << G4endl;
-      pMaterial = new G4Material(name, G4double(mat->GetZ()),
-                                 mat->GetA()*g/mole, density, state, temp, pressure);
+//      G4cout << "Creating G4 material "<< data.fName << G4endl;
+      pMaterial = new G4Material(data.fName, data.fZ[0], data.fA[0], data.fDensity, 
+                                 data.fState, data.fTemperature, data.fPressure);
    }  
-   fG4MaterialMap.insert(G4MaterialVal_t(mat, pMaterial));
+   AddG4Material(data.fMaterial, pMaterial);
 //   G4cout << pMaterial << G4endl;
    return pMaterial;
 }
@@ -412,46 +654,21 @@ G4VSolid *TG4RootDetectorConstruction::CreateG4Solid(TGeoShape *shape)
 }
 
 //______________________________________________________________________________
-G4Material *TG4RootDetectorConstruction::GetG4Material(const TGeoMaterial *mat) const
-{
-/// Retreive a G4 material mapped to a ROOT material.
-   G4MaterialIt_t it = fG4MaterialMap.find(mat);
-   if (it != fG4MaterialMap.end()) return it->second;
-   return NULL;
-}   
-
-//______________________________________________________________________________
-G4LogicalVolume *TG4RootDetectorConstruction::GetG4Volume(const TGeoVolume *vol) const
-{
-/// Retreive a G4 logical volume mapped to a ROOT volume.
-   G4VolumeIt_t it = fG4VolumeMap.find(vol);
-   if (it != fG4VolumeMap.end()) return it->second;
-   return NULL;
-}   
-
-//______________________________________________________________________________
-TGeoVolume *TG4RootDetectorConstruction::GetVolume(const G4LogicalVolume *g4vol) const
+void TG4RootDetectorConstruction::AddG4Material(const TGeoMaterial *mat,
+                                                G4Material *g4mat)
 {
-/// Retreive a TGeo logical volume mapped to a G4 volume.
-   VolumeIt_t it = fVolumeMap.find(g4vol);
-   if (it != fVolumeMap.end()) return it->second;
-   return NULL;
+/// Map a G4 material to a ROOT material.
+   Int_t id = const_cast<TGeoMaterial*>(mat)->GetIndex();
+   if (id < 0) return;
+   if (id >= Int_t(fG4Materials.size())) fG4Materials.resize(id+1, 0);
+   fG4Materials[id] = g4mat;
 }   
 
 //______________________________________________________________________________
-G4VPhysicalVolume *TG4RootDetectorConstruction::GetG4VPhysicalVolume(const TGeoNode *node) const
-{
-/// Retreive a G4 physical volume mapped to a ROOT node.
-   G4PVolumeIt_t it = fG4PVolumeMap.find(node);
-   if (it != fG4PVolumeMap.end()) return it->second;
-   return NULL;
-}   
-
-//______________________________________________________________________________
-TGeoNode *TG4RootDetectorConstruction::GetNode(const G4VPhysicalVolume *g4pvol) const
+G4Material *TG4RootDetectorConstruction::GetG4Material(const TGeoMaterial *mat) const
 {
-/// Retreive a TGeo node mapped to a G4 physical volume.
-   PVolumeIt_t it = fPVolumeMap.find(g4pvol);
-   if (it != fPVolumeMap.end()) return it->second;
-   return NULL;
+/// Retreive a G4 material mapped to a ROOT material.
+   Int_t id = const_cast<TGeoMaterial*>(mat)->GetIndex();
+   if (id < 0 || id >= Int_t(fG4Materials.size())) return NULL;
+   return fG4Materials[id];
 }   
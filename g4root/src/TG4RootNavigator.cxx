@@ -15,11 +15,17 @@
 /// \author A. Gheata; CERN
 
 #include "TGeoManager.h"
+#include "TGeoNavigator.h"
+#include "TGeoMatrix.h"
+#include "TGeoVolume.h"
 
 #include "TG4RootDetectorConstruction.h"
 #include "TG4RootNavigator.h"
 
 #include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
+
+#include <cmath>
 
 
 //ClassImp(TG4RootNavigator)
@@ -28,6 +34,7 @@
 static const double gCm = 1./cm; 
 static const double gZeroStepThr = 1.e-3; // >1.e-4 limit in G4PropagatorInField
 static const int    gAbandonZeroSteps = 40; // <50 limit in G4PropagatorInField
+static const double gSafetyCacheFraction = 0.5; // min. fraction of a cached safety to be used
 
 //______________________________________________________________________________
 TG4RootNavigator::TG4RootNavigator()
@@ -40,7 +47,17 @@ TG4RootNavigator::TG4RootNavigator()
                   fNextPoint(),
                   fSafetyOrig(),
                   fLastSafety(0),
-                  fNzeroSteps(0)
+                  fNzeroSteps(0),
+                  fNcomputeStep(0),
+                  fNcomputeSafety(0),
+                  fNlocate(0),
+                  fNtotalZeroSteps(0),
+                  fNcrossings(0),
+                  fNfusedCrossings(0),
+                  fNsameLocation(0),
+                  fNsafetyCacheHits(0),
+                  fNsafetyCached(0),
+                  fSafetyCacheNext(0)
 {
 /// Dummy ctor.
 }
@@ -56,7 +73,17 @@ TG4RootNavigator::TG4RootNavigator(TG4RootDetectorConstruction *dc)
                   fNextPoint(),
                   fSafetyOrig(),
                   fLastSafety(0),
-                  fNzeroSteps(0)
+                  fNzeroSteps(0),
+                  fNcomputeStep(0),
+                  fNcomputeSafety(0),
+                  fNlocate(0),
+                  fNtotalZeroSteps(0),
+                  fNcrossings(0),
+                  fNfusedCrossings(0),
+                  fNsameLocation(0),
+                  fNsafetyCacheHits(0),
+                  fNsafetyCached(0),
+                  fSafetyCacheNext(0)
 {
 /// Default ctor.
    fSafetyOrig.set(kInfinity, kInfinity, kInfinity);
@@ -87,6 +114,39 @@ void TG4RootNavigator::SetDetectorConstruction(TG4RootDetectorConstruction *dc)
    fDetConstruction = dc;
 }
   
+//______________________________________________________________________________
+void TG4RootNavigator::ResetCounters()
+{
+/// Reset the navigation counters.
+   fNcomputeStep = 0;
+   fNcomputeSafety = 0;
+   fNlocate = 0;
+   fNtotalZeroSteps = 0;
+   fNcrossings = 0;
+   fNfusedCrossings = 0;
+   fNsameLocation = 0;
+   fNsafetyCacheHits = 0;
+}
+
+//______________________________________________________________________________
+void TG4RootNavigator::PrintCounters() const
+{
+/// Print the navigation counters of this navigator (thread).
+   G4cout << "TG4RootNavigator counters (thread " << G4Threading::G4GetThreadId() 
+          << "):" << G4endl
+          << "   ComputeStep:               " << fNcomputeStep << G4endl
+          << "   ComputeSafety:             " << fNcomputeSafety 
+          << " (" << fNsafetyCacheHits << " from cache";
+   if (fNcomputeSafety) 
+      G4cout << ", hit rate " << 100.*fNsafetyCacheHits/fNcomputeSafety << " %";
+   G4cout << ")" << G4endl
+          << "   LocateGlobalPointAndSetup: " << fNlocate << G4endl
+          << "   zero steps:                " << fNtotalZeroSteps << G4endl
+          << "   boundary crossings:        " << fNcrossings 
+          << " (" << fNfusedCrossings << " with history tail update)" << G4endl
+          << "   same location relocations: " << fNsameLocation << G4endl;
+}
+  
 //______________________________________________________________________________
 G4double TG4RootNavigator::ComputeStep(const G4ThreeVector &pGlobalPoint,
                                        const G4ThreeVector &pDirection,
@@ -109,12 +169,11 @@ G4double TG4RootNavigator::ComputeStep(const G4ThreeVector &pGlobalPoint,
 
    // The following 2 lines are not needed if G4 calls first LocateGlobalPoint...
 //   fGeometry->ResetState();
-   static Long64_t istep = 0;
-   istep++;
+   fNcomputeStep++;
    
 #ifdef G4ROOT_DEBUG
    G4cout.precision(8);
-   G4cout << "*** ComputeStep #" << istep << ": ***" <<
+   G4cout << "*** ComputeStep #" << fNcomputeStep << ": ***" <<
              fHistory.GetTopVolume()->GetName() << " entered: " << fEnteredDaughter << "  exited: " << fExitedMother << G4endl;
 #endif
    Double_t tol = 0.;
@@ -164,6 +223,7 @@ G4double TG4RootNavigator::ComputeStep(const G4ThreeVector &pGlobalPoint,
    if (step < 1.e3*tol*cm) {
       step = 0.;
       fNzeroSteps++;
+      fNtotalZeroSteps++;
       // Geant4 will abandon the track if the number of zero steps>50 just
       // because it expects a non-zero distance inside the mother to the next daughter
       // The way out is to generate an extra very small fake step in the mother,
@@ -221,6 +281,7 @@ G4VPhysicalVolume* TG4RootNavigator::ResetHierarchyAndLocate(
    fStepEntering = kFALSE;
    fStepExiting = kFALSE;
    fHistory = *h.GetHistory();
+   fNsafetyCached = 0;
    SynchronizeGeoManager();
    fNavigator->InitTrack(point.x()*gCm, point.y()*gCm, point.z()*gCm, direction.x(), direction.y(), direction.z());
    G4VPhysicalVolume *pVol = SynchronizeHistory();
@@ -296,6 +357,7 @@ G4VPhysicalVolume *TG4RootNavigator::SynchronizeHistory()
          // If the phys. volume at this level matches the one in the history, do nothing
          if (pvol==pnewvol) continue;
          // From this level down we need to update G4 history.
+         fNsafetyCached = 0;
          if (level) {
             fHistory.BackLevel(depth-level+1);
             // Now fHistory is at the level i-1 and needs to update level i
@@ -308,15 +370,37 @@ G4VPhysicalVolume *TG4RootNavigator::SynchronizeHistory()
          depth = level;
       } else {
          // This level has to be added to the current history.
+         fNsafetyCached = 0;
          fHistory.NewLevel(pnewvol, kNormal, pnewvol->GetCopyNo());
          depth++;     // depth=level
       }
    }
-   if (depth > level-1) fHistory.BackLevel(depth-level+1);
+   if (depth > level-1) {
+      fNsafetyCached = 0;
+      fHistory.BackLevel(depth-level+1);
+   }   
    if (fNavigator->IsOutside()) pnewvol = NULL;
    return pnewvol;      
 }         
 
+//______________________________________________________________________________
+G4VPhysicalVolume *TG4RootNavigator::UpdateHistoryTail(Int_t keptLevel)
+{
+/// Update the navigation history according the state of TGeoManager 
+/// only below the given level, which is known to be kept in sync.
+/// Returns current physical volume
+   fNsafetyCached = 0;
+   Int_t depth = fHistory.GetDepth();
+   if (depth > keptLevel) fHistory.BackLevel(depth-keptLevel);
+   Int_t geolevel = fNavigator->GetLevel();
+   for (Int_t level=keptLevel+1; level<=geolevel; level++) {
+      TGeoNode *pnode = fNavigator->GetMother(geolevel-level);
+      G4VPhysicalVolume *pnewvol = fDetConstruction->GetG4VPhysicalVolume(pnode);
+      fHistory.NewLevel(pnewvol, kNormal, pnewvol->GetCopyNo());
+   }
+   return fHistory.GetTopVolume();
+}         
+
 //______________________________________________________________________________
 G4VPhysicalVolume* 
 TG4RootNavigator::LocateGlobalPointAndSetup(const G4ThreeVector& globalPoint,
@@ -336,11 +420,10 @@ TG4RootNavigator::LocateGlobalPointAndSetup(const G4ThreeVector& globalPoint,
 ///                     whether daughter of last mother directly 
 ///                     or daughter of that volume's ancestor.
 
-   static Long64_t ilocate = 0;
-   ilocate++;
+   fNlocate++;
 #ifdef G4ROOT_DEBUG
    G4cout.precision(12);
-   G4cout << "LocateGlobalPointAndSetup #" << ilocate << ": point: " << globalPoint << G4endl;
+   G4cout << "LocateGlobalPointAndSetup #" << fNlocate << ": point: " << globalPoint << G4endl;
 #endif
    fNavigator->SetCurrentPoint(globalPoint.x()*gCm, globalPoint.y()*gCm, globalPoint.z()*gCm);
    fEnteredDaughter = fExitedMother = kFALSE;
@@ -367,6 +450,7 @@ TG4RootNavigator::LocateGlobalPointAndSetup(const G4ThreeVector& globalPoint,
    if (fNavigator->IsOutside()) G4cout << "   outside" << G4endl;
 #endif
    if (onBoundary) {
+      fNcrossings++;
       fEnteredDaughter = fStepEntering;
       fExitedMother    = fStepExiting;
       TGeoNode *skip = fNavigator->GetCurrentNode();
@@ -375,9 +459,62 @@ TG4RootNavigator::LocateGlobalPointAndSetup(const G4ThreeVector& globalPoint,
          fNavigator->SetOutside();
          return NULL;
       }   
+      // Fused path: find the deepest level which is kept by the crossing
+      // so that only the tail of the history below it is updated.
+      // When entering, TGeo searches only downwards from the current node; 
+      // when exiting, it does not go above the mother if the point is 
+      // inside the mother (in a geometry without overlaps).
+      // The TGeo state is then checked to be kept at all levels up to this
+      // one by comparing the new TGeo branch with the history, otherwise 
+      // the full synchronization is done.
+      Int_t oldLevel = fNavigator->GetLevel();
+      Int_t keptLevel = -1;
+      if (!fNavigator->IsOutside() && fHistory.GetDepth() == oldLevel) {
+         if (fStepEntering) {
+            keptLevel = oldLevel;
+         } else {
+            Double_t point[3], local[3];
+            point[0] = globalPoint.x()*gCm;
+            point[1] = globalPoint.y()*gCm;
+            point[2] = globalPoint.z()*gCm;
+            fNavigator->GetMotherMatrix(1)->MasterToLocal(point, local);
+            if (fNavigator->GetMother(1)->GetVolume()->Contains(local)) 
+               keptLevel = oldLevel-1;
+         }
+      }      
       fNavigator->CdNext();
       fNavigator->CrossBoundaryAndLocate(fStepEntering, skip);
+      Int_t newLevel = fNavigator->GetLevel();
+      Bool_t isKept = (keptLevel >= 0 && !fNavigator->IsOutside() &&
+                       newLevel >= keptLevel);
+      for (Int_t level=0; isKept && level<=keptLevel; level++) {
+         isKept = (fDetConstruction->GetG4VPhysicalVolume(
+                      fNavigator->GetMother(newLevel-level)) == 
+                   fHistory.GetVolume(level));
+      }
+      if (isKept) {
+         fNfusedCrossings++;
+         G4VPhysicalVolume *target = UpdateHistoryTail(keptLevel);
+#ifdef G4ROOT_DEBUG
+         if (target) G4cout << "   POINT INSIDE: " << target->GetName() << 
+         " entered=" << fEnteredDaughter << " exited=" << fExitedMother << 
+         " (history kept up to level " << keptLevel << ")" << G4endl;
+#endif   
+         return target;
+      }   
    } else {   
+      // Relocation within the same volume: the history is kept
+      if (!fNavigator->IsOutside() && 
+          fHistory.GetDepth() == fNavigator->GetLevel() &&
+          fNavigator->IsSameLocation(globalPoint.x()*gCm, globalPoint.y()*gCm, 
+                                     globalPoint.z()*gCm)) {
+         fNsameLocation++;
+#ifdef G4ROOT_DEBUG
+         G4cout << "   POINT INSIDE: " << fHistory.GetTopVolume()->GetName() << 
+         " (same location)" << G4endl;
+#endif   
+         return fHistory.GetTopVolume();
+      }   
 //      if (!relativeSearch) fNavigator->CdTop();
       fNavigator->FindNode();
    }   
@@ -424,7 +561,7 @@ G4double TG4RootNavigator::ComputeSafety(const G4ThreeVector &globalpoint,
 
 //______________________________________________________________________________
 G4double TG4RootNavigator::ComputeSafety(const G4ThreeVector &globalpoint, 
-                                         const G4double /*pProposedMaxLength*/)
+                                         const G4double pProposedMaxLength)
 {
 /// Calculate the isotropic distance to the nearest boundary from the
 /// specified point in the global coordinate system. 
@@ -438,6 +575,7 @@ G4double TG4RootNavigator::ComputeSafety(const G4ThreeVector &globalpoint,
 ///   fExitedMother = kFALSE;
 ///   fStepEntering = kFALSE;
 ///   fStepExiting = kFALSE;
+   fNcomputeSafety++;
    Double_t d2 = globalpoint.diff2(fNextPoint);
    if (d2 < 1.e-10) {
 #ifdef G4ROOT_DEBUG
@@ -450,13 +588,23 @@ G4double TG4RootNavigator::ComputeSafety(const G4ThreeVector &globalpoint,
 #ifdef G4ROOT_DEBUG
       G4cout << "ComputeSafety: POINT not changed: " << globalpoint << " SKIPPED... oldsafe="<<fLastSafety << G4endl;
 #endif
+      fNsafetyCacheHits++;
       return fLastSafety;
    }   
+   G4double cached = GetCachedSafety(globalpoint, pProposedMaxLength);
+   if (cached > 0.) {
+#ifdef G4ROOT_DEBUG
+      G4cout << "ComputeSafety: POINT in cached safety sphere: " << globalpoint << " safe = " << cached << G4endl;
+#endif
+      fNsafetyCacheHits++;
+      return cached;
+   }   
    fNavigator->ResetState();
    fNavigator->SetCurrentPoint(globalpoint.x()*gCm, globalpoint.y()*gCm, globalpoint.z()*gCm);
    G4double safety = fNavigator->Safety()*cm;
    fSafetyOrig = globalpoint;
    fLastSafety = safety;
+   AddCachedSafety(globalpoint, safety);
 
 #ifdef G4ROOT_DEBUG
    G4cout.precision(12);
@@ -465,6 +613,43 @@ G4double TG4RootNavigator::ComputeSafety(const G4ThreeVector &globalpoint,
    return safety;
 }
    
+//______________________________________________________________________________
+G4double TG4RootNavigator::GetCachedSafety(const G4ThreeVector &point,
+                                           G4double proposedMaxLength) const
+{
+/// Return the safety derived from the cached safety spheres containing 
+/// the point, or 0 if there is no such sphere or the derived safety is 
+/// too small compared to the sphere radius and the proposed max length.
+/// A safety sphere does not contain any boundary, so the distance from
+/// the point to the sphere surface is a conservative safety.
+   G4double best = 0.;
+   G4double bestRadius = 0.;
+   for (Int_t i=0; i<fNsafetyCached; i++) {
+      G4double radius = fSafetyCacheValues[i];
+      G4double d2 = point.diff2(fSafetyCachePoints[i]);
+      if (d2 >= radius*radius) continue;
+      G4double safety = radius - std::sqrt(d2);
+      if (safety > best) {
+         best = safety;
+         bestRadius = radius;
+      }
+   }
+   if (best >= proposedMaxLength || best >= gSafetyCacheFraction*bestRadius) 
+      return best;
+   return 0.;
+}
+
+//______________________________________________________________________________
+void TG4RootNavigator::AddCachedSafety(const G4ThreeVector &point, G4double safety)
+{
+/// Add the safety sphere in the cache, replacing the oldest one if full.
+   if (safety <= 0.) return;
+   fSafetyCachePoints[fSafetyCacheNext] = point;
+   fSafetyCacheValues[fSafetyCacheNext] = safety;
+   fSafetyCacheNext = (fSafetyCacheNext+1) % kSafetyCacheSize;
+   if (fNsafetyCached < kSafetyCacheSize) fNsafetyCached++;
+}
+   
 //______________________________________________________________________________
 G4TouchableHistoryHandle TG4RootNavigator::CreateTouchableHistoryHandle() const
 {
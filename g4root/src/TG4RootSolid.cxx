@@ -29,6 +29,8 @@
 #endif
 #include "G4VisExtent.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4RandomDirection.hh"
+#include "Randomize.hh"
 
 #include "TG4RootSolid.h"
 #include "TMath.h"
@@ -37,6 +39,8 @@
 
 /// constant for conversion cm <-> mm
 static const Double_t gCm = 1./cm;
+/// maximum number of trials to generate a point on surface
+static const Int_t gMaxSurfaceTrials = 1000;
 
 //______________________________________________________________________________
 TG4RootSolid::TG4RootSolid(TGeoShape *shape)
@@ -47,17 +51,73 @@ TG4RootSolid::TG4RootSolid(TGeoShape *shape)
 }
    
 //______________________________________________________________________________
-G4bool TG4RootSolid::CalculateExtent(const EAxis /*pAxis*/,
-                                     const G4VoxelLimits& /*pVoxelLimit*/,
-				                         const G4AffineTransform& /*pTransform*/,
-				                         G4double& /*pMin*/, G4double& /*pMax*/) const
+G4bool TG4RootSolid::CalculateExtent(const EAxis pAxis,
+                                     const G4VoxelLimits& pVoxelLimit,
+				                         const G4AffineTransform& pTransform,
+				                         G4double& pMin, G4double& pMax) const
 {
 /// Calculate the minimum and maximum extent of the solid, when under the
 /// specified transform, and within the specified limits. If the solid
 /// is not intersected by the region, return false, else return true.
-   G4cout << "Warning: TG4RootSolid::CalculateExtent() not implemented" << G4endl;
-   return false;
+/// The extent is computed from the TGeo bounding box transformed
+/// with the given transformation, so it may be larger than the solid one.
+   G4ThreeVector bmin, bmax;
+   GetBoundingBox(bmin, bmax);
+   
+   // Extent of the transformed box corners
+   G4ThreeVector emin(kInfinity, kInfinity, kInfinity);
+   G4ThreeVector emax(-kInfinity, -kInfinity, -kInfinity);
+   for (Int_t i=0; i<8; i++) {
+      G4ThreeVector corner((i&1) ? bmax.x() : bmin.x(),
+                           (i&2) ? bmax.y() : bmin.y(),
+                           (i&4) ? bmax.z() : bmin.z());
+      corner = pTransform.TransformPoint(corner);
+      for (Int_t j=0; j<3; j++) {
+         if (corner[j] < emin[j]) emin[j] = corner[j];
+         if (corner[j] > emax[j]) emax[j] = corner[j];
+      }
+   }
+
+   // Check the intersection with the voxel limits in all axes
+   const EAxis axes[3] = {kXAxis, kYAxis, kZAxis};
+   for (Int_t j=0; j<3; j++) {
+      if (!pVoxelLimit.IsLimited(axes[j])) continue;
+      if (emin[j] > pVoxelLimit.GetMaxExtent(axes[j])+kCarTolerance ||
+          emax[j] < pVoxelLimit.GetMinExtent(axes[j])-kCarTolerance) return false;
+   }      
+
+   Int_t iaxis = (pAxis == kXAxis) ? 0 : ((pAxis == kYAxis) ? 1 : 2);
+   pMin = emin[iaxis];
+   pMax = emax[iaxis];
+   if (pVoxelLimit.IsLimited(pAxis)) {
+      if (pMin < pVoxelLimit.GetMinExtent(pAxis)) pMin = pVoxelLimit.GetMinExtent(pAxis);
+      if (pMax > pVoxelLimit.GetMaxExtent(pAxis)) pMax = pVoxelLimit.GetMaxExtent(pAxis);
+   }
+   pMin -= kCarTolerance;
+   pMax += kCarTolerance;
+   return true;
 }
+
+//______________________________________________________________________________
+void TG4RootSolid::GetBoundingBox(G4ThreeVector& pMin, G4ThreeVector& pMax) const
+{
+/// Return the limits of the TGeo bounding box in the solid frame.
+   const TGeoBBox *box = (const TGeoBBox*)fShape;
+   const Double_t *origin = box->GetOrigin();
+   G4ThreeVector dim(box->GetDX()*cm, box->GetDY()*cm, box->GetDZ()*cm);
+   G4ThreeVector center(origin[0]*cm, origin[1]*cm, origin[2]*cm);
+   pMin = center - dim;
+   pMax = center + dim;
+}
+
+#if G4VERSION_NUMBER >= 1030
+//______________________________________________________________________________
+void TG4RootSolid::BoundingLimits(G4ThreeVector& pMin, G4ThreeVector& pMax) const
+{
+/// Return the limits of the bounding box of the solid.
+   GetBoundingBox(pMin, pMax);
+}
+#endif
    
 //______________________________________________________________________________
 EInside TG4RootSolid::Inside(const G4ThreeVector& p) const
@@ -207,7 +267,26 @@ G4GeometryType TG4RootSolid::GetEntityType() const
 G4ThreeVector TG4RootSolid::GetPointOnSurface() const
 {
 /// Returns a random point located on the surface of the solid.
-   G4cout << "Warning: TG4RootSolid::GetPointOnSurface() not implemented" << G4endl;
+/// The point is obtained by shooting a ray in a random direction from 
+/// a random point in the bounding box to the shape surface;
+/// the points are not distributed uniformly on the surface.
+   G4ThreeVector bmin, bmax;
+   GetBoundingBox(bmin, bmax);
+   for (Int_t itry=0; itry<gMaxSurfaceTrials; itry++) {
+      G4ThreeVector point(bmin.x() + G4UniformRand()*(bmax.x()-bmin.x()),
+                          bmin.y() + G4UniformRand()*(bmax.y()-bmin.y()),
+                          bmin.z() + G4UniformRand()*(bmax.z()-bmin.z()));
+      G4ThreeVector direction = G4RandomDirection();
+      Double_t pt[3], dir[3];
+      pt[0] = point.x()*gCm; pt[1] = point.y()*gCm; pt[2] = point.z()*gCm;
+      dir[0] = direction.x(); dir[1] = direction.y(); dir[2] = direction.z();
+      Double_t dist = fShape->Contains(pt) ? fShape->DistFromInside(pt, dir, 3) 
+                                           : fShape->DistFromOutside(pt, dir, 3);
+      if (dist >= TGeoShape::Big()) continue;
+      return point + dist*cm*direction;
+   }
+   G4cout << "Warning: TG4RootSolid::GetPointOnSurface() failed for " 
+          << GetName() << G4endl;
    return G4ThreeVector(0.,0.,0.);
 }
 
@@ -0,0 +1,144 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2014 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file NavBench.cc
+/// \brief Benchmark of the native Geant4 navigation over the geometry
+/// converted with G4Root
+///
+/// The Root geometry is converted in Geant4 (with TG4RootSolid wrapping
+/// the TGeo shapes) and navigated with the Geant4 native navigator,
+/// with the Geant4 smart voxelization switched on and off.
+/// The same random points and directions are used in both modes: for each
+/// of them the point is located and the step to the next boundary
+/// is computed. The times (TStopwatch) and the sum of the steps, which
+/// has to be the same in both modes, are printed.
+///
+/// Usage: g4root_NavBench geometry.root [nofPoints]
+
+#include "TGeoManager.h"
+#include "TG4RootDetectorConstruction.h"
+#include "TG4RootNavMgr.h"
+
+#include "TRandom3.h"
+#include "TStopwatch.h"
+#include "TMath.h"
+
+#include "G4Navigator.hh"
+#include "G4GeometryManager.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VSolid.hh"
+#include "G4VisExtent.hh"
+#include "G4ThreeVector.hh"
+#include "G4ios.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+//______________________________________________________________________________
+void GeneratePoints(const G4VisExtent& extent, G4int nofPoints,
+                    std::vector<G4ThreeVector>& points,
+                    std::vector<G4ThreeVector>& directions)
+{
+/// Generate random points inside the world extent and random directions
+/// (with a fixed seed, so that the runs can be compared).
+
+   TRandom3 random(4357);
+   for (G4int i=0; i<nofPoints; ++i) {
+      G4double x = extent.GetXmin() + random.Rndm()*(extent.GetXmax()-extent.GetXmin());
+      G4double y = extent.GetYmin() + random.Rndm()*(extent.GetYmax()-extent.GetYmin());
+      G4double z = extent.GetZmin() + random.Rndm()*(extent.GetZmax()-extent.GetZmin());
+      G4double dx, dy, dz;
+      random.Sphere(dx, dy, dz, 1.);
+      points.push_back(G4ThreeVector(x, y, z));
+      directions.push_back(G4ThreeVector(dx, dy, dz));
+   }
+}
+
+//______________________________________________________________________________
+G4double Navigate(G4VPhysicalVolume* world, G4bool optimise,
+                  const std::vector<G4ThreeVector>& points,
+                  const std::vector<G4ThreeVector>& directions)
+{
+/// Close the geometry with the given optimisation option, locate all points
+/// and compute the steps, print the times and return the sum of the steps.
+
+   G4GeometryManager* geometryManager = G4GeometryManager::GetInstance();
+   TStopwatch timer;
+
+   timer.Start();
+   geometryManager->CloseGeometry(optimise, false, world);
+   timer.Stop();
+   G4double closeTime = timer.RealTime();
+
+   G4Navigator navigator;
+   navigator.SetWorldVolume(world);
+
+   G4double sumSteps = 0.;
+   timer.Start();
+   for (size_t i=0; i<points.size(); ++i) {
+      navigator.LocateGlobalPointAndSetup(points[i], &directions[i], false, false);
+      G4double safety = 0.;
+      G4double step
+         = navigator.ComputeStep(points[i], directions[i], kInfinity, safety);
+      if (step < kInfinity) sumSteps += step;
+   }
+   timer.Stop();
+
+   printf("   voxelization %-3s  close %10.6f s  navigation real %10.6f s  cpu %10.6f s\n",
+          optimise ? "on" : "off", closeTime, timer.RealTime(), timer.CpuTime());
+
+   geometryManager->OpenGeometry(world);
+   return sumSteps;
+}
+
+}
+
+//______________________________________________________________________________
+int main(int argc, char** argv)
+{
+   if (argc < 2 || argc > 3) {
+      G4cerr << " Usage: g4root_NavBench geometry.root [nofPoints]" << G4endl;
+      return 1;
+   }
+   G4int nofPoints = (argc > 2) ? atoi(argv[2]) : 1000000;
+
+   // Convert the Root geometry in Geant4
+   TGeoManager *geom = TGeoManager::Import(argv[1]);
+   if (!geom) {
+      G4cerr << " Cannot import geometry from " << argv[1] << G4endl;
+      return 1;
+   }
+   TG4RootNavMgr *mgr = TG4RootNavMgr::GetInstance(geom);
+   TStopwatch timer;
+   mgr->Initialize();
+   timer.Stop();
+   G4VPhysicalVolume *world = mgr->GetDetConstruction()->GetTopPV();
+   printf("   conversion  real %10.6f s  cpu %10.6f s\n",
+          timer.RealTime(), timer.CpuTime());
+
+   std::vector<G4ThreeVector> points;
+   std::vector<G4ThreeVector> directions;
+   GeneratePoints(world->GetLogicalVolume()->GetSolid()->GetExtent(),
+                  nofPoints, points, directions);
+
+   G4double sumStepsOn = Navigate(world, true, points, directions);
+   G4double sumStepsOff = Navigate(world, false, points, directions);
+   printf("   sum of steps  voxelization on %.6e mm  off %.6e mm\n",
+          sumStepsOn, sumStepsOff);
+
+   if (TMath::Abs(sumStepsOn - sumStepsOff) > 1e-6*TMath::Abs(sumStepsOn)) {
+      G4cerr << " The steps differ with and without voxelization." << G4endl;
+      return 1;
+   }
+   return 0;
+}
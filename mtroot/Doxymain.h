@@ -15,6 +15,17 @@ It provides:
   - TMCRootManager - the Root IO manager for VMC examples for sequential applications
   - TMCRootManagerMT - the Root IO manager for VMC examples for multi-threaded
   applications.
+  - TMCRootMerger - the merger of the output from all threads in a single file
+  during the run
+  - TMCRootFileMerger - the merger of the per-thread files after the run,
+  available also via the mtrootMerge executable
+  - TMCHitStreamWriter, TMCHitStreamReader - the writer and reader of simple
+  hits in flat binary memory-mapped files, an alternative to Root IO
+  - TMCTruthWriter, TMCTruthReader - the writer and reader of the MC truth
+  particles in the columnar layout (flat per-event arrays)
+  - TMCEventPipeline - the asynchronous end of event stage processing
+  the application finished event data in a consumer thread; its test with
+  several producer threads is available via the mtrootPipelineTest executable
 
 and also  
 
@@ -0,0 +1,150 @@
+#ifndef ROOT_TMCEventPipeline
+#define ROOT_TMCEventPipeline
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2013, 2014 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TMCEventPipeline.h
+/// \brief Definition of the TMCEventPipeline class
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include <Rtypes.h>
+
+#include <deque>
+#include <pthread.h>
+
+/// \brief The finished event data passed to TMCEventPipeline.
+///
+/// The application implements Process() with its end of event processing
+/// (digitization, output, ...). It is called in the pipeline consumer
+/// thread, so it must use only the data owned by the payload and it must
+/// not access the MC (gMC) or the application stack and hits, which are
+/// already used for the next event.
+
+class TMCVirtualEventPayload
+{
+  public:
+    TMCVirtualEventPayload() {}
+    virtual ~TMCVirtualEventPayload() {}
+
+    // methods
+    virtual void Process() = 0;
+};
+
+/// \brief The asynchronous end of event stage.
+///
+/// The application hands over its finished event data (payload) in its
+/// FinishEvent() and the transport continues immediately with the next
+/// event, while the payload is processed in the pipeline consumer thread.
+/// The payloads are processed in the order of their arrival.
+/// When the given number of events is in flight, Push() waits for
+/// the consumer; the number of such waits and the total waiting time
+/// are available via the get methods and they are reported when
+/// the pipeline is deleted in the debug mode
+/// (see TVirtualMCRootManager::SetDebug()).
+///
+/// The application creates one pipeline per thread (eg. in
+/// InitForWorker() in MT mode) and it has to call Drain() before
+/// writing its output at the end of run. The payload is deleted
+/// by the pipeline after it is processed. When the payload performs Root I/O,
+/// the Root thread safety has to be enabled (ROOT::EnableThreadSafety())
+/// and the Root manager must not be used in the transport thread
+/// before Drain() is called. Example of use:
+/// \code
+/// class MyEventPayload : public TMCVirtualEventPayload
+/// {
+///   public:
+///     MyEventPayload(const TClonesArray& hits, Int_t eventNumber,
+///                    TVirtualMCRootManager* manager)
+///       : fHits(new TClonesArray(hits)), fEventNumber(eventNumber),
+///         fManager(manager) {}
+///     virtual ~MyEventPayload() { delete fHits; }
+///     virtual void Process() {
+///       // digitize fHits, register them and fill the tree
+///       fManager->Register("hits", "TClonesArray", &fHits);
+///       fManager->Fill(fEventNumber);
+///     }
+///   private:
+///     TClonesArray* fHits;
+///     Int_t fEventNumber;
+///     TVirtualMCRootManager* fManager;
+/// };
+///
+/// void MyMCApplication::FinishEvent()
+/// {
+///   fPipeline->Push(
+///     new MyEventPayload(*fHits, gMC->CurrentEvent(), fRootManager));
+///   fHits->Clear();
+/// }
+///
+/// void MyMCApplication::FinishRun()
+/// {
+///   fPipeline->Drain();
+///   fRootManager->WriteAll();
+///   fRootManager->Close();
+/// }
+/// \endcode
+
+class TMCEventPipeline
+{
+  public:
+    TMCEventPipeline(Int_t maxEventsInFlight = 2);
+    virtual ~TMCEventPipeline();
+
+    // methods
+    void  Push(TMCVirtualEventPayload* payload);
+    void  Drain();
+
+    // get methods
+    Int_t     GetMaxEventsInFlight() const;
+    Long64_t  GetNofEvents() const;
+    Long64_t  GetNofWaits() const;
+    Double_t  GetWaitTime() const;
+
+  private:
+    // not implemented
+    TMCEventPipeline(const TMCEventPipeline& rhs);
+    TMCEventPipeline& operator=(const TMCEventPipeline& rhs);
+
+    // static methods
+    static void* RunConsumer(void* pipeline);
+
+    // data members
+    Int_t            fMaxEventsInFlight; // The maximum number of events in flight
+    std::deque<TMCVirtualEventPayload*>  fPayloads; // The waiting payloads
+    pthread_t        fConsumer;     // The consumer thread
+    pthread_mutex_t  fMutex;        // The queue mutex
+    pthread_cond_t   fCondition;    // The queue state changed condition
+    Bool_t           fIsBusy;       // Info whether the consumer is processing
+    Bool_t           fIsStopping;   // Info whether the consumer should stop
+    Long64_t         fNofEvents;    // The number of pushed events
+    Long64_t         fNofWaits;     // The number of pushes waiting for consumer
+    Double_t         fWaitTime;     // The total time waiting for consumer
+};
+
+// inline functions
+
+inline Int_t TMCEventPipeline::GetMaxEventsInFlight() const {
+  return fMaxEventsInFlight;
+}
+
+inline Long64_t TMCEventPipeline::GetNofEvents() const {
+  return fNofEvents;
+}
+
+inline Long64_t TMCEventPipeline::GetNofWaits() const {
+  return fNofWaits;
+}
+
+inline Double_t TMCEventPipeline::GetWaitTime() const {
+  return fWaitTime;
+}
+
+#endif //ROOT_TMCEventPipeline
@@ -0,0 +1,67 @@
+#ifndef ROOT_TMCHitStream
+#define ROOT_TMCHitStream
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2013, 2014 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TMCHitStream.h
+/// \brief Definition of the records of the flat binary hit stream files
+///
+/// The hit stream file, written with TMCHitStreamWriter and read with
+/// TMCHitStreamReader, has the following layout:
+/// - TMCHitStreamFileHeader
+/// - TMCHitStreamCollectionHeader for each registered hits collection
+/// - the event records, each of them consisting of
+///   - TMCHitStreamEventHeader
+///   - for each hits collection: the number of hits (Long64_t) followed
+///     by the hits data (nofHits*hitSize bytes, padded to 8 bytes)
+///
+/// All records are 8-byte aligned; the data are written in the native
+/// byte order.
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include <Rtypes.h>
+
+/// The hit stream file header
+struct TMCHitStreamFileHeader
+{
+  char      fMagic[8];         // The file identification ("MCHITS01")
+  Int_t     fVersion;          // The format version
+  Int_t     fNofCollections;   // The number of hits collections
+};
+
+/// The hits collection header
+struct TMCHitStreamCollectionHeader
+{
+  char      fName[64];         // The collection name
+  Int_t     fHitSize;          // The size of one hit (in bytes)
+  Int_t     fPadding;          // Padding to 8 bytes
+};
+
+/// The event record header
+struct TMCHitStreamEventHeader
+{
+  Int_t     fEventNumber;      // The event number
+  Int_t     fNofCollections;   // The number of hits collections
+  Long64_t  fRecordSize;       // The event record size including this header
+};
+
+/// The hit stream file magic word
+static const char kTMCHitStreamMagic[8] = { 'M','C','H','I','T','S','0','1' };
+
+/// The hit stream format version
+static const Int_t kTMCHitStreamVersion = 1;
+
+/// Return the size padded to 8 bytes
+inline Long64_t TMCHitStreamPadded(Long64_t size) {
+  return ( size + 7 ) & ~Long64_t(7);
+}
+
+#endif //ROOT_TMCHitStream
@@ -0,0 +1,90 @@
+#ifndef ROOT_TMCHitStreamReader
+#define ROOT_TMCHitStreamReader
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2013, 2014 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TMCHitStreamReader.h
+/// \brief Definition of the TMCHitStreamReader class
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include "TMCHitStream.h"
+
+#include <Rtypes.h>
+#include <TString.h>
+
+#include <vector>
+
+/// \brief The reader of hits from the flat binary files written with
+/// TMCHitStreamWriter.
+///
+/// The file is memory-mapped read-only and the hits are accessed
+/// in place, without copying (the returned hits pointers are valid
+/// until the reader is deleted).
+///
+/// The hits collection can be also converted in a Root tree with one
+/// entry per hit, described by the given leaf list
+/// (see TTree::Branch(const char*, void*, const char*));
+/// the leaf list has to match the hit structure layout.
+
+class TMCHitStreamReader
+{
+  public:
+    TMCHitStreamReader(const char* fileName);
+    virtual ~TMCHitStreamReader();
+
+    // methods
+    Int_t        GetCollectionId(const char* name) const;
+    const void*  GetHits(Int_t event, Int_t collectionId,
+                         Long64_t& nofHits) const;
+    Bool_t       ConvertToTree(const char* rootFileName,
+                               const char* collectionName,
+                               const char* leafList) const;
+
+    // get methods
+    Bool_t       IsValid() const;
+    Int_t        GetNofEvents() const;
+    Int_t        GetNofCollections() const;
+    Int_t        GetEventNumber(Int_t event) const;
+    const char*  GetCollectionName(Int_t collectionId) const;
+    Int_t        GetHitSize(Int_t collectionId) const;
+
+  private:
+    // not implemented
+    TMCHitStreamReader(const TMCHitStreamReader& rhs);
+    TMCHitStreamReader& operator=(const TMCHitStreamReader& rhs);
+
+    // methods
+    Bool_t  MapFile();
+
+    // data members
+    TString   fFileName;      // The file name
+    const char* fData;        // The mapped file data
+    Long64_t  fSize;          // The mapped file size
+    const TMCHitStreamCollectionHeader*  fCollections; // The collection headers
+    Int_t     fNofCollections; // The number of collections
+    std::vector<Long64_t>  fEventOffsets; // The event records offsets
+};
+
+// inline functions
+
+inline Bool_t TMCHitStreamReader::IsValid() const {
+  return fData != 0;
+}
+
+inline Int_t TMCHitStreamReader::GetNofEvents() const {
+  return fEventOffsets.size();
+}
+
+inline Int_t TMCHitStreamReader::GetNofCollections() const {
+  return fNofCollections;
+}
+
+#endif //ROOT_TMCHitStreamReader
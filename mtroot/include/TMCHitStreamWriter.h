@@ -0,0 +1,99 @@
+#ifndef ROOT_TMCHitStreamWriter
+#define ROOT_TMCHitStreamWriter
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2013, 2014 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TMCHitStreamWriter.h
+/// \brief Definition of the TMCHitStreamWriter class
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include "TMCHitStream.h"
+
+#include <Rtypes.h>
+#include <TString.h>
+
+#include <vector>
+
+/// \brief The writer of hits in a flat binary memory-mapped file.
+///
+/// It is an alternative to the Root IO managers for applications
+/// with simple hits (plain structures without pointers) which do not need
+/// Root object I/O. It follows the Root managers interface: the hits
+/// collections are registered with the address of the pointer to the hits
+/// array and of the number of hits, and they are then written with Fill()
+/// at the end of each event.
+///
+/// Each writer writes its own file (projectName.hits in sequential mode,
+/// projectName_threadRank.hits in MT mode), which is memory-mapped
+/// and appended without any locking. The file layout is described in
+/// TMCHitStream.h; the files can be read with TMCHitStreamReader.
+
+class TMCHitStreamWriter
+{
+  public:
+    TMCHitStreamWriter(const char* projectName, Int_t threadRank = -1);
+    virtual ~TMCHitStreamWriter();
+
+    // methods
+    Int_t  Register(const char* name, Int_t hitSize,
+                    const void* const* hitsAddress, const Int_t* nofHitsAddress);
+    void   Fill(Int_t eventNumber = -1);
+    void   WriteAll();
+    void   Close();
+
+    // get methods
+    const TString& GetFileName() const;
+    Long64_t       GetFileSize() const;
+    Int_t          GetNofEvents() const;
+
+  private:
+    /// The registered hits collection
+    struct Collection {
+      Int_t               fHitSize;     // The size of one hit
+      const void* const*  fHitsAddress; // The address of the hits array pointer
+      const Int_t*        fNofHitsAddress; // The address of the number of hits
+    };
+
+    // not implemented
+    TMCHitStreamWriter(const TMCHitStreamWriter& rhs);
+    TMCHitStreamWriter& operator=(const TMCHitStreamWriter& rhs);
+
+    // methods
+    char*  Reserve(Long64_t size);
+    void   WriteFileHeader();
+
+    // data members
+    TString   fFileName;      // The file name
+    Int_t     fFileDescriptor;// The file descriptor
+    char*     fData;          // The mapped file data
+    Long64_t  fCapacity;      // The mapped file size
+    Long64_t  fSize;          // The size of written data
+    Int_t     fNofEvents;     // The number of written events
+    Bool_t    fIsHeaderWritten; // Info whether the file header was written
+    std::vector<TString>     fNames;       // The collection names
+    std::vector<Collection>  fCollections; // The registered collections
+};
+
+// inline functions
+
+inline const TString& TMCHitStreamWriter::GetFileName() const {
+  return fFileName;
+}
+
+inline Long64_t TMCHitStreamWriter::GetFileSize() const {
+  return fSize;
+}
+
+inline Int_t TMCHitStreamWriter::GetNofEvents() const {
+  return fNofEvents;
+}
+
+#endif //ROOT_TMCHitStreamWriter
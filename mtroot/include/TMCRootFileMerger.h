@@ -0,0 +1,68 @@
+#ifndef ROOT_TMCRootFileMerger
+#define ROOT_TMCRootFileMerger
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2013, 2014 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TMCRootFileMerger.h
+/// \brief Definition of the TMCRootFileMerger class
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include <Rtypes.h>
+#include <TString.h>
+
+#include <vector>
+
+/// \brief The merger of the per-thread Root files produced with
+/// TMCRootManagerMT.
+///
+/// The files projectName_N.root are split in groups which are merged
+/// concurrently in temporary files, which are then merged in the output
+/// file. The trees are merged with the fast method (the baskets are
+/// copied without decompressing) when the files compression settings
+/// are the same.
+///
+/// Optionally an index is built on the merged tree from the given
+/// major (and minor) expression, eg. "eventNumber", the branch with
+/// the event number written by the Root managers, so that the events
+/// can be read in the generation order via the tree index
+/// (see TTree::BuildIndex, TTree::GetEntryWithIndex).
+///
+/// The merging is also available via the mtrootMerge executable.
+
+class TMCRootFileMerger
+{
+  public:
+    // static methods
+    static Bool_t  Merge(const char* projectName,
+                         const char* outputFileName = 0,
+                         Int_t nofJobs = 0,
+                         const char* indexMajor = 0,
+                         const char* indexMinor = "0");
+
+    static std::vector<TString>  GetThreadFileNames(const char* projectName);
+
+    static Bool_t  MergeFiles(const std::vector<TString>& inputFileNames,
+                              const TString& outputFileName);
+  private:
+    // not implemented
+    TMCRootFileMerger();
+    TMCRootFileMerger(const TMCRootFileMerger& rhs);
+    TMCRootFileMerger& operator=(const TMCRootFileMerger& rhs);
+
+    // static methods
+    static void*   MergeGroup(void* group);
+    static Bool_t  BuildIndex(const char* projectName,
+                              const TString& fileName,
+                              const char* indexMajor,
+                              const char* indexMinor);
+};
+
+#endif //ROOT_TMCRootFileMerger
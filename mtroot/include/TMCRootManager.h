@@ -33,11 +33,25 @@ class TMCRootManager : public TVirtualMCRootManager
     // methods
     virtual void  Register(const char* name, const char* className, void* objAddress);
     virtual void  Register(const char* name, const char* className, const void* objAddress);
-    virtual void  Fill();
+    virtual void  Fill(Int_t eventNumber = -1);
     virtual void  Close();
     virtual void  WriteAll();
     virtual void  WriteAndClose();
     virtual void  ReadEvent(Int_t i);
+
+    // output settings
+    virtual void  SetBranchOptions(const char* branchName, Int_t basketSize, 
+                                   Int_t splitLevel = 99, 
+                                   Int_t compression = -1);
+    virtual void  SetCompression(Int_t algorithm, Int_t level);
+    virtual void  SetAutoFlush(Long64_t autoFlush);
+    virtual void  SetAutoSave(Long64_t autoSave);
+    virtual void  SetAutoTuneBaskets(Int_t nofEvents, 
+                                     Long64_t maxMemory = 10000000);
+
+    // input settings
+    virtual void  SetReadCache(Long64_t cacheSize, Int_t nofLearnEntries = 10,
+                               Bool_t asyncPrefetching = false);
     
   private:
     // not implemented
@@ -16,16 +16,39 @@
 /// \author I. Hrivnacova; IPN Orsay
 
 #include "TVirtualMCRootManager.h"
+#include "TMCRootMerger.h"
+
+#include <deque>
+#include <map>
+#include <vector>
+#include <pthread.h>
 
 class TParticle;
 class TFile;
 class TTree;
+class TClass;
+class TBufferFile;
 
 /// \brief The common implementation of the TVirtualMCRootManager interface
 /// for the Root IO managers for VMC examples.
 ///
 /// It is used in TMCRootManager (for single-threaded applications)
-/// and TMCRootManagerMT (for multi-threaded applications)
+/// and TMCRootManagerMT (for multi-threaded applications).
+///
+/// When created with a merger, the tree is written in a memory file
+/// which is passed to the merger each time the given number of entries
+/// is filled and when the data are written.
+///
+/// With the asynchronous fill (see TVirtualMCRootManager::SetAsyncFill()),
+/// Fill() streams the registered objects in a staging buffer and queues it;
+/// the buffers are then read in the objects copies attached to the tree
+/// branches and filled in the tree in a dedicated I/O thread.
+/// The number of queued buffers is limited by the queue depth; the number
+/// of Fill() calls which had to wait for the I/O thread and the total
+/// waiting time are reported when the file is closed in the debug mode.
+/// The Root thread safety is enabled when the asynchronous fill is
+/// activated, and the file is made current only via TDirectory::TContext,
+/// so that gDirectory of the calling thread is not changed.
 
 class TMCRootManagerImpl
 {
@@ -34,26 +57,105 @@ class TMCRootManagerImpl
                        TVirtualMCRootManager::FileMode fileMode 
                          = TVirtualMCRootManager::kWrite, 
                        Int_t threadRank = -1);
+    TMCRootManagerImpl(const char* projectName,
+                       TMCRootMerger* merger, Int_t mergeAutoFlush);
     virtual ~TMCRootManagerImpl();     
   
     // methods
     void  Register(const char* name, const char* className, void* objAddress);
     void  Register(const char* name, const char* className, const void* objAddress);
-    void  Fill();
+    void  Fill(Int_t eventNumber);
     void  WriteAll();
     void  Close();
     void  WriteAndClose();
     void  ReadEvent(Int_t i);
+
+    // output settings
+    void  SetBranchOptions(const char* branchName, Int_t basketSize, 
+                           Int_t splitLevel, Int_t compression);
+    void  SetCompression(Int_t algorithm, Int_t level);
+    void  SetAutoFlush(Long64_t autoFlush);
+    void  SetAutoSave(Long64_t autoSave);
+    void  SetAutoTuneBaskets(Int_t nofEvents, Long64_t maxMemory);
+
+    // input settings
+    void  SetReadCache(Long64_t cacheSize, Int_t nofLearnEntries, 
+                       Bool_t asyncPrefetching);
     
   private:
+    /// The branch output options
+    struct BranchOptions {
+      BranchOptions(Int_t basketSize = 32000, Int_t splitLevel = 99,
+                    Int_t compression = -1) 
+        : fBasketSize(basketSize), fSplitLevel(splitLevel), 
+          fCompression(compression) {}
+      Int_t  fBasketSize;   // The basket size
+      Int_t  fSplitLevel;   // The split level
+      Int_t  fCompression;  // The compression settings (-1 = file settings)
+    };
+
+    /// The registered branch data for the asynchronous fill
+    struct AsyncBranch {
+      TString  fName;     // The branch name
+      TClass*  fClass;    // The object class
+      void**   fAddress;  // The address of the registered object pointer
+      void*    fObject;   // The object copy filled in the tree
+    };
+
     // not implemented
     TMCRootManagerImpl(const TMCRootManagerImpl& rhs);
     TMCRootManagerImpl& operator=(const TMCRootManagerImpl& rhs);
+
+    // static methods
+    static void* RunIO(void* manager);
+
+    // methods
+    const BranchOptions& GetBranchOptions(const char* branchName) const;
+    void  CreateBranch(const char* name, const char* className, void* objAddress);
+    void  CreateEventNumberBranch();
+    void  SendToMerger();
+    void  FillTree();
+    void  RegisterAsync(const char* name, const char* className, void* objAddress);
+    void  FillAsync(Int_t eventNumber);
+    void  WaitIO();
+    void  StopIO();
     
     // data members
     TFile*  fFile;       // Root output file
     TTree*  fTree;       // Root output tree 
     Bool_t  fIsClosed;   // Info whether its file was closed
+    TMCRootMerger*         fMerger;       // The output merger
+    TMCRootMerger::Queue*  fMergerQueue;  // The output merger queue
+    Int_t   fMergeAutoFlush; // The number of entries sent to merger at once
+    Int_t   fEventNumber;    // The event number filled in the tree
+
+    // data members for the output settings
+    std::map<TString, BranchOptions>  fBranchOptions; // The branch options
+    Int_t     fAutoTuneNofEvents;  // The number of events for auto-tuning
+    Long64_t  fAutoTuneMaxMemory;  // The maximum baskets memory for auto-tuning
+    Long64_t  fNofFilledEvents;    // The number of filled events
+
+    // data members for the input settings
+    Bool_t    fIsReadMode;         // Info whether the file is open for reading
+    Bool_t    fIsReadCache;        // Info whether the tree cache is used
+    std::vector<TString>  fReadBranchNames; // The branches registered for reading
+
+    // data members for the asynchronous fill
+    Bool_t  fIsAsyncFill;      // Option to fill the tree in the I/O thread
+    Int_t   fAsyncQueueDepth;  // The maximum number of queued buffers
+    std::vector<AsyncBranch*>  fAsyncBranches; // The registered branches
+    std::deque<TBufferFile*>   fAsyncQueue;    // The buffers waiting for fill
+    std::vector<TBufferFile*>  fAsyncFreeBuffers; // The buffers for reuse
+    pthread_t        fIOThread;         // The I/O thread
+    pthread_mutex_t  fAsyncMutex;       // The queue mutex
+    pthread_cond_t   fAsyncCondition;   // The queue state changed condition
+    Bool_t  fIsIOStarted;      // Info whether the I/O thread was started
+    Bool_t  fIsIOBusy;         // Info whether the I/O thread is filling
+    Bool_t  fIsIOStopping;     // Info whether the I/O thread should stop
+    Long64_t fNofAsyncFills;   // The number of asynchronous fills
+    Long64_t fNofAsyncWaits;   // The number of fills waiting for I/O thread
+    Double_t fAsyncWaitTime;   // The total time waiting for I/O thread
+    Int_t    fMaxAsyncQueueSize; // The maximum observed queue size
 };
 
 #endif //ROOT_TMCRootManagerImpl
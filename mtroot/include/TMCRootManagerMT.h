@@ -20,10 +20,23 @@
 #include <vector>
 
 class TMCRootManagerImpl;
+class TMCRootMerger;
 
 /// \brief The Root IO manager for VMC examples for multi-threaded applications.
 ///
 /// It implements the TVirtualMCRootManager interface.
+///
+/// By default, each thread writes its own file, projectName_threadRank.root.
+/// With the merge output option (see SetMergeOutput()), all threads write 
+/// into a single file, projectName.root: each thread fills its tree 
+/// in a memory file without any global lock and the memory file content
+/// is passed to a single writer which merges it in the output file 
+/// (see TMCRootMerger). The option has to be set before the managers
+/// are created, together with the number of the writing managers
+/// (usually the number of threads): the output file is finished when
+/// all of them are closed. If this number is not known, the output file
+/// has to be finished via FinishMerge() called on the master after
+/// the workers have closed their managers.
 
 class TMCRootManagerMT : public TVirtualMCRootManager
 {
@@ -31,14 +44,35 @@ class TMCRootManagerMT : public TVirtualMCRootManager
     TMCRootManagerMT(const char* projectName, FileMode fileMode = kWrite);
     virtual ~TMCRootManagerMT();     
   
+    // static methods
+    static void  SetMergeOutput(Bool_t mergeOutput, Int_t nofProducers = 0);
+    static void  FinishMerge();
+    static void  SetMergeAutoFlush(Int_t nofEntries);
+    static Bool_t GetMergeOutput();
+    static Int_t  GetMergeAutoFlush();
+
     // methods
     virtual void  Register(const char* name, const char* className, void* objAddress);
     virtual void  Register(const char* name, const char* className, const void* objAddress);
-    virtual void  Fill();
+    virtual void  Fill(Int_t eventNumber = -1);
     virtual void  WriteAll();
     virtual void  Close();
     virtual void  WriteAndClose();
     virtual void  ReadEvent(Int_t i);
+
+    // output settings
+    virtual void  SetBranchOptions(const char* branchName, Int_t basketSize, 
+                                   Int_t splitLevel = 99, 
+                                   Int_t compression = -1);
+    virtual void  SetCompression(Int_t algorithm, Int_t level);
+    virtual void  SetAutoFlush(Long64_t autoFlush);
+    virtual void  SetAutoSave(Long64_t autoSave);
+    virtual void  SetAutoTuneBaskets(Int_t nofEvents, 
+                                     Long64_t maxMemory = 10000000);
+
+    // input settings
+    virtual void  SetReadCache(Long64_t cacheSize, Int_t nofLearnEntries = 10,
+                               Bool_t asyncPrefetching = false);
     
   private:
     // not implemented
@@ -46,18 +80,45 @@ class TMCRootManagerMT : public TVirtualMCRootManager
     TMCRootManagerMT& operator=(const TMCRootManagerMT& rhs);
     
     // methods
-    void  FillWithLock();
-    void  FillWithTmpLock();
-    void  FillWithoutLock();
+    void  FillWithLock(Int_t eventNumber);
+    void  FillWithTmpLock(Int_t eventNumber);
+    void  FillWithoutLock(Int_t eventNumber);
+    void  CloseMerged(Bool_t write);
 
     // global static data members
     static  Int_t    fgCounter;         // The counter of instances
     static  Bool_t   fgIsFillLock;      // The if the Fill should be locked 
     static  std::vector<Bool_t>* fgIsFillLocks; // The info per thread if the Fill should be locked
+    static  Bool_t   fgMergeOutput;     // Option to merge the output in a single file
+    static  Int_t    fgMergeAutoFlush;  // The number of entries passed to merger at once
+    static  Int_t    fgNofProducers;    // The number of merged instances (0 if unknown)
+    static  Int_t    fgNofClosed;       // The number of closed instances
+    static  TMCRootMerger* fgMerger;    // The output merger
 
     // data members 
     Int_t                fId;           // This manager ID 
     TMCRootManagerImpl*  fRootManager;  // The Root manager
+    Bool_t               fIsMerged;     // Info whether the output is merged
 };
 
+// inline functions
+
+inline void TMCRootManagerMT::SetMergeOutput(Bool_t mergeOutput, 
+                                            Int_t nofProducers) {
+  fgMergeOutput = mergeOutput;
+  fgNofProducers = nofProducers;
+}  
+
+inline void TMCRootManagerMT::SetMergeAutoFlush(Int_t nofEntries) {
+  fgMergeAutoFlush = nofEntries;
+}  
+
+inline Bool_t TMCRootManagerMT::GetMergeOutput() {
+  return fgMergeOutput;
+}  
+
+inline Int_t TMCRootManagerMT::GetMergeAutoFlush() {
+  return fgMergeAutoFlush;
+}  
+
 #endif //ROOT_TMCRootManagerMT
@@ -0,0 +1,107 @@
+#ifndef ROOT_TMCRootMerger
+#define ROOT_TMCRootMerger
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2013, 2014 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TMCRootMerger.h
+/// \brief Definition of the TMCRootMerger class
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include "TMCAutoLock.h"
+
+#include <Rtypes.h>
+#include <TString.h>
+#include <TAtomicCount.h>
+
+#include <deque>
+#include <vector>
+
+class TFileMerger;
+
+/// \brief The merger of the Root output from several threads in
+/// a single output file.
+///
+/// Each thread (producer) writes its data in a memory file and passes
+/// the serialized memory file buffers to the merger via its own queue;
+/// the queues are scanned by a dedicated writer thread which merges
+/// the buffers in the output file as they arrive (in the same way as
+/// it is done in Root TBufferMerger).
+/// Producers never take a lock shared with other producers: the queue
+/// of each producer is only shared with the writer thread, which polls
+/// the per-queue atomic counters of pushed buffers.
+///
+/// The entries in the output tree are ordered by the buffers arrival,
+/// and so they are not ordered by events.
+
+class TMCRootMerger
+{
+  public:
+    /// The buffers queue of one producer
+    struct Queue {
+      Queue() : fMutex(), fBuffers(), fNofPushed(0), fNofTaken(0),
+                fIsClosed(false) {
+        pthread_mutex_init(&fMutex, 0); }
+      ~Queue() { pthread_mutex_destroy(&fMutex); }
+
+      TMCMutex  fMutex;  // The mutex shared only with the writer thread
+      std::deque< std::pair<char*, Long64_t> >  fBuffers; // The buffers
+      TAtomicCount fNofPushed; // The number of pushed buffers
+      Long_t    fNofTaken; // The number of buffers taken by the writer
+      Bool_t    fIsClosed; // Info whether the producer has finished
+    };
+
+  public:
+    TMCRootMerger(const char* fileName);
+    virtual ~TMCRootMerger();
+
+    // methods
+    Queue* AddProducer();
+    void   Push(Queue* queue, char* buffer, Long64_t size);
+    void   CloseProducer(Queue* queue);
+    void   Finish();
+
+    // get methods
+    Int_t  GetNofMergedBuffers() const;
+
+  private:
+    // not implemented
+    TMCRootMerger(const TMCRootMerger& rhs);
+    TMCRootMerger& operator=(const TMCRootMerger& rhs);
+
+    // static methods
+    static void* RunWriter(void* merger);
+
+    // methods
+    Bool_t  HasPushedBuffers();
+    Bool_t  MergeBuffers();
+
+    // data members
+    TString             fFileName;      // The output file name
+    TFileMerger*        fMerger;        // The file merger
+    std::vector<Queue*> fQueues;        // The producers queues
+    TMCMutex            fQueuesMutex;   // The mutex for adding producers
+    pthread_t           fWriter;        // The writer thread
+    pthread_mutex_t     fWakeMutex;     // The writer wake-up mutex
+    pthread_cond_t      fWakeCondition; // The writer wake-up condition
+    Bool_t              fIsFinishing;   // Info whether finish was requested
+    Bool_t              fIsFinished;    // Info whether the writer has finished
+    Int_t               fNofMergedBuffers; // The number of merged buffers
+
+    static const Long_t fgkPollPeriod; // The writer polling period (in us)
+};
+
+// inline functions
+
+inline Int_t TMCRootMerger::GetNofMergedBuffers() const {
+  return fNofMergedBuffers;
+}
+
+#endif //ROOT_TMCRootMerger
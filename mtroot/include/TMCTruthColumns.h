@@ -0,0 +1,84 @@
+#ifndef ROOT_TMCTruthColumns
+#define ROOT_TMCTruthColumns
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2013, 2014 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TMCTruthColumns.h
+/// \brief Definition of the TMCTruthColumns class
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include <Rtypes.h>
+
+#include <vector>
+
+class TParticle;
+class TTree;
+
+/// \brief The columnar (flat per-event arrays) representation of
+/// the MC truth particles.
+///
+/// Each TParticle data member is stored in its own array indexed by
+/// the particle index in the stack; the arrays are written in the tree
+/// as variable size leaf arrays with the common size branch "n",
+/// so no dictionary is needed.
+/// The process (TMCProcess) is taken from the particle unique Id,
+/// as it is set in the VMC examples stacks.
+///
+/// It is used in TMCTruthWriter and TMCTruthReader.
+
+class TMCTruthColumns
+{
+  public:
+    TMCTruthColumns();
+    virtual ~TMCTruthColumns();
+
+    // methods
+    void   Clear();
+    void   Add(const TParticle& particle);
+    void   GetParticle(Int_t index, TParticle& particle) const;
+    void   SetBranchAddresses(TTree* tree, Bool_t create = false);
+    void   Resize(Int_t nofParticles);
+
+    // get methods
+    Int_t  GetNofParticles() const;
+
+  private:
+    // not implemented
+    TMCTruthColumns(const TMCTruthColumns& rhs);
+    TMCTruthColumns& operator=(const TMCTruthColumns& rhs);
+
+    // data members
+    Int_t                  fN;           // The number of particles
+    std::vector<Int_t>     fPdg;         // The PDG codes
+    std::vector<Int_t>     fStatus;      // The status codes
+    std::vector<Int_t>     fProcess;     // The production process
+    std::vector<Int_t>     fMother;      // The first mothers
+    std::vector<Int_t>     fSecondMother;// The second mothers
+    std::vector<Int_t>     fFirstDaughter; // The first daughters
+    std::vector<Int_t>     fLastDaughter;  // The last daughters
+    std::vector<Double_t>  fPx;          // The momentum x components
+    std::vector<Double_t>  fPy;          // The momentum y components
+    std::vector<Double_t>  fPz;          // The momentum z components
+    std::vector<Double_t>  fE;           // The energies
+    std::vector<Double_t>  fVx;          // The production vertex x
+    std::vector<Double_t>  fVy;          // The production vertex y
+    std::vector<Double_t>  fVz;          // The production vertex z
+    std::vector<Double_t>  fT;           // The production time
+    std::vector<Double_t>  fWeight;      // The weights
+};
+
+// inline functions
+
+inline Int_t TMCTruthColumns::GetNofParticles() const {
+  return fN;
+}
+
+#endif //ROOT_TMCTruthColumns
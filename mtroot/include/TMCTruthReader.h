@@ -0,0 +1,63 @@
+#ifndef ROOT_TMCTruthReader
+#define ROOT_TMCTruthReader
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2013, 2014 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TMCTruthReader.h
+/// \brief Definition of the TMCTruthReader class
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include "TMCTruthColumns.h"
+
+class TFile;
+class TTree;
+class TClonesArray;
+class TParticle;
+
+/// \brief The reader of the MC truth written with TMCTruthWriter.
+///
+/// After reading an event, the particles can be rebuilt one by one
+/// or all at once in a TClonesArray of TParticle objects, as stored
+/// by the VMC examples stacks.
+
+class TMCTruthReader
+{
+  public:
+    TMCTruthReader(const char* fileName);
+    virtual ~TMCTruthReader();
+
+    // methods
+    Bool_t  ReadEvent(Int_t i);
+    void    GetParticle(Int_t index, TParticle& particle) const;
+    void    GetParticles(TClonesArray& particles) const;
+
+    // get methods
+    Int_t   GetNofEvents() const;
+    Int_t   GetNofParticles() const;
+
+  private:
+    // not implemented
+    TMCTruthReader(const TMCTruthReader& rhs);
+    TMCTruthReader& operator=(const TMCTruthReader& rhs);
+
+    // data members
+    TFile*           fFile;     // Root input file
+    TTree*           fTree;     // Root input tree
+    TMCTruthColumns  fColumns;  // The particles columns
+};
+
+// inline functions
+
+inline Int_t TMCTruthReader::GetNofParticles() const {
+  return fColumns.GetNofParticles();
+}
+
+#endif //ROOT_TMCTruthReader
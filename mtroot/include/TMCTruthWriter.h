@@ -0,0 +1,59 @@
+#ifndef ROOT_TMCTruthWriter
+#define ROOT_TMCTruthWriter
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2013, 2014 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TMCTruthWriter.h
+/// \brief Definition of the TMCTruthWriter class
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include "TMCTruthColumns.h"
+
+class TFile;
+class TTree;
+class TObjArray;
+class TParticle;
+
+/// \brief The writer of the MC truth (stack particles) in the columnar
+/// layout.
+///
+/// The particles are stored as flat per-event arrays (see TMCTruthColumns)
+/// in the tree "truth" in the file projectName_truth.root
+/// (projectName_truth_threadRank.root in MT mode), instead of
+/// a TClonesArray of TParticle objects.
+/// The particles can be passed in an array (eg. the stack TClonesArray)
+/// or added one by one before calling Fill().
+/// The particles can be read back with TMCTruthReader.
+
+class TMCTruthWriter
+{
+  public:
+    TMCTruthWriter(const char* projectName, Int_t threadRank = -1);
+    virtual ~TMCTruthWriter();
+
+    // methods
+    void  AddParticle(const TParticle& particle);
+    void  Fill();
+    void  Fill(const TObjArray& particles);
+    void  WriteAndClose();
+
+  private:
+    // not implemented
+    TMCTruthWriter(const TMCTruthWriter& rhs);
+    TMCTruthWriter& operator=(const TMCTruthWriter& rhs);
+
+    // data members
+    TFile*           fFile;     // Root output file
+    TTree*           fTree;     // Root output tree
+    TMCTruthColumns  fColumns;  // The particles columns
+};
+
+#endif //ROOT_TMCTruthWriter
@@ -24,6 +24,31 @@ class TVirtualMCRootManager;
 
 /// \brief The abstract base class for Root IO manager for VMC examples 
 /// for both sequential and  multi-threaded applications.
+///
+/// With the asynchronous fill option, Fill() only takes a snapshot of
+/// the registered objects and the tree filling, compression and writing
+/// are performed in a dedicated I/O thread; when the given number of 
+/// snapshots is waiting for fill, Fill() waits for the I/O thread.
+/// The option has to be set on the master before the managers are created;
+/// the Root thread safety is then enabled once, before the workers start.
+///
+/// The output settings can be set per branch (basket size, split level
+/// and compression; branch name "*" for all branches without their own
+/// settings) before the branches are registered, and per file 
+/// (compression algorithm and level, auto flush and auto save).
+/// The file compression is applied also to the branches already registered
+/// without their own compression; the baskets which were already written
+/// keep their compression.
+/// With the auto-tuning option, the baskets sizes are optimized according 
+/// to the branches sizes after the given number of filled events.
+///
+/// Each entry stores the event number (passed to Fill(), the number
+/// of the entries filled by the manager if not set) in the "eventNumber"
+/// branch, so that the files merged from several threads can be indexed
+/// and read in the generation order (see TMCRootFileMerger).
+///
+/// In the read mode, only the registered branches are read; the reading
+/// can be optimized with the tree cache (see SetReadCache()).
 
 class TVirtualMCRootManager
 {
@@ -45,18 +70,39 @@ class TVirtualMCRootManager
     static void SetDebug(Bool_t debug); 
     static Bool_t GetDebug();
 
+    // static methods for activating asynchronous fill
+    static void  SetAsyncFill(Bool_t asyncFill, Int_t queueDepth = 2); 
+    static Bool_t GetAsyncFill();
+    static Int_t  GetAsyncFillQueueDepth();
+
     // methods
     virtual void  Register(const char* name, const char* className, void* objAddress) = 0;
     virtual void  Register(const char* name, const char* className, const void* objAddress) = 0;
-    virtual void  Fill() = 0;
+    virtual void  Fill(Int_t eventNumber = -1) = 0;
     virtual void  WriteAll() = 0;
     virtual void  Close() = 0;
     virtual void  WriteAndClose() = 0;
     virtual void  ReadEvent(Int_t i) = 0;
+
+    // output settings
+    virtual void  SetBranchOptions(const char* branchName, Int_t basketSize, 
+                                   Int_t splitLevel = 99, 
+                                   Int_t compression = -1);
+    virtual void  SetCompression(Int_t algorithm, Int_t level);
+    virtual void  SetAutoFlush(Long64_t autoFlush);
+    virtual void  SetAutoSave(Long64_t autoSave);
+    virtual void  SetAutoTuneBaskets(Int_t nofEvents, 
+                                     Long64_t maxMemory = 10000000);
+
+    // input settings
+    virtual void  SetReadCache(Long64_t cacheSize, Int_t nofLearnEntries = 10,
+                               Bool_t asyncPrefetching = false);
     
   protected:
     // static data members
     static  Bool_t  fgDebug; // Option to activate debug printings
+    static  Bool_t  fgAsyncFill; // Option to fill the tree in an I/O thread
+    static  Int_t   fgAsyncFillQueueDepth; // The max number of events waiting for fill
 
   private:
     // not implemented
@@ -79,6 +125,14 @@ inline Bool_t TVirtualMCRootManager::GetDebug() {
   return fgDebug;
 }  
 
+inline Bool_t TVirtualMCRootManager::GetAsyncFill() {
+  return fgAsyncFill;
+}  
+
+inline Int_t TVirtualMCRootManager::GetAsyncFillQueueDepth() {
+  return fgAsyncFillQueueDepth;
+}  
+
 #endif //ROOT_TVirtualMCRootManager   
    
 
@@ -0,0 +1,44 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2013, 2014 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file mtrootMerge.cxx
+/// \brief The executable for merging the per-thread Root files
+/// produced with TMCRootManagerMT
+///
+/// Usage:
+/// mtrootMerge projectName [outputFile] [nofJobs] [indexMajor] [indexMinor]
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include "TMCRootFileMerger.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+/// Application main program
+int main(int argc, char** argv)
+{
+  if ( argc < 2 ) {
+    printf("Usage: %s projectName [outputFile] [nofJobs] "
+           "[indexMajor] [indexMinor]\n", argv[0]);
+    return 1;
+  }
+
+  const char* projectName = argv[1];
+  const char* outputFile = ( argc > 2 ) ? argv[2] : 0;
+  int nofJobs = ( argc > 3 ) ? atoi(argv[3]) : 0;
+  const char* indexMajor = ( argc > 4 ) ? argv[4] : 0;
+  const char* indexMinor = ( argc > 5 ) ? argv[5] : "0";
+
+  Bool_t isMerged
+    = TMCRootFileMerger::Merge(projectName, outputFile, nofJobs,
+                               indexMajor, indexMinor);
+
+  return isMerged ? 0 : 1;
+}
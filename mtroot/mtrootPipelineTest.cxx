@@ -0,0 +1,182 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2013, 2014 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file mtrootPipelineTest.cxx
+/// \brief The test of TMCEventPipeline with several producer threads
+///
+/// Each producer thread pushes its events, numbered in order, in one
+/// pipeline. The test checks that all events are processed and deleted
+/// after Drain() and when the pipeline is deleted, and that the events
+/// of each producer are processed in the order they were pushed.
+/// The process returns 1 if any check fails.
+///
+/// Usage:
+/// mtrootPipelineTest [nofProducers] [nofEvents] [maxEventsInFlight]
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include "TMCEventPipeline.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <pthread.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+/// The events processed per producer (accessed only by the consumer
+/// thread and by the main thread after Drain())
+std::vector<std::vector<Int_t> > gProcessed;
+
+/// The number of deleted payloads
+Long64_t gNofDeleted = 0;
+pthread_mutex_t gDeletedMutex = PTHREAD_MUTEX_INITIALIZER;
+
+/// The test payload: the producer number and the event number
+class TestPayload : public TMCVirtualEventPayload
+{
+  public:
+    TestPayload(Int_t producer, Int_t eventNumber)
+      : fProducer(producer), fEventNumber(eventNumber) {}
+    virtual ~TestPayload() {
+      pthread_mutex_lock(&gDeletedMutex);
+      ++gNofDeleted;
+      pthread_mutex_unlock(&gDeletedMutex);
+    }
+    virtual void Process() {
+      // make the consumer slower than the producers
+      if ( fEventNumber % 10 == 0 ) usleep(100);
+      gProcessed[fProducer].push_back(fEventNumber);
+    }
+
+  private:
+    Int_t fProducer;
+    Int_t fEventNumber;
+};
+
+/// The producer thread data
+struct Producer
+{
+  TMCEventPipeline* fPipeline;
+  Int_t             fId;
+  Int_t             fFirstEvent;
+  Int_t             fLastEvent;
+};
+
+//_____________________________________________________________________________
+void* RunProducer(void* object)
+{
+/// Push the events [fFirstEvent, fLastEvent) in the pipeline.
+
+  Producer* producer = static_cast<Producer*>(object);
+  for (Int_t i=producer->fFirstEvent; i<producer->fLastEvent; ++i) {
+    producer->fPipeline->Push(new TestPayload(producer->fId, i));
+  }
+  return 0;
+}
+
+//_____________________________________________________________________________
+void RunProducers(TMCEventPipeline* pipeline, Int_t nofProducers,
+                  Int_t firstEvent, Int_t lastEvent)
+{
+/// Run the producer threads and wait until they finish pushing.
+
+  std::vector<pthread_t> threads(nofProducers);
+  std::vector<Producer> producers(nofProducers);
+  for (Int_t i=0; i<nofProducers; ++i) {
+    Producer producer = { pipeline, i, firstEvent, lastEvent };
+    producers[i] = producer;
+    pthread_create(&threads[i], 0, &RunProducer, &producers[i]);
+  }
+  for (Int_t i=0; i<nofProducers; ++i) {
+    pthread_join(threads[i], 0);
+  }
+}
+
+//_____________________________________________________________________________
+Bool_t CheckProcessed(Int_t nofProducers, Int_t nofEvents, const char* step)
+{
+/// Check that all events of each producer were processed in order.
+
+  Bool_t isOK = true;
+  for (Int_t i=0; i<nofProducers; ++i) {
+    if ( Int_t(gProcessed[i].size()) != nofEvents ) {
+      printf("... %s: producer %d: %d events processed, expected %d\n",
+             step, i, Int_t(gProcessed[i].size()), nofEvents);
+      isOK = false;
+      continue;
+    }
+    for (Int_t j=0; j<nofEvents; ++j) {
+      if ( gProcessed[i][j] != j ) {
+        printf("... %s: producer %d: event %d processed at position %d\n",
+               step, i, gProcessed[i][j], j);
+        isOK = false;
+        break;
+      }
+    }
+  }
+  return isOK;
+}
+
+}
+
+/// Application main program
+int main(int argc, char** argv)
+{
+  Int_t nofProducers = ( argc > 1 ) ? atoi(argv[1]) : 4;
+  Int_t nofEvents = ( argc > 2 ) ? atoi(argv[2]) : 1000;
+  Int_t maxEventsInFlight = ( argc > 3 ) ? atoi(argv[3]) : 2;
+  if ( nofProducers < 1 || nofEvents < 2 ) {
+    printf("Usage: %s [nofProducers] [nofEvents] [maxEventsInFlight]\n",
+           argv[0]);
+    return 1;
+  }
+
+  gProcessed.resize(nofProducers);
+  Int_t nofHalfEvents = nofEvents/2;
+  Long64_t nofDrainedEvents = Long64_t(nofProducers)*nofHalfEvents;
+  Long64_t nofAllEvents = Long64_t(nofProducers)*nofEvents;
+  Bool_t isOK = true;
+
+  TMCEventPipeline* pipeline = new TMCEventPipeline(maxEventsInFlight);
+
+  // The first half of events: all processed after Drain()
+  RunProducers(pipeline, nofProducers, 0, nofHalfEvents);
+  pipeline->Drain();
+  isOK = CheckProcessed(nofProducers, nofHalfEvents, "Drain") && isOK;
+  if ( pipeline->GetNofEvents() != nofDrainedEvents ||
+       gNofDeleted != nofDrainedEvents ) {
+    printf("... Drain: %lld events pushed, %lld deleted, expected %lld\n",
+           pipeline->GetNofEvents(), gNofDeleted, nofDrainedEvents);
+    isOK = false;
+  }
+
+  // The second half of events: all processed when the pipeline is deleted
+  RunProducers(pipeline, nofProducers, nofHalfEvents, nofEvents);
+  Long64_t nofPushed = pipeline->GetNofEvents();
+  printf("   %lld events from %d producers, "
+         "%lld waited for consumer (%g s)\n",
+         nofPushed, nofProducers, pipeline->GetNofWaits(),
+         pipeline->GetWaitTime());
+  delete pipeline;
+  isOK = CheckProcessed(nofProducers, nofEvents, "Delete") && isOK;
+  if ( nofPushed != nofAllEvents || gNofDeleted != nofAllEvents ) {
+    printf("... Delete: %lld events pushed, %lld deleted, expected %lld\n",
+           nofPushed, gNofDeleted, nofAllEvents);
+    isOK = false;
+  }
+
+  if ( ! isOK ) {
+    printf("... The event pipeline test failed.\n");
+    return 1;
+  }
+  printf("... The event pipeline test passed.\n");
+  return 0;
+}
@@ -0,0 +1,148 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2013, 2014 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TMCEventPipeline.cxx
+/// \brief Implementation of the TMCEventPipeline class
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include "TMCEventPipeline.h"
+#include "TVirtualMCRootManager.h"
+#include "TStopwatch.h"
+
+#include <cstdio>
+
+//
+// ctors, dtor
+//
+
+//_____________________________________________________________________________
+TMCEventPipeline::TMCEventPipeline(Int_t maxEventsInFlight)
+  : fMaxEventsInFlight(maxEventsInFlight > 0 ? maxEventsInFlight : 1),
+    fPayloads(),
+    fConsumer(),
+    fMutex(),
+    fCondition(),
+    fIsBusy(false),
+    fIsStopping(false),
+    fNofEvents(0),
+    fNofWaits(0),
+    fWaitTime(0.)
+{
+/// Standard constructor
+/// \param maxEventsInFlight  The maximum number of events waiting
+///                           for or being processed by the consumer
+
+  if ( TVirtualMCRootManager::GetDebug() )
+    printf("TMCEventPipeline::TMCEventPipeline %p \n", this);
+
+  pthread_mutex_init(&fMutex, 0);
+  pthread_cond_init(&fCondition, 0);
+  pthread_create(&fConsumer, 0, &TMCEventPipeline::RunConsumer, this);
+}
+
+//_____________________________________________________________________________
+TMCEventPipeline::~TMCEventPipeline()
+{
+/// Destructor: process the remaining events and stop the consumer.
+
+  if ( TVirtualMCRootManager::GetDebug() )
+    printf("TMCEventPipeline::~TMCEventPipeline %p \n", this);
+
+  pthread_mutex_lock(&fMutex);
+  fIsStopping = true;
+  pthread_cond_broadcast(&fCondition);
+  pthread_mutex_unlock(&fMutex);
+
+  pthread_join(fConsumer, 0);
+
+  pthread_cond_destroy(&fCondition);
+  pthread_mutex_destroy(&fMutex);
+
+  if ( TVirtualMCRootManager::GetDebug() )
+    printf("TMCEventPipeline: %lld events, "
+           "%lld waited for consumer (%g s) \n",
+           fNofEvents, fNofWaits, fWaitTime);
+}
+
+//
+// static private methods
+//
+
+//_____________________________________________________________________________
+void* TMCEventPipeline::RunConsumer(void* object)
+{
+/// The consumer thread function: process and delete the payloads
+/// until the stop is requested and there is no more payload.
+
+  TMCEventPipeline* pipeline = static_cast<TMCEventPipeline*>(object);
+
+  pthread_mutex_lock(&pipeline->fMutex);
+  while ( true ) {
+    while ( pipeline->fPayloads.empty() && ! pipeline->fIsStopping ) {
+      pthread_cond_wait(&pipeline->fCondition, &pipeline->fMutex);
+    }
+    if ( pipeline->fPayloads.empty() ) break;
+
+    TMCVirtualEventPayload* payload = pipeline->fPayloads.front();
+    pipeline->fPayloads.pop_front();
+    pipeline->fIsBusy = true;
+    pthread_mutex_unlock(&pipeline->fMutex);
+
+    payload->Process();
+    delete payload;
+
+    pthread_mutex_lock(&pipeline->fMutex);
+    pipeline->fIsBusy = false;
+    pthread_cond_broadcast(&pipeline->fCondition);
+  }
+  pthread_mutex_unlock(&pipeline->fMutex);
+
+  return 0;
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+void TMCEventPipeline::Push(TMCVirtualEventPayload* payload)
+{
+/// Pass the finished event payload to the consumer; the pipeline takes
+/// the ownership of the payload. Wait if the maximum number of events
+/// is in flight.
+/// \param payload  The finished event payload
+
+  pthread_mutex_lock(&fMutex);
+  if ( Int_t(fPayloads.size()) + fIsBusy >= fMaxEventsInFlight ) {
+    ++fNofWaits;
+    TStopwatch timer;
+    while ( Int_t(fPayloads.size()) + fIsBusy >= fMaxEventsInFlight ) {
+      pthread_cond_wait(&fCondition, &fMutex);
+    }
+    fWaitTime += timer.RealTime();
+  }
+
+  fPayloads.push_back(payload);
+  ++fNofEvents;
+  pthread_cond_broadcast(&fCondition);
+  pthread_mutex_unlock(&fMutex);
+}
+
+//_____________________________________________________________________________
+void TMCEventPipeline::Drain()
+{
+/// Wait until all pushed events are processed.
+
+  pthread_mutex_lock(&fMutex);
+  while ( fPayloads.size() || fIsBusy ) {
+    pthread_cond_wait(&fCondition, &fMutex);
+  }
+  pthread_mutex_unlock(&fMutex);
+}
@@ -0,0 +1,284 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2013, 2014 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TMCHitStreamReader.cxx
+/// \brief Implementation of the TMCHitStreamReader class
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include "TMCHitStreamReader.h"
+#include "TVirtualMCRootManager.h"
+#include "TFile.h"
+#include "TTree.h"
+#include "TError.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//
+// ctors, dtor
+//
+
+//_____________________________________________________________________________
+TMCHitStreamReader::TMCHitStreamReader(const char* fileName)
+  : fFileName(fileName),
+    fData(0),
+    fSize(0),
+    fCollections(0),
+    fNofCollections(0),
+    fEventOffsets()
+{
+/// Standard constructor
+/// \param fileName  The hit stream file name
+
+  if ( ! MapFile() ) {
+    Error("TMCHitStreamReader", "Cannot read file %s.", fileName);
+  }
+}
+
+//_____________________________________________________________________________
+TMCHitStreamReader::~TMCHitStreamReader()
+{
+/// Destructor
+
+  if ( fData ) munmap(const_cast<char*>(fData), fSize);
+}
+
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+Bool_t TMCHitStreamReader::MapFile()
+{
+/// Map the file, check its header and index the event records.
+
+  int fd = open(fFileName.Data(), O_RDONLY);
+  if ( fd < 0 ) return false;
+
+  struct stat fileStat;
+  if ( fstat(fd, &fileStat) != 0 ||
+       fileStat.st_size < Long64_t(sizeof(TMCHitStreamFileHeader)) ) {
+    close(fd);
+    return false;
+  }
+
+  void* data = mmap(0, fileStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if ( data == MAP_FAILED ) return false;
+
+  fData = static_cast<const char*>(data);
+  fSize = fileStat.st_size;
+
+  const TMCHitStreamFileHeader* fileHeader
+    = reinterpret_cast<const TMCHitStreamFileHeader*>(fData);
+  if ( memcmp(fileHeader->fMagic, kTMCHitStreamMagic,
+              sizeof(kTMCHitStreamMagic)) != 0 ||
+       fileHeader->fVersion != kTMCHitStreamVersion ) {
+    Error("MapFile", "File %s is not a hit stream file.", fFileName.Data());
+    munmap(data, fSize);
+    fData = 0;
+    return false;
+  }
+
+  // Check that the collection headers are inside the file
+  Long64_t offset
+    = sizeof(TMCHitStreamFileHeader)
+      + Long64_t(fileHeader->fNofCollections)
+        *Long64_t(sizeof(TMCHitStreamCollectionHeader));
+  if ( fileHeader->fNofCollections < 0 || offset > fSize ) {
+    Error("MapFile", "Wrong number of collections %d in file %s.",
+          fileHeader->fNofCollections, fFileName.Data());
+    munmap(data, fSize);
+    fData = 0;
+    return false;
+  }
+
+  fNofCollections = fileHeader->fNofCollections;
+  fCollections
+    = reinterpret_cast<const TMCHitStreamCollectionHeader*>(
+        fData + sizeof(TMCHitStreamFileHeader));
+
+  for ( Int_t i=0; i<fNofCollections; ++i ) {
+    if ( fCollections[i].fHitSize <= 0 ) {
+      Error("MapFile", "Wrong hit size %d of collection %d in file %s.",
+            fCollections[i].fHitSize, i, fFileName.Data());
+      munmap(data, fSize);
+      fData = 0;
+      fCollections = 0;
+      fNofCollections = 0;
+      return false;
+    }
+  }
+
+  while ( offset + Long64_t(sizeof(TMCHitStreamEventHeader)) <= fSize ) {
+    const TMCHitStreamEventHeader* eventHeader
+      = reinterpret_cast<const TMCHitStreamEventHeader*>(fData + offset);
+    if ( eventHeader->fRecordSize <= 0 ||
+         offset + eventHeader->fRecordSize > fSize ) {
+      Warning("MapFile", "Truncated event record in file %s.",
+              fFileName.Data());
+      break;
+    }
+    fEventOffsets.push_back(offset);
+    offset += eventHeader->fRecordSize;
+  }
+
+  if ( TVirtualMCRootManager::GetDebug() )
+    printf("TMCHitStreamReader: %d events in %s \n",
+           Int_t(fEventOffsets.size()), fFileName.Data());
+
+  return true;
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+Int_t TMCHitStreamReader::GetCollectionId(const char* name) const
+{
+/// Return the Id of the collection with the given name (-1 if not found)
+
+  for ( Int_t i=0; i<fNofCollections; ++i ) {
+    if ( strcmp(fCollections[i].fName, name) == 0 ) return i;
+  }
+  return -1;
+}
+
+//_____________________________________________________________________________
+const void* TMCHitStreamReader::GetHits(Int_t event, Int_t collectionId,
+                                        Long64_t& nofHits) const
+{
+/// Return the pointer to the hits of the given collection in the given
+/// event directly in the mapped file.
+/// \param event         The event index in the file
+/// \param collectionId  The collection Id
+/// \param nofHits       The number of hits (output)
+/// \return              The hits pointer, or 0 if the event record is
+///                      corrupted (the hits exceed the record size)
+
+  nofHits = 0;
+  if ( event < 0 || event >= Int_t(fEventOffsets.size()) ||
+       collectionId < 0 || collectionId >= fNofCollections ) {
+    Error("GetHits", "Wrong event %d or collection %d.", event, collectionId);
+    return 0;
+  }
+
+  // The hits data are checked against the event record end
+  const char* data
+    = fData + fEventOffsets[event] + sizeof(TMCHitStreamEventHeader);
+  const char* recordEnd
+    = fData + fEventOffsets[event]
+      + reinterpret_cast<const TMCHitStreamEventHeader*>(
+          fData + fEventOffsets[event])->fRecordSize;
+  for ( Int_t i=0; i<=collectionId; ++i ) {
+    if ( recordEnd - data < Long64_t(sizeof(Long64_t)) ) {
+      Error("GetHits", "Truncated collection %d in event %d.", i, event);
+      nofHits = 0;
+      return 0;
+    }
+    memcpy(&nofHits, data, sizeof(Long64_t));
+    data += sizeof(Long64_t);
+    if ( nofHits < 0 ||
+         nofHits > ( recordEnd - data )/fCollections[i].fHitSize ) {
+      Error("GetHits", "Wrong number of hits %lld in collection %d, event %d.",
+            nofHits, i, event);
+      nofHits = 0;
+      return 0;
+    }
+    if ( i == collectionId ) break;
+    data += TMCHitStreamPadded(nofHits*fCollections[i].fHitSize);
+  }
+
+  return data;
+}
+
+//_____________________________________________________________________________
+Bool_t TMCHitStreamReader::ConvertToTree(const char* rootFileName,
+                                         const char* collectionName,
+                                         const char* leafList) const
+{
+/// Convert the given hits collection in a Root tree named after
+/// the collection, with one entry per hit. The tree has two branches:
+/// "event" with the event number and "hit" described by the leaf list.
+/// \param rootFileName    The output Root file name
+/// \param collectionName  The collection name
+/// \param leafList        The leaf list describing the hit structure
+/// \return                true if the conversion was successful
+
+  Int_t collectionId = GetCollectionId(collectionName);
+  if ( collectionId < 0 ) {
+    Error("ConvertToTree", "Collection %s not found.", collectionName);
+    return false;
+  }
+
+  TFile file(rootFileName, "RECREATE");
+  if ( file.IsZombie() ) return false;
+
+  TTree* tree = new TTree(collectionName, collectionName);
+  Int_t eventNumber = 0;
+  std::vector<char> hit(fCollections[collectionId].fHitSize);
+  tree->Branch("event", &eventNumber, "event/I");
+  tree->Branch("hit", &hit[0], leafList);
+
+  for ( Int_t i=0; i<GetNofEvents(); ++i ) {
+    eventNumber = GetEventNumber(i);
+    Long64_t nofHits = 0;
+    const char* hits
+      = static_cast<const char*>(GetHits(i, collectionId, nofHits));
+    if ( ! hits ) {
+      file.Close();
+      return false;
+    }
+    for ( Long64_t j=0; j<nofHits; ++j ) {
+      memcpy(&hit[0], hits + j*hit.size(), hit.size());
+      tree->Fill();
+    }
+  }
+
+  file.Write();
+  file.Close();
+  return true;
+}
+
+//_____________________________________________________________________________
+Int_t TMCHitStreamReader::GetEventNumber(Int_t event) const
+{
+/// Return the event number of the given event record
+
+  if ( event < 0 || event >= Int_t(fEventOffsets.size()) ) return -1;
+
+  return reinterpret_cast<const TMCHitStreamEventHeader*>(
+           fData + fEventOffsets[event])->fEventNumber;
+}
+
+//_____________________________________________________________________________
+const char* TMCHitStreamReader::GetCollectionName(Int_t collectionId) const
+{
+/// Return the name of the collection with the given Id
+
+  if ( collectionId < 0 || collectionId >= fNofCollections ) return 0;
+
+  return fCollections[collectionId].fName;
+}
+
+//_____________________________________________________________________________
+Int_t TMCHitStreamReader::GetHitSize(Int_t collectionId) const
+{
+/// Return the hit size of the collection with the given Id
+
+  if ( collectionId < 0 || collectionId >= fNofCollections ) return 0;
+
+  return fCollections[collectionId].fHitSize;
+}
@@ -0,0 +1,248 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2013, 2014 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TMCHitStreamWriter.cxx
+/// \brief Implementation of the TMCHitStreamWriter class
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include "TMCHitStreamWriter.h"
+#include "TVirtualMCRootManager.h"
+#include "TError.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+  // The minimum size by which the mapped file is extended (64 MB)
+  const Long64_t kMinExtension = 64*1024*1024;
+}
+
+//
+// ctors, dtor
+//
+
+//_____________________________________________________________________________
+TMCHitStreamWriter::TMCHitStreamWriter(const char* projectName,
+                                       Int_t threadRank)
+  : fFileName(projectName),
+    fFileDescriptor(-1),
+    fData(0),
+    fCapacity(0),
+    fSize(0),
+    fNofEvents(0),
+    fIsHeaderWritten(false),
+    fNames(),
+    fCollections()
+{
+/// Standard constructor
+/// \param projectName  The project name (used in the file name)
+/// \param threadRank   The thread Id (-1 when sequential mode)
+
+  if ( TVirtualMCRootManager::GetDebug() )
+    printf("TMCHitStreamWriter::TMCHitStreamWriter %p \n", this);
+
+  if ( threadRank >= 0 ) {
+    fFileName += "_";
+    fFileName += threadRank;
+  }
+  fFileName += ".hits";
+
+  fFileDescriptor = open(fFileName.Data(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if ( fFileDescriptor < 0 ) {
+    Fatal("TMCHitStreamWriter", "Cannot open file %s.", fFileName.Data());
+  }
+}
+
+//_____________________________________________________________________________
+TMCHitStreamWriter::~TMCHitStreamWriter()
+{
+/// Destructor
+
+  if ( TVirtualMCRootManager::GetDebug() )
+    printf("TMCHitStreamWriter::~TMCHitStreamWriter %p \n", this);
+
+  if ( fFileDescriptor >= 0 ) Close();
+}
+
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+char* TMCHitStreamWriter::Reserve(Long64_t size)
+{
+/// Extend the mapped file if needed to append the data of the given size
+/// and return the address where the data can be written.
+
+  if ( fSize + size > fCapacity ) {
+    Long64_t capacity = 2*fCapacity;
+    if ( capacity < fSize + size ) capacity = fSize + size;
+    if ( capacity < fCapacity + kMinExtension )
+      capacity = fCapacity + kMinExtension;
+
+    if ( fData ) munmap(fData, fCapacity);
+    fData = 0;
+
+    if ( ftruncate(fFileDescriptor, capacity) != 0 ) {
+      Fatal("Reserve", "Cannot extend file %s.", fFileName.Data());
+    }
+
+    void* data = mmap(0, capacity, PROT_READ | PROT_WRITE, MAP_SHARED,
+                      fFileDescriptor, 0);
+    if ( data == MAP_FAILED ) {
+      Fatal("Reserve", "Cannot map file %s.", fFileName.Data());
+    }
+    fData = static_cast<char*>(data);
+    fCapacity = capacity;
+  }
+
+  return fData + fSize;
+}
+
+//_____________________________________________________________________________
+void TMCHitStreamWriter::WriteFileHeader()
+{
+/// Write the file header and the headers of the registered collections.
+
+  Long64_t size
+    = sizeof(TMCHitStreamFileHeader)
+      + fCollections.size()*sizeof(TMCHitStreamCollectionHeader);
+  char* data = Reserve(size);
+  memset(data, 0, size);
+
+  TMCHitStreamFileHeader* fileHeader
+    = reinterpret_cast<TMCHitStreamFileHeader*>(data);
+  memcpy(fileHeader->fMagic, kTMCHitStreamMagic, sizeof(kTMCHitStreamMagic));
+  fileHeader->fVersion = kTMCHitStreamVersion;
+  fileHeader->fNofCollections = fCollections.size();
+
+  TMCHitStreamCollectionHeader* collectionHeader
+    = reinterpret_cast<TMCHitStreamCollectionHeader*>(
+        data + sizeof(TMCHitStreamFileHeader));
+  for ( UInt_t i=0; i<fCollections.size(); ++i ) {
+    strncpy(collectionHeader[i].fName, fNames[i].Data(),
+            sizeof(collectionHeader[i].fName) - 1);
+    collectionHeader[i].fHitSize = fCollections[i].fHitSize;
+  }
+
+  fSize += size;
+  fIsHeaderWritten = true;
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+Int_t TMCHitStreamWriter::Register(const char* name, Int_t hitSize,
+                                   const void* const* hitsAddress,
+                                   const Int_t* nofHitsAddress)
+{
+/// Register the hits collection; all collections have to be registered
+/// before the first Fill().
+/// \param name            The collection name
+/// \param hitSize         The size of one hit (in bytes)
+/// \param hitsAddress     The address of the pointer to the hits array
+/// \param nofHitsAddress  The address of the number of hits
+/// \return                The collection Id
+
+  if ( fIsHeaderWritten ) {
+    Error("Register",
+          "Collection %s cannot be registered after the first Fill.", name);
+    return -1;
+  }
+
+  Collection collection;
+  collection.fHitSize = hitSize;
+  collection.fHitsAddress = hitsAddress;
+  collection.fNofHitsAddress = nofHitsAddress;
+  fCollections.push_back(collection);
+  fNames.push_back(name);
+
+  return fCollections.size() - 1;
+}
+
+//_____________________________________________________________________________
+void TMCHitStreamWriter::Fill(Int_t eventNumber)
+{
+/// Append the event record with the current hits of all registered
+/// collections.
+/// \param eventNumber  The event number (the number of written events
+///                     if not set)
+
+  if ( ! fIsHeaderWritten ) WriteFileHeader();
+
+  Long64_t recordSize = sizeof(TMCHitStreamEventHeader);
+  for ( UInt_t i=0; i<fCollections.size(); ++i ) {
+    recordSize
+      += sizeof(Long64_t)
+         + TMCHitStreamPadded(
+             Long64_t(*fCollections[i].fNofHitsAddress)*fCollections[i].fHitSize);
+  }
+
+  char* data = Reserve(recordSize);
+
+  TMCHitStreamEventHeader* eventHeader
+    = reinterpret_cast<TMCHitStreamEventHeader*>(data);
+  eventHeader->fEventNumber = ( eventNumber >= 0 ) ? eventNumber : fNofEvents;
+  eventHeader->fNofCollections = fCollections.size();
+  eventHeader->fRecordSize = recordSize;
+  data += sizeof(TMCHitStreamEventHeader);
+
+  for ( UInt_t i=0; i<fCollections.size(); ++i ) {
+    Long64_t nofHits = *fCollections[i].fNofHitsAddress;
+    Long64_t hitsSize = nofHits*fCollections[i].fHitSize;
+    memcpy(data, &nofHits, sizeof(Long64_t));
+    data += sizeof(Long64_t);
+    if ( hitsSize ) memcpy(data, *fCollections[i].fHitsAddress, hitsSize);
+    data += TMCHitStreamPadded(hitsSize);
+  }
+
+  fSize += recordSize;
+  ++fNofEvents;
+}
+
+//_____________________________________________________________________________
+void TMCHitStreamWriter::WriteAll()
+{
+/// Schedule writing of the mapped data on disk.
+
+  if ( fData ) msync(fData, fSize, MS_ASYNC);
+}
+
+//_____________________________________________________________________________
+void TMCHitStreamWriter::Close()
+{
+/// Unmap and truncate the file to the size of written data and close it.
+
+  if ( fFileDescriptor < 0 ) {
+    Error("Close", "The file was already closed.");
+    return;
+  }
+
+  if ( ! fIsHeaderWritten ) WriteFileHeader();
+
+  munmap(fData, fCapacity);
+  fData = 0;
+  fCapacity = 0;
+
+  if ( ftruncate(fFileDescriptor, fSize) != 0 ) {
+    Error("Close", "Cannot truncate file %s.", fFileName.Data());
+  }
+  close(fFileDescriptor);
+  fFileDescriptor = -1;
+
+  if ( TVirtualMCRootManager::GetDebug() )
+    printf("TMCHitStreamWriter: %d events, %lld bytes written in %s \n",
+           fNofEvents, fSize, fFileName.Data());
+}
@@ -0,0 +1,209 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2013, 2014 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TMCRootFileMerger.cxx
+/// \brief Implementation of the TMCRootFileMerger class
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include "TMCRootFileMerger.h"
+#include "TVirtualMCRootManager.h"
+#include "TFileMerger.h"
+#include "TFile.h"
+#include "TTree.h"
+#include "TSystem.h"
+#include "TThread.h"
+#include "TError.h"
+
+#include <cstdio>
+#include <pthread.h>
+#include <unistd.h>
+
+namespace {
+  /// The data of a group of files merged in one thread
+  struct MergeGroupData {
+    std::vector<TString>  fInputFileNames; // The input files names
+    TString               fOutputFileName; // The output file name
+    Bool_t                fIsMerged;       // The merging result
+  };
+}
+
+//
+// static private methods
+//
+
+//_____________________________________________________________________________
+void* TMCRootFileMerger::MergeGroup(void* object)
+{
+/// The thread function: merge a group of files
+
+  MergeGroupData* group = static_cast<MergeGroupData*>(object);
+  group->fIsMerged
+    = MergeFiles(group->fInputFileNames, group->fOutputFileName);
+  return 0;
+}
+
+//_____________________________________________________________________________
+Bool_t TMCRootFileMerger::BuildIndex(const char* projectName,
+                                     const TString& fileName,
+                                     const char* indexMajor,
+                                     const char* indexMinor)
+{
+/// Build the index on the merged tree and write it in the file.
+
+  TFile file(fileName, "UPDATE");
+  TTree* tree = static_cast<TTree*>(file.Get(projectName));
+  if ( ! tree ) {
+    Error("BuildIndex", "Tree %s not found in %s.",
+          projectName, fileName.Data());
+    return false;
+  }
+
+  if ( tree->BuildIndex(indexMajor, indexMinor) < 0 ) {
+    Error("BuildIndex", "Failed to build index %s %s.",
+          indexMajor, indexMinor);
+    return false;
+  }
+
+  tree->Write("", TObject::kOverwrite);
+  file.Close();
+  return true;
+}
+
+//
+// static public methods
+//
+
+//_____________________________________________________________________________
+std::vector<TString> TMCRootFileMerger::GetThreadFileNames(
+                                          const char* projectName)
+{
+/// Return the names of the existing per-thread files:
+/// projectName_0.root, projectName_1.root, ...
+/// \param projectName  The project name (passed as the Root tree name)
+
+  std::vector<TString> fileNames;
+  while ( true ) {
+    TString fileName(projectName);
+    fileName += "_";
+    fileName += fileNames.size();
+    fileName += ".root";
+    if ( gSystem->AccessPathName(fileName) ) break;
+      // AccessPathName returns false if the file exists
+    fileNames.push_back(fileName);
+  }
+  return fileNames;
+}
+
+//_____________________________________________________________________________
+Bool_t TMCRootFileMerger::MergeFiles(const std::vector<TString>& inputFileNames,
+                                     const TString& outputFileName)
+{
+/// Merge the input files in the output file with the fast method.
+/// \param inputFileNames  The input files names
+/// \param outputFileName  The output file name
+
+  TFileMerger merger(kFALSE, kFALSE);
+  merger.SetFastMethod(kTRUE);
+  merger.SetPrintLevel(0);
+  if ( ! merger.OutputFile(outputFileName, "RECREATE") ) return false;
+
+  for ( UInt_t i=0; i<inputFileNames.size(); ++i ) {
+    if ( ! merger.AddFile(inputFileNames[i], kFALSE) ) return false;
+  }
+
+  return merger.Merge();
+}
+
+//_____________________________________________________________________________
+Bool_t TMCRootFileMerger::Merge(const char* projectName,
+                                const char* outputFileName,
+                                Int_t nofJobs,
+                                const char* indexMajor,
+                                const char* indexMinor)
+{
+/// Merge the per-thread files produced by TMCRootManagerMT in
+/// a single file.
+/// \param projectName     The project name (passed as the Root tree name)
+/// \param outputFileName  The output file name (projectName.root if not set)
+/// \param nofJobs         The number of concurrent merging jobs
+///                        (the number of CPUs if not set)
+/// \param indexMajor      The index major expression (no index if not set)
+/// \param indexMinor      The index minor expression
+/// \return                true if the merging was successful
+
+  std::vector<TString> inputFileNames = GetThreadFileNames(projectName);
+  if ( ! inputFileNames.size() ) {
+    Error("Merge", "No files %s_N.root found.", projectName);
+    return false;
+  }
+
+  TString outputName(projectName);
+  outputName += ".root";
+  if ( outputFileName ) outputName = outputFileName;
+
+  if ( nofJobs <= 0 ) nofJobs = sysconf(_SC_NPROCESSORS_ONLN);
+  // each job merges at least two files
+  if ( nofJobs > Int_t(inputFileNames.size())/2 )
+    nofJobs = inputFileNames.size()/2;
+
+  if ( TVirtualMCRootManager::GetDebug() )
+    printf("Merging %d files in %s with %d jobs \n",
+           Int_t(inputFileNames.size()), outputName.Data(), nofJobs);
+
+  Bool_t isMerged = true;
+  if ( nofJobs <= 1 ) {
+    isMerged = MergeFiles(inputFileNames, outputName);
+  }
+  else {
+    TThread::Initialize();
+
+    // Split files in groups and merge the groups concurrently
+    std::vector<MergeGroupData> groups(nofJobs);
+    for ( UInt_t i=0; i<inputFileNames.size(); ++i ) {
+      groups[i % nofJobs].fInputFileNames.push_back(inputFileNames[i]);
+    }
+
+    std::vector<pthread_t> threads(nofJobs);
+    for ( Int_t i=0; i<nofJobs; ++i ) {
+      groups[i].fOutputFileName = outputName;
+      groups[i].fOutputFileName.ReplaceAll(".root", "");
+      groups[i].fOutputFileName += "_part";
+      groups[i].fOutputFileName += i;
+      groups[i].fOutputFileName += ".root";
+      groups[i].fIsMerged = false;
+      pthread_create(&threads[i], 0, &TMCRootFileMerger::MergeGroup, &groups[i]);
+    }
+
+    std::vector<TString> partFileNames;
+    for ( Int_t i=0; i<nofJobs; ++i ) {
+      pthread_join(threads[i], 0);
+      isMerged = isMerged && groups[i].fIsMerged;
+      partFileNames.push_back(groups[i].fOutputFileName);
+    }
+
+    // Merge the groups outputs
+    if ( isMerged ) isMerged = MergeFiles(partFileNames, outputName);
+
+    for ( UInt_t i=0; i<partFileNames.size(); ++i ) {
+      gSystem->Unlink(partFileNames[i]);
+    }
+  }
+
+  if ( ! isMerged ) {
+    Error("Merge", "Merging files in %s failed.", outputName.Data());
+    return false;
+  }
+
+  if ( indexMajor ) {
+    return BuildIndex(projectName, outputName, indexMajor, indexMinor);
+  }
+
+  return true;
+}
@@ -73,11 +73,13 @@ void  TMCRootManager::Register(const char* name, const char* className,
 }
 
 //_____________________________________________________________________________
-void  TMCRootManager::Fill()
+void  TMCRootManager::Fill(Int_t eventNumber)
 {
 /// Fill the Root tree.
+/// \param eventNumber  The event number (the number of filled entries
+///                     if not set)
 
-  fRootManager->Fill();
+  fRootManager->Fill(eventNumber);
 }  
 
 //_____________________________________________________________________________
@@ -113,3 +115,72 @@ void  TMCRootManager::ReadEvent(Int_t i)
 
   fRootManager->ReadEvent(i);
 }
+
+//_____________________________________________________________________________
+void  TMCRootManager::SetBranchOptions(const char* branchName, 
+                                       Int_t basketSize, Int_t splitLevel,
+                                       Int_t compression)
+{
+/// Set the output options for the given branch.
+/// \param branchName   The branch name ("*" for all branches)
+/// \param basketSize   The basket size (in bytes)
+/// \param splitLevel   The split level
+/// \param compression  The compression settings (-1 for the file settings)
+
+  fRootManager->SetBranchOptions(branchName, basketSize, splitLevel, compression);
+}
+
+//_____________________________________________________________________________
+void  TMCRootManager::SetCompression(Int_t algorithm, Int_t level)
+{
+/// Set the file compression algorithm and level, applied also to the
+/// registered branches without their own compression settings
+/// (the already written baskets keep their compression).
+/// \param algorithm  The compression algorithm
+/// \param level      The compression level
+
+  fRootManager->SetCompression(algorithm, level);
+}
+
+//_____________________________________________________________________________
+void  TMCRootManager::SetAutoFlush(Long64_t autoFlush)
+{
+/// Set the tree auto flush (see TTree::SetAutoFlush)
+/// \param autoFlush  The number of entries (>0) or bytes (<0)
+
+  fRootManager->SetAutoFlush(autoFlush);
+}
+
+//_____________________________________________________________________________
+void  TMCRootManager::SetAutoSave(Long64_t autoSave)
+{
+/// Set the tree auto save (see TTree::SetAutoSave)
+/// \param autoSave  The number of entries (>0) or bytes (<0)
+
+  fRootManager->SetAutoSave(autoSave);
+}
+
+//_____________________________________________________________________________
+void  TMCRootManager::SetAutoTuneBaskets(Int_t nofEvents, Long64_t maxMemory)
+{
+/// Activate the baskets sizes optimization after the given number 
+/// of filled events.
+/// \param nofEvents  The number of events (0 to switch off)
+/// \param maxMemory  The maximum memory for all baskets (in bytes)
+
+  fRootManager->SetAutoTuneBaskets(nofEvents, maxMemory);
+}
+
+//_____________________________________________________________________________
+void  TMCRootManager::SetReadCache(Long64_t cacheSize, Int_t nofLearnEntries,
+                                   Bool_t asyncPrefetching)
+{
+/// Activate the tree cache in the read mode.
+/// \param cacheSize         The cache size (in bytes)
+/// \param nofLearnEntries   The number of entries in the learning phase
+///                          (0 = only the registered branches are cached)
+/// \param asyncPrefetching  Option to activate the asynchronous prefetching
+///                          (applied only to this manager tree cache)
+
+  fRootManager->SetReadCache(cacheSize, nofLearnEntries, asyncPrefetching);
+}
@@ -15,9 +15,17 @@
 #include "TMCRootManagerImpl.h"
 #include "TVirtualMCRootManager.h"
 #include "TTree.h"
+#include "TBranch.h"
+#include "TTreeCache.h"
+#include "TEnv.h"
 #include "TFile.h"
+#include "TMemFile.h"
+#include "TClass.h"
+#include "TBufferFile.h"
+#include "TStopwatch.h"
 #include "TError.h"
 #include "TThread.h"
+#include "TDirectory.h"
 #include "Riostream.h"
 
 #include <cstdio>
@@ -32,7 +40,34 @@ TMCRootManagerImpl::TMCRootManagerImpl(const char* projectName,
                                        Int_t threadRank)
   : fFile(0),
     fTree(0),
-    fIsClosed(false)
+    fIsClosed(false),
+    fMerger(0),
+    fMergerQueue(0),
+    fMergeAutoFlush(0),
+    fEventNumber(0),
+    fBranchOptions(),
+    fAutoTuneNofEvents(0),
+    fAutoTuneMaxMemory(0),
+    fNofFilledEvents(0),
+    fIsReadMode(fileMode == TVirtualMCRootManager::kRead),
+    fIsReadCache(false),
+    fReadBranchNames(),
+    fIsAsyncFill(TVirtualMCRootManager::GetAsyncFill() &&
+                 fileMode == TVirtualMCRootManager::kWrite),
+    fAsyncQueueDepth(TVirtualMCRootManager::GetAsyncFillQueueDepth()),
+    fAsyncBranches(),
+    fAsyncQueue(),
+    fAsyncFreeBuffers(),
+    fIOThread(),
+    fAsyncMutex(),
+    fAsyncCondition(),
+    fIsIOStarted(false),
+    fIsIOBusy(false),
+    fIsIOStopping(false),
+    fNofAsyncFills(0),
+    fNofAsyncWaits(0),
+    fAsyncWaitTime(0.),
+    fMaxAsyncQueueSize(0)
 {
 /// Standard constructor
 /// \param projectName  The project name (passed as the Root tree name)
@@ -42,6 +77,9 @@ TMCRootManagerImpl::TMCRootManagerImpl(const char* projectName,
   if ( TVirtualMCRootManager::GetDebug() ) 
     printf("TMCRootManagerImpl::TMCRootManagerImpl %p \n", this);
 
+  pthread_mutex_init(&fAsyncMutex, 0);
+  pthread_cond_init(&fAsyncCondition, 0);
+
   TString fileName(projectName); 
   if ( threadRank >= 0 ) {
     fileName += "_";  
@@ -68,6 +106,7 @@ TMCRootManagerImpl::TMCRootManagerImpl(const char* projectName,
       if ( TVirtualMCRootManager::GetDebug() ) 
         printf("Going to create TTree \n");
       fTree = new TTree(projectName, treeTitle);
+      CreateEventNumberBranch();
       if ( TVirtualMCRootManager::GetDebug() ) 
         printf("Done: TTree %p \n", fTree);
       ;;  
@@ -77,6 +116,66 @@ TMCRootManagerImpl::TMCRootManagerImpl(const char* projectName,
     printf("Done TMCRootManagerImpl::TMCRootManagerImpl %p \n", this);
 }
 
+//_____________________________________________________________________________
+TMCRootManagerImpl::TMCRootManagerImpl(const char* projectName, 
+                                       TMCRootMerger* merger,
+                                       Int_t mergeAutoFlush)
+  : fFile(0),
+    fTree(0),
+    fIsClosed(false),
+    fMerger(merger),
+    fMergerQueue(merger->AddProducer()),
+    fMergeAutoFlush(mergeAutoFlush),
+    fEventNumber(0),
+    fBranchOptions(),
+    fAutoTuneNofEvents(0),
+    fAutoTuneMaxMemory(0),
+    fNofFilledEvents(0),
+    fIsReadMode(false),
+    fIsReadCache(false),
+    fReadBranchNames(),
+    fIsAsyncFill(TVirtualMCRootManager::GetAsyncFill()),
+    fAsyncQueueDepth(TVirtualMCRootManager::GetAsyncFillQueueDepth()),
+    fAsyncBranches(),
+    fAsyncQueue(),
+    fAsyncFreeBuffers(),
+    fIOThread(),
+    fAsyncMutex(),
+    fAsyncCondition(),
+    fIsIOStarted(false),
+    fIsIOBusy(false),
+    fIsIOStopping(false),
+    fNofAsyncFills(0),
+    fNofAsyncWaits(0),
+    fAsyncWaitTime(0.),
+    fMaxAsyncQueueSize(0)
+{
+/// Constructor for the write mode with the output merged in a single file
+/// \param projectName     The project name (passed as the Root tree name)
+/// \param merger          The output merger
+/// \param mergeAutoFlush  The number of entries after which the data are
+///                        passed to the merger
+
+  if ( TVirtualMCRootManager::GetDebug() ) 
+    printf("TMCRootManagerImpl::TMCRootManagerImpl %p \n", this);
+
+  pthread_mutex_init(&fAsyncMutex, 0);
+  pthread_cond_init(&fAsyncCondition, 0);
+
+  TString fileName(projectName); 
+  fileName += ".root";
+
+  TString treeTitle(projectName);
+  treeTitle += " tree";
+
+  fFile = new TMemFile(fileName, "recreate");
+  fTree = new TTree(projectName, treeTitle);
+  CreateEventNumberBranch();
+
+  if ( TVirtualMCRootManager::GetDebug() ) 
+    printf("Done TMCRootManagerImpl::TMCRootManagerImpl %p \n", this);
+}
+
 //_____________________________________________________________________________
 TMCRootManagerImpl::~TMCRootManagerImpl() 
 {
@@ -85,13 +184,259 @@ TMCRootManagerImpl::~TMCRootManagerImpl()
   if ( TVirtualMCRootManager::GetDebug() ) 
     printf("TMCRootManagerImpl::~TMCRootManagerImpl %p \n", this);
 
+  StopIO();
+
   if ( fFile && ! fIsClosed ) fFile->Close();
   delete fFile;
 
+  for ( UInt_t i=0; i<fAsyncBranches.size(); ++i ) {
+    fAsyncBranches[i]->fClass->Destructor(fAsyncBranches[i]->fObject);
+    delete fAsyncBranches[i];
+  }
+  for ( UInt_t i=0; i<fAsyncFreeBuffers.size(); ++i ) {
+    delete fAsyncFreeBuffers[i];
+  }
+  pthread_cond_destroy(&fAsyncCondition);
+  pthread_mutex_destroy(&fAsyncMutex);
+
   if ( TVirtualMCRootManager::GetDebug() ) 
     printf("Done TMCRootManagerImpl::~TMCRootManagerImpl %p \n", this);
 }
 
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+const TMCRootManagerImpl::BranchOptions& 
+TMCRootManagerImpl::GetBranchOptions(const char* branchName) const
+{
+/// Return the output options for the given branch, the options for all
+/// branches or the default options.
+
+  static const BranchOptions kDefaultOptions;
+
+  std::map<TString, BranchOptions>::const_iterator it 
+    = fBranchOptions.find(branchName);
+  if ( it != fBranchOptions.end() ) return it->second;
+
+  it = fBranchOptions.find("*");
+  if ( it != fBranchOptions.end() ) return it->second;
+
+  return kDefaultOptions;
+}
+
+//_____________________________________________________________________________
+void  TMCRootManagerImpl::CreateBranch(const char* name, const char* className,
+                                       void* objAddress)
+{
+/// Create a branch with the output options set for this branch.
+
+  const BranchOptions& options = GetBranchOptions(name);
+
+  TDirectory::TContext context(fFile);
+  TBranch* branch 
+    = fTree->Branch(name, className, objAddress, 
+                    options.fBasketSize, options.fSplitLevel);
+  if ( branch && options.fCompression >= 0 ) 
+    branch->SetCompressionSettings(options.fCompression);
+}
+
+//_____________________________________________________________________________
+void  TMCRootManagerImpl::CreateEventNumberBranch()
+{
+/// Create the branch with the event number of each entry.
+
+  TDirectory::TContext context(fFile);
+  fTree->Branch("eventNumber", &fEventNumber, "eventNumber/I");
+}
+
+//_____________________________________________________________________________
+void  TMCRootManagerImpl::SendToMerger()
+{
+/// Write the memory file, pass its content to the merger
+/// and reset the tree.
+
+  fFile->Write();
+  TMemFile* memFile = static_cast<TMemFile*>(fFile);
+  Long64_t size = memFile->GetEND();
+  char* buffer = new char[size];
+  memFile->CopyTo(buffer, size);
+  fMerger->Push(fMergerQueue, buffer, size);
+  memFile->ResetAfterMerge(0);
+}
+
+//_____________________________________________________________________________
+void* TMCRootManagerImpl::RunIO(void* object)
+{
+/// The I/O thread function: read the queued buffers in the objects
+/// attached to the tree and fill the tree until the stop is requested
+/// and the queue is empty.
+
+  TMCRootManagerImpl* manager = static_cast<TMCRootManagerImpl*>(object);
+
+  pthread_mutex_lock(&manager->fAsyncMutex);
+  while ( true ) {
+    while ( manager->fAsyncQueue.empty() && ! manager->fIsIOStopping ) {
+      pthread_cond_wait(&manager->fAsyncCondition, &manager->fAsyncMutex);
+    }  
+    if ( manager->fAsyncQueue.empty() ) break;
+
+    TBufferFile* buffer = manager->fAsyncQueue.front();
+    manager->fAsyncQueue.pop_front();
+    manager->fIsIOBusy = true;
+    pthread_cond_broadcast(&manager->fAsyncCondition);
+    pthread_mutex_unlock(&manager->fAsyncMutex);
+
+    buffer->SetReadMode();
+    buffer->Reset();
+    *buffer >> manager->fEventNumber;
+    for ( UInt_t i=0; i<manager->fAsyncBranches.size(); ++i ) {
+      AsyncBranch* branch = manager->fAsyncBranches[i];
+      branch->fClass->Streamer(branch->fObject, *buffer);
+    }
+    manager->FillTree();
+
+    pthread_mutex_lock(&manager->fAsyncMutex);
+    manager->fAsyncFreeBuffers.push_back(buffer);
+    manager->fIsIOBusy = false;
+    pthread_cond_broadcast(&manager->fAsyncCondition);
+  }
+  pthread_mutex_unlock(&manager->fAsyncMutex);
+
+  return 0;
+}
+
+//_____________________________________________________________________________
+void  TMCRootManagerImpl::FillTree()
+{
+/// Fill the tree and pass the filled entries to the merger if 
+/// their number reached the merger auto flush value.
+
+  // gDirectory is thread-local with the Root thread safety enabled
+  TDirectory::TContext context(fFile);
+  fTree->Fill();
+
+  if ( ++fNofFilledEvents == fAutoTuneNofEvents ) {
+    if ( TVirtualMCRootManager::GetDebug() ) 
+      printf("Optimizing baskets after %lld events \n", fNofFilledEvents);
+    fTree->OptimizeBaskets(fAutoTuneMaxMemory, 1.1, "");
+  }  
+
+  if ( fMerger && fTree->GetEntries() >= fMergeAutoFlush ) SendToMerger();
+}  
+
+//_____________________________________________________________________________
+void  TMCRootManagerImpl::RegisterAsync(const char* name, const char* className, 
+                                        void* objAddress)
+{
+/// Create a branch associated with a copy of the registered object
+/// which is filled in the I/O thread.
+
+  for ( UInt_t i=0; i<fAsyncBranches.size(); ++i ) {
+    if ( fAsyncBranches[i]->fName == name ) {
+      fAsyncBranches[i]->fAddress = static_cast<void**>(objAddress);
+      return;
+    }  
+  }    
+
+  TClass* cl = TClass::GetClass(className);
+  if ( ! cl ) {
+    Error("Register", "Class %s not found.", className);
+    return;
+  }  
+
+  AsyncBranch* branch = new AsyncBranch();
+  branch->fName = name;
+  branch->fClass = cl;
+  branch->fAddress = static_cast<void**>(objAddress);
+  branch->fObject = cl->New();
+  fAsyncBranches.push_back(branch);
+
+  CreateBranch(name, className, &branch->fObject);
+}
+
+//_____________________________________________________________________________
+void  TMCRootManagerImpl::FillAsync(Int_t eventNumber)
+{
+/// Stream the event number and the registered objects in a staging buffer
+/// and queue it for the I/O thread; wait if the queue is full.
+
+  if ( ! fIsIOStarted ) {
+    pthread_create(&fIOThread, 0, &TMCRootManagerImpl::RunIO, this);
+    fIsIOStarted = true;
+  }  
+
+  pthread_mutex_lock(&fAsyncMutex);
+  if ( Int_t(fAsyncQueue.size()) >= fAsyncQueueDepth ) {
+    ++fNofAsyncWaits;
+    TStopwatch timer;
+    while ( Int_t(fAsyncQueue.size()) >= fAsyncQueueDepth ) {
+      pthread_cond_wait(&fAsyncCondition, &fAsyncMutex);
+    }
+    fAsyncWaitTime += timer.RealTime();
+  }    
+  TBufferFile* buffer = 0;
+  if ( fAsyncFreeBuffers.size() ) {
+    buffer = fAsyncFreeBuffers.back();
+    fAsyncFreeBuffers.pop_back();
+  }  
+  pthread_mutex_unlock(&fAsyncMutex);
+
+  if ( ! buffer ) buffer = new TBufferFile(TBuffer::kWrite);
+  buffer->SetWriteMode();
+  buffer->Reset();
+  *buffer << eventNumber;
+  for ( UInt_t i=0; i<fAsyncBranches.size(); ++i ) {
+    AsyncBranch* branch = fAsyncBranches[i];
+    branch->fClass->Streamer(*branch->fAddress, *buffer);
+  }
+
+  pthread_mutex_lock(&fAsyncMutex);
+  fAsyncQueue.push_back(buffer);
+  ++fNofAsyncFills;
+  if ( Int_t(fAsyncQueue.size()) > fMaxAsyncQueueSize ) 
+    fMaxAsyncQueueSize = fAsyncQueue.size();
+  pthread_cond_broadcast(&fAsyncCondition);
+  pthread_mutex_unlock(&fAsyncMutex);
+}  
+
+//_____________________________________________________________________________
+void  TMCRootManagerImpl::WaitIO()
+{
+/// Wait until all queued buffers are filled in the tree.
+
+  if ( ! fIsIOStarted ) return;
+
+  pthread_mutex_lock(&fAsyncMutex);
+  while ( fAsyncQueue.size() || fIsIOBusy ) {
+    pthread_cond_wait(&fAsyncCondition, &fAsyncMutex);
+  }  
+  pthread_mutex_unlock(&fAsyncMutex);
+}
+
+//_____________________________________________________________________________
+void  TMCRootManagerImpl::StopIO()
+{
+/// Fill all queued buffers, stop the I/O thread and print 
+/// the asynchronous fill statistics in the debug mode.
+
+  if ( ! fIsIOStarted ) return;
+
+  pthread_mutex_lock(&fAsyncMutex);
+  fIsIOStopping = true;
+  pthread_cond_broadcast(&fAsyncCondition);
+  pthread_mutex_unlock(&fAsyncMutex);
+
+  pthread_join(fIOThread, 0);
+  fIsIOStarted = false;
+
+  if ( TVirtualMCRootManager::GetDebug() ) 
+    printf("TMCRootManagerImpl: %lld asynchronous fills, "
+           "%lld waited for I/O thread (%g s), max queue size %d \n",
+           fNofAsyncFills, fNofAsyncWaits, fAsyncWaitTime, fMaxAsyncQueueSize);
+}
+
 //
 // public methods
 //
@@ -105,11 +450,34 @@ void  TMCRootManagerImpl::Register(const char* name, const char* className,
 /// \param className  The class name of the object
 /// \param objAddress The object address
 
-  fFile->cd();
-  if ( ! fTree->GetBranch(name) ) 
-    fTree->Branch(name, className, objAddress, 32000, 99);
-  else  
-    fTree->GetBranch(name)->SetAddress(objAddress);
+  if ( fIsAsyncFill ) {
+    RegisterAsync(name, className, objAddress);
+  }
+  else {  
+    TDirectory::TContext context(fFile);
+    if ( ! fTree->GetBranch(name) ) 
+      CreateBranch(name, className, objAddress);
+    else  
+      fTree->GetBranch(name)->SetAddress(objAddress);
+  }    
+
+  // Read only the registered branches
+  if ( fIsReadMode ) {
+    if ( ! fReadBranchNames.size() ) fTree->SetBranchStatus("*", 0);
+    UInt_t found = 0;
+    fTree->SetBranchStatus(name, 1, &found);
+    fTree->SetBranchStatus(TString(name) + ".*", 1, &found);
+    if ( fIsReadCache ) fTree->AddBranchToCache(name, kTRUE);
+    fReadBranchNames.push_back(name);
+  }  
+
+  // Build the streamer info now, so that it is not done with
+  // the first Fill, which is not locked with the merger or
+  // which is performed in the I/O thread
+  if ( fMerger || fIsAsyncFill ) {
+    TClass* cl = TClass::GetClass(className);
+    if ( cl ) cl->GetStreamerInfo();
+  }  
 }
 
 //_____________________________________________________________________________
@@ -125,20 +493,36 @@ void  TMCRootManagerImpl::Register(const char* name, const char* className,
 }
 
 //_____________________________________________________________________________
-void  TMCRootManagerImpl::Fill()
+void  TMCRootManagerImpl::Fill(Int_t eventNumber)
 {
 /// Fill the Root tree.
+/// \param eventNumber  The event number (the number of filled entries
+///                     if not set)
 
-  fFile->cd();
-  fTree->Fill();
+  if ( fIsAsyncFill ) {
+    FillAsync(( eventNumber >= 0 ) ? eventNumber : Int_t(fNofAsyncFills));
+    return;
+  }
+
+  fEventNumber = ( eventNumber >= 0 ) ? eventNumber : Int_t(fNofFilledEvents);
+  FillTree();
 }  
 
 //_____________________________________________________________________________
 void TMCRootManagerImpl:: WriteAll()
 {
 /// Write the Root tree in the file.
+/// With the merger, the entries filled since the last send are passed
+/// to the merger.
+
+  WaitIO();
+
+  TDirectory::TContext context(fFile);
+  if ( fMerger ) {
+    if ( fTree->GetEntries() ) SendToMerger();
+    return;
+  }  
 
-  fFile->cd();
   fFile->Write();
 }  
 
@@ -152,7 +536,17 @@ void TMCRootManagerImpl::Close()
     return;
   }  
     
-  fFile->cd();
+  StopIO();
+
+  if ( fIsReadCache && TVirtualMCRootManager::GetDebug() ) 
+    fTree->PrintCacheStats();
+
+  TDirectory::TContext context(fFile);
+  if ( fMerger ) {
+    if ( fTree->GetEntries() ) SendToMerger();
+    fMerger->CloseProducer(fMergerQueue);
+  }  
+
   fFile->Close();
   fIsClosed = true;
 }  
@@ -174,3 +568,133 @@ void  TMCRootManagerImpl::ReadEvent(Int_t i)
 
   fTree->GetEntry(i);
 }
+
+//_____________________________________________________________________________
+void  TMCRootManagerImpl::SetBranchOptions(const char* branchName, 
+                                           Int_t basketSize, Int_t splitLevel,
+                                           Int_t compression)
+{
+/// Set the output options for the given branch; they are applied when
+/// the branch is registered. If the branch already exists, its basket 
+/// size and compression are updated.
+/// \param branchName   The branch name ("*" for all branches)
+/// \param basketSize   The basket size (in bytes)
+/// \param splitLevel   The split level
+/// \param compression  The compression settings (-1 for the file settings)
+
+  fBranchOptions[branchName] 
+    = BranchOptions(basketSize, splitLevel, compression);
+
+  TBranch* branch = fTree->GetBranch(branchName);
+  if ( branch ) {
+    branch->SetBasketSize(basketSize);
+    if ( compression >= 0 ) branch->SetCompressionSettings(compression);
+  }  
+}
+
+//_____________________________________________________________________________
+void  TMCRootManagerImpl::SetCompression(Int_t algorithm, Int_t level)
+{
+/// Set the file compression algorithm and level.
+/// The settings are applied also to the already registered branches
+/// without their own compression (see SetBranchOptions()); the baskets
+/// which were already written keep their compression.
+/// \param algorithm  The compression algorithm
+/// \param level      The compression level
+
+  if ( fIsReadMode ) {
+    Warning("SetCompression", "The compression is used only in write mode.");
+    return;
+  }  
+
+  // The branches must not be modified while the I/O thread is filling
+  WaitIO();
+
+  fFile->SetCompressionAlgorithm(algorithm);
+  fFile->SetCompressionLevel(level);
+
+  TIter next(fTree->GetListOfBranches());
+  TBranch* branch;
+  while ( ( branch = static_cast<TBranch*>(next()) ) ) {
+    if ( GetBranchOptions(branch->GetName()).fCompression >= 0 ) continue;
+    branch->SetCompressionSettings(fFile->GetCompressionSettings());
+  }  
+}
+
+//_____________________________________________________________________________
+void  TMCRootManagerImpl::SetAutoFlush(Long64_t autoFlush)
+{
+/// Set the tree auto flush (see TTree::SetAutoFlush)
+/// \param autoFlush  The number of entries (>0) or bytes (<0)
+
+  fTree->SetAutoFlush(autoFlush);
+}
+
+//_____________________________________________________________________________
+void  TMCRootManagerImpl::SetAutoSave(Long64_t autoSave)
+{
+/// Set the tree auto save (see TTree::SetAutoSave)
+/// \param autoSave  The number of entries (>0) or bytes (<0)
+
+  fTree->SetAutoSave(autoSave);
+}
+
+//_____________________________________________________________________________
+void  TMCRootManagerImpl::SetAutoTuneBaskets(Int_t nofEvents, 
+                                             Long64_t maxMemory)
+{
+/// Activate the baskets sizes optimization (see TTree::OptimizeBaskets)
+/// after the given number of filled events.
+/// \param nofEvents  The number of events (0 to switch off)
+/// \param maxMemory  The maximum memory for all baskets (in bytes)
+
+  fAutoTuneNofEvents = nofEvents;
+  fAutoTuneMaxMemory = maxMemory;
+}
+
+//_____________________________________________________________________________
+void  TMCRootManagerImpl::SetReadCache(Long64_t cacheSize, 
+                                       Int_t nofLearnEntries,
+                                       Bool_t asyncPrefetching)
+{
+/// Activate the tree cache in the read mode.
+/// When the number of learning entries is 0, the learning phase is 
+/// stopped and only the registered branches are cached.
+/// \param cacheSize         The cache size (in bytes)
+/// \param nofLearnEntries   The number of entries in the learning phase
+/// \param asyncPrefetching  Option to activate the asynchronous prefetching
+///
+/// The asynchronous prefetching is applied only to the cache of this
+/// manager tree. As it is passed via the process-wide Root environment
+/// (TFile.AsyncPrefetching), the read caches should not be set concurrently
+/// from several threads.
+
+  if ( ! fIsReadMode ) {
+    Warning("SetReadCache", "The tree cache is used only in read mode.");
+    return;
+  }  
+
+  // The prefetching option is read from the Root environment when
+  // the cache is created; the previous value is restored afterwards
+  // so that the other files are not affected
+  Int_t prefetching = gEnv->GetValue("TFile.AsyncPrefetching", 0);
+  gEnv->SetValue("TFile.AsyncPrefetching", asyncPrefetching ? 1 : 0);
+  fTree->SetCacheSize(cacheSize);
+  gEnv->SetValue("TFile.AsyncPrefetching", prefetching);
+
+  fIsReadCache = ( cacheSize > 0 );
+  if ( ! fIsReadCache ) return;
+
+  for ( UInt_t i=0; i<fReadBranchNames.size(); ++i ) {
+    fTree->AddBranchToCache(fReadBranchNames[i], kTRUE);
+  }
+
+  if ( nofLearnEntries > 0 ) {
+    fTree->SetCacheLearnEntries(nofLearnEntries);
+  }
+  else {
+    TTreeCache* cache 
+      = static_cast<TTreeCache*>(fFile->GetCacheRead(fTree));
+    if ( cache ) cache->StopLearningPhase();
+  }      
+}
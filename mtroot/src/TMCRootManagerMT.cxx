@@ -14,6 +14,7 @@
 
 #include "TMCRootManagerMT.h"
 #include "TMCRootManagerImpl.h"
+#include "TMCRootMerger.h"
 #include "TMCAutoLock.h"
 #include "TThread.h"
 #include "TError.h"
@@ -40,6 +41,22 @@ pthread_mutex_t fill_lock_mutex;
 Int_t   TMCRootManagerMT::fgCounter = 0; 
 Bool_t  TMCRootManagerMT::fgIsFillLock = true; 
 std::vector<Bool_t>* TMCRootManagerMT::fgIsFillLocks = 0;
+Bool_t  TMCRootManagerMT::fgMergeOutput = false; 
+Int_t   TMCRootManagerMT::fgMergeAutoFlush = 100; 
+Int_t   TMCRootManagerMT::fgNofProducers = 0; 
+Int_t   TMCRootManagerMT::fgNofClosed = 0; 
+TMCRootMerger* TMCRootManagerMT::fgMerger = 0; 
+
+//_____________________________________________________________________________
+void  TMCRootManagerMT::FinishMerge()
+{
+/// Finish the merged output file; to be called on the master after all 
+/// workers have closed their managers if the number of producers was not
+/// set in SetMergeOutput().
+
+  TMCAutoLock lk(&closeMutex);
+  if ( fgMerger ) fgMerger->Finish();
+}
 
 //
 // ctors, dtor
@@ -50,7 +67,8 @@ TMCRootManagerMT::TMCRootManagerMT(const char* projectName,
                                    TVirtualMCRootManager::FileMode fileMode)
   : TVirtualMCRootManager(),
     fId(0),
-    fRootManager(0)
+    fRootManager(0),
+    fIsMerged(fgMergeOutput && fileMode == kWrite)
 {
 /// Standard constructor
 /// \param projectName  The project name (passed as the Root tree name)
@@ -69,7 +87,23 @@ TMCRootManagerMT::TMCRootManagerMT(const char* projectName,
   fId = fgCounter;
 
   if ( fgDebug ) printf("Going to new TMCRootManagerImpl in %d  %p \n", fId, this);
-  fRootManager = new TMCRootManagerImpl(projectName, fileMode, fId);
+  if ( fIsMerged ) {
+    if ( fgNofProducers && fgCounter >= fgNofProducers ) {
+      Warning("TMCRootManagerMT", 
+              "More managers than the %d declared producers are merged.",
+              fgNofProducers);
+    }
+    if ( ! fgMerger ) {
+      TString fileName(projectName);
+      fileName += ".root";
+      fgMerger = new TMCRootMerger(fileName);
+    }
+    fRootManager 
+      = new TMCRootManagerImpl(projectName, fgMerger, fgMergeAutoFlush);
+  }
+  else {
+    fRootManager = new TMCRootManagerImpl(projectName, fileMode, fId);
+  }
   if ( fgDebug ) printf("Done new fRootManager in %d  %p \n", fId, this);
 
   // Increment counter
@@ -119,6 +153,10 @@ TMCRootManagerMT::~TMCRootManagerMT()
   if ( ! fgCounter ) {
     delete fgIsFillLocks;
     fgIsFillLocks = 0;
+    // The merger is finished (if not yet done) when deleted
+    delete fgMerger;
+    fgMerger = 0;
+    fgNofClosed = 0;
   }  
   lk.unlock();
 
@@ -131,7 +169,7 @@ TMCRootManagerMT::~TMCRootManagerMT()
 //
 
 //_____________________________________________________________________________
-void  TMCRootManagerMT::FillWithTmpLock()
+void  TMCRootManagerMT::FillWithTmpLock(Int_t eventNumber)
 {
 /// Fill the Root tree.
 
@@ -139,7 +177,7 @@ void  TMCRootManagerMT::FillWithTmpLock()
   TMCAutoLock lk(&tmpFillMutex);
 
   if ( fgDebug ) printf("Fill in %d  %p \n", fId, this);
-  fRootManager->Fill();
+  fRootManager->Fill(eventNumber);
   if ( fgDebug ) printf("Done Fill in %d  %p \n", fId, this);
   
   if ( fgIsFillLock ) {
@@ -163,7 +201,7 @@ void  TMCRootManagerMT::FillWithTmpLock()
 }  
 
 //_____________________________________________________________________________
-void  TMCRootManagerMT::FillWithLock()
+void  TMCRootManagerMT::FillWithLock(Int_t eventNumber)
 {
 /// Fill the Root tree.
 
@@ -171,7 +209,7 @@ void  TMCRootManagerMT::FillWithLock()
   TMCAutoLock lk(&fillMutex);
 
   if ( fgDebug ) printf("Fill in %d  %p \n", fId, this);
-  fRootManager->Fill();
+  fRootManager->Fill(eventNumber);
   if ( fgDebug ) printf("Done Fill in %d  %p \n", fId, this);
   
   lk.unlock();
@@ -179,13 +217,35 @@ void  TMCRootManagerMT::FillWithLock()
 }  
 
 //_____________________________________________________________________________
-void  TMCRootManagerMT::FillWithoutLock()
+void  TMCRootManagerMT::FillWithoutLock(Int_t eventNumber)
 {
   if ( fgDebug ) printf("Fill in %d  %p \n", fId, this);
-  fRootManager->Fill();
+  fRootManager->Fill(eventNumber);
   if ( fgDebug ) printf("Done Fill in %d  %p \n", fId, this);
 }
 
+//_____________________________________________________________________________
+void  TMCRootManagerMT::CloseMerged(Bool_t write)
+{
+/// Pass the remaining data to the merger and close the memory file;
+/// the last of the declared producers waits for the merger to finish
+/// the output file.
+
+  if ( write ) fRootManager->WriteAll();
+  fRootManager->Close();
+
+  if ( fgDebug ) printf("Going to lock for Close in %d  %p \n", fId, this);
+  TMCAutoLock lk(&closeMutex);
+  // The number of producers is set before any manager is created, unlike
+  // fgCounter which may not yet include the managers of slower threads
+  if ( ++fgNofClosed == fgNofProducers ) {
+    if ( fgDebug ) printf("Finish merging in %d  %p \n", fId, this);
+    fgMerger->Finish();
+  }
+  lk.unlock();
+  if ( fgDebug ) printf("Released lock for Close in %d  %p \n", fId, this);
+}  
+
 //
 // public methods
 //
@@ -223,20 +283,29 @@ void  TMCRootManagerMT::Register(const char* name, const char* className,
 }
 
 //_____________________________________________________________________________
-void  TMCRootManagerMT::Fill()
+void  TMCRootManagerMT::Fill(Int_t eventNumber)
 {
 /// Fill the Root tree.
+/// \param eventNumber  The event number (the number of entries filled
+///                     by this manager if not set)
+
+  // Fill without lock when merging output, the streamer infos
+  // are built in Register()
+  if ( fIsMerged ) {
+    FillWithoutLock(eventNumber);
+    return;
+  }
 
   // Fill with lack untill first call on all threads
   if ( fgIsFillLock ) {
-    FillWithTmpLock();
+    FillWithTmpLock(eventNumber);
   }  
   else {
-    FillWithoutLock();
+    FillWithoutLock(eventNumber);
   }
 
   // Fill with lock during the whole run
-  // FillWithLock();
+  // FillWithLock(eventNumber);
 }  
 
 //_____________________________________________________________________________
@@ -244,6 +313,12 @@ void TMCRootManagerMT:: WriteAll()
 {
 /// Write the Root tree in the file.
 
+  // Each thread writes in its own memory file when merging output
+  if ( fIsMerged ) {
+    fRootManager->WriteAll();
+    return;
+  }
+
   if ( fgDebug ) printf("Going to lock for Write in %d  %p \n", fId, this);
   TMCAutoLock lk(&writeMutex);
 
@@ -260,6 +335,11 @@ void TMCRootManagerMT:: Close()
 {
 /// Close the Root file.
 
+  if ( fIsMerged ) {
+    CloseMerged(false);
+    return;
+  }
+
   if ( fgDebug ) printf("Going to lock for Close in %d  %p \n", fId, this);
   TMCAutoLock lk(&closeMutex);
 
@@ -276,6 +356,11 @@ void TMCRootManagerMT:: WriteAndClose()
 {
 /// Write the Root tree in the file and close the file.
 
+  if ( fIsMerged ) {
+    CloseMerged(true);
+    return;
+  }
+
   if ( fgDebug ) printf("Going to lock for WriteAndClose in %d  %p \n", fId, this);
   TMCAutoLock lk(&writeMutex);
 
@@ -298,3 +383,72 @@ void  TMCRootManagerMT::ReadEvent(Int_t i)
 
   fRootManager->ReadEvent(i);
 }
+
+//_____________________________________________________________________________
+void  TMCRootManagerMT::SetBranchOptions(const char* branchName, 
+                                         Int_t basketSize, Int_t splitLevel,
+                                         Int_t compression)
+{
+/// Set the output options for the given branch.
+/// \param branchName   The branch name ("*" for all branches)
+/// \param basketSize   The basket size (in bytes)
+/// \param splitLevel   The split level
+/// \param compression  The compression settings (-1 for the file settings)
+
+  fRootManager->SetBranchOptions(branchName, basketSize, splitLevel, compression);
+}
+
+//_____________________________________________________________________________
+void  TMCRootManagerMT::SetCompression(Int_t algorithm, Int_t level)
+{
+/// Set the file compression algorithm and level, applied also to the
+/// registered branches without their own compression settings
+/// (the already written baskets keep their compression).
+/// \param algorithm  The compression algorithm
+/// \param level      The compression level
+
+  fRootManager->SetCompression(algorithm, level);
+}
+
+//_____________________________________________________________________________
+void  TMCRootManagerMT::SetAutoFlush(Long64_t autoFlush)
+{
+/// Set the tree auto flush (see TTree::SetAutoFlush)
+/// \param autoFlush  The number of entries (>0) or bytes (<0)
+
+  fRootManager->SetAutoFlush(autoFlush);
+}
+
+//_____________________________________________________________________________
+void  TMCRootManagerMT::SetAutoSave(Long64_t autoSave)
+{
+/// Set the tree auto save (see TTree::SetAutoSave)
+/// \param autoSave  The number of entries (>0) or bytes (<0)
+
+  fRootManager->SetAutoSave(autoSave);
+}
+
+//_____________________________________________________________________________
+void  TMCRootManagerMT::SetAutoTuneBaskets(Int_t nofEvents, Long64_t maxMemory)
+{
+/// Activate the baskets sizes optimization after the given number 
+/// of filled events.
+/// \param nofEvents  The number of events (0 to switch off)
+/// \param maxMemory  The maximum memory for all baskets (in bytes)
+
+  fRootManager->SetAutoTuneBaskets(nofEvents, maxMemory);
+}
+
+//_____________________________________________________________________________
+void  TMCRootManagerMT::SetReadCache(Long64_t cacheSize, Int_t nofLearnEntries,
+                                     Bool_t asyncPrefetching)
+{
+/// Activate the tree cache in the read mode.
+/// \param cacheSize         The cache size (in bytes)
+/// \param nofLearnEntries   The number of entries in the learning phase
+///                          (0 = only the registered branches are cached)
+/// \param asyncPrefetching  Option to activate the asynchronous prefetching
+///                          (applied only to this manager tree cache)
+
+  fRootManager->SetReadCache(cacheSize, nofLearnEntries, asyncPrefetching);
+}
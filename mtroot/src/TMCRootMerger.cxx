@@ -0,0 +1,245 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2013, 2014 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TMCRootMerger.cxx
+/// \brief Implementation of the TMCRootMerger class
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include "TMCRootMerger.h"
+#include "TVirtualMCRootManager.h"
+#include "TFileMerger.h"
+#include "TMemFile.h"
+#include "TError.h"
+
+#include <cstdio>
+#include <sys/time.h>
+
+const Long_t TMCRootMerger::fgkPollPeriod = 1000;
+
+//
+// ctors, dtor
+//
+
+//_____________________________________________________________________________
+TMCRootMerger::TMCRootMerger(const char* fileName)
+  : fFileName(fileName),
+    fMerger(0),
+    fQueues(),
+    fQueuesMutex(),
+    fWriter(),
+    fWakeMutex(),
+    fWakeCondition(),
+    fIsFinishing(false),
+    fIsFinished(false),
+    fNofMergedBuffers(0)
+{
+/// Standard constructor
+/// \param fileName  The output file name
+
+  if ( TVirtualMCRootManager::GetDebug() )
+    printf("TMCRootMerger::TMCRootMerger %p \n", this);
+
+  pthread_mutex_init(&fQueuesMutex, 0);
+  pthread_mutex_init(&fWakeMutex, 0);
+  pthread_cond_init(&fWakeCondition, 0);
+
+  fMerger = new TFileMerger(kFALSE, kFALSE);
+  fMerger->SetPrintLevel(0);
+  fMerger->OutputFile(fFileName, "RECREATE");
+
+  pthread_create(&fWriter, 0, &TMCRootMerger::RunWriter, this);
+}
+
+//_____________________________________________________________________________
+TMCRootMerger::~TMCRootMerger()
+{
+/// Destructor
+
+  if ( TVirtualMCRootManager::GetDebug() )
+    printf("TMCRootMerger::~TMCRootMerger %p \n", this);
+
+  Finish();
+
+  for ( UInt_t i=0; i<fQueues.size(); ++i ) delete fQueues[i];
+
+  pthread_cond_destroy(&fWakeCondition);
+  pthread_mutex_destroy(&fWakeMutex);
+  pthread_mutex_destroy(&fQueuesMutex);
+}
+
+//
+// static private methods
+//
+
+//_____________________________________________________________________________
+void* TMCRootMerger::RunWriter(void* object)
+{
+/// The writer thread function: poll the producers queues for the pushed
+/// buffers and merge them until finish is requested and there is no more
+/// buffer to merge.
+/// The wake-up mutex and condition are shared only with Finish(),
+/// producers are never blocked by the writer waiting.
+
+  TMCRootMerger* merger = static_cast<TMCRootMerger*>(object);
+
+  while ( true ) {
+    pthread_mutex_lock(&merger->fWakeMutex);
+    if ( ! merger->fIsFinishing && ! merger->HasPushedBuffers() ) {
+      timeval now;
+      gettimeofday(&now, 0);
+      Long_t usec = now.tv_usec + fgkPollPeriod;
+      timespec timeout;
+      timeout.tv_sec = now.tv_sec + usec / 1000000;
+      timeout.tv_nsec = ( usec % 1000000 ) * 1000;
+      pthread_cond_timedwait(
+        &merger->fWakeCondition, &merger->fWakeMutex, &timeout);
+    }
+    Bool_t isFinishing = merger->fIsFinishing;
+    pthread_mutex_unlock(&merger->fWakeMutex);
+
+    Bool_t isMerged = merger->MergeBuffers();
+    if ( isFinishing && ! isMerged ) break;
+  }
+
+  return 0;
+}
+
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+Bool_t TMCRootMerger::HasPushedBuffers()
+{
+/// Check the producers counters of pushed buffers without locking
+/// their queues.
+/// \return  true if any producer has pushed a buffer not yet taken
+
+  TMCAutoLock lk(&fQueuesMutex);
+  for ( UInt_t i=0; i<fQueues.size(); ++i ) {
+    if ( Long_t(fQueues[i]->fNofPushed) > fQueues[i]->fNofTaken ) return true;
+  }
+  return false;
+}
+
+//_____________________________________________________________________________
+Bool_t TMCRootMerger::MergeBuffers()
+{
+/// Take the buffers from all producers queues and merge them
+/// in the output file.
+/// \return  true if any buffer was merged
+
+  TMCAutoLock lk(&fQueuesMutex);
+  std::vector<Queue*> queues = fQueues;
+  lk.unlock();
+
+  Int_t nofBuffers = 0;
+  for ( UInt_t i=0; i<queues.size(); ++i ) {
+    std::deque< std::pair<char*, Long64_t> > buffers;
+    TMCAutoLock lkq(&queues[i]->fMutex);
+    buffers.swap(queues[i]->fBuffers);
+    lkq.unlock();
+    queues[i]->fNofTaken += buffers.size();
+
+    while ( buffers.size() ) {
+      TMemFile* file
+        = new TMemFile(fFileName, buffers.front().first,
+                       buffers.front().second, "UPDATE");
+      delete [] buffers.front().first;
+      buffers.pop_front();
+      fMerger->AddAdoptFile(file);
+      ++nofBuffers;
+    }
+  }
+
+  if ( ! nofBuffers ) return false;
+
+  if ( TVirtualMCRootManager::GetDebug() )
+    printf("TMCRootMerger: merging %d buffers \n", nofBuffers);
+
+  fMerger->PartialMerge(TFileMerger::kAllIncremental);
+  fNofMergedBuffers += nofBuffers;
+  return true;
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+TMCRootMerger::Queue* TMCRootMerger::AddProducer()
+{
+/// Add a new producer queue
+/// \return  The producer queue to be used in Push() and CloseProducer()
+
+  Queue* queue = new Queue();
+  TMCAutoLock lk(&fQueuesMutex);
+  fQueues.push_back(queue);
+  return queue;
+}
+
+//_____________________________________________________________________________
+void TMCRootMerger::Push(Queue* queue, char* buffer, Long64_t size)
+{
+/// Pass the memory file buffer to the merger; the merger takes
+/// the ownership of the buffer.
+/// Only the producer own queue is locked; the writer is signalled via
+/// the queue atomic counter which it polls.
+/// \param queue       The producer queue
+/// \param buffer      The memory file buffer
+/// \param size        The buffer size
+
+  TMCAutoLock lk(&queue->fMutex);
+  queue->fBuffers.push_back(std::make_pair(buffer, size));
+  lk.unlock();
+
+  ++(queue->fNofPushed);
+}
+
+//_____________________________________________________________________________
+void TMCRootMerger::CloseProducer(Queue* queue)
+{
+/// Mark the producer as finished.
+/// \param queue  The producer queue
+
+  TMCAutoLock lk(&queue->fMutex);
+  queue->fIsClosed = true;
+}
+
+//_____________________________________________________________________________
+void TMCRootMerger::Finish()
+{
+/// Let the writer merge all remaining buffers, wait for its termination
+/// and close the output file.
+
+  if ( fIsFinished ) return;
+
+  pthread_mutex_lock(&fWakeMutex);
+  fIsFinishing = true;
+  pthread_cond_signal(&fWakeCondition);
+  pthread_mutex_unlock(&fWakeMutex);
+
+  pthread_join(fWriter, 0);
+  fIsFinished = true;
+
+  for ( UInt_t i=0; i<fQueues.size(); ++i ) {
+    if ( ! fQueues[i]->fIsClosed ) {
+      Warning("Finish", "Producer %d was not closed.", i);
+    }
+  }
+
+  // Deleting the merger closes the output file
+  delete fMerger;
+  fMerger = 0;
+
+  if ( TVirtualMCRootManager::GetDebug() )
+    printf("TMCRootMerger: %d buffers merged in %s \n",
+           fNofMergedBuffers, fFileName.Data());
+}
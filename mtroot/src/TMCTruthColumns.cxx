@@ -0,0 +1,189 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2013, 2014 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TMCTruthColumns.cxx
+/// \brief Implementation of the TMCTruthColumns class
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include "TMCTruthColumns.h"
+#include "TParticle.h"
+#include "TTree.h"
+#include "TString.h"
+
+namespace {
+
+//_____________________________________________________________________________
+template <typename T>
+void SetColumnAddress(TTree* tree, const char* name, std::vector<T>& column,
+                      const char* type, Bool_t create)
+{
+/// Create the leaf array branch for the given column or update its address
+
+  if ( create ) {
+    TString leafList(name);
+    leafList += "[n]/";
+    leafList += type;
+    tree->Branch(name, &column[0], leafList);
+  }
+  else {
+    tree->SetBranchAddress(name, &column[0]);
+  }
+}
+
+}
+
+//
+// ctors, dtor
+//
+
+//_____________________________________________________________________________
+TMCTruthColumns::TMCTruthColumns()
+  : fN(0),
+    fPdg(),
+    fStatus(),
+    fProcess(),
+    fMother(),
+    fSecondMother(),
+    fFirstDaughter(),
+    fLastDaughter(),
+    fPx(),
+    fPy(),
+    fPz(),
+    fE(),
+    fVx(),
+    fVy(),
+    fVz(),
+    fT(),
+    fWeight()
+{
+/// Default constructor
+
+  // Keep the arrays allocated, so that they have a valid address
+  Resize(1);
+  fN = 0;
+}
+
+//_____________________________________________________________________________
+TMCTruthColumns::~TMCTruthColumns()
+{
+/// Destructor
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+void TMCTruthColumns::Clear()
+{
+/// Remove all particles (the arrays memory is kept)
+
+  fN = 0;
+}
+
+//_____________________________________________________________________________
+void TMCTruthColumns::Resize(Int_t nofParticles)
+{
+/// Resize all columns to the given number of particles.
+/// The branches addresses have to be updated after resizing.
+
+  UInt_t size = ( nofParticles > 0 ) ? nofParticles : 1;
+  fPdg.resize(size);
+  fStatus.resize(size);
+  fProcess.resize(size);
+  fMother.resize(size);
+  fSecondMother.resize(size);
+  fFirstDaughter.resize(size);
+  fLastDaughter.resize(size);
+  fPx.resize(size);
+  fPy.resize(size);
+  fPz.resize(size);
+  fE.resize(size);
+  fVx.resize(size);
+  fVy.resize(size);
+  fVz.resize(size);
+  fT.resize(size);
+  fWeight.resize(size);
+  fN = nofParticles;
+}
+
+//_____________________________________________________________________________
+void TMCTruthColumns::Add(const TParticle& particle)
+{
+/// Add the particle data in the columns.
+
+  Int_t index = fN;
+  if ( index >= Int_t(fPdg.size()) ) Resize(2*fPdg.size());
+  fN = index + 1;
+
+  fPdg[index] = particle.GetPdgCode();
+  fStatus[index] = particle.GetStatusCode();
+  fProcess[index] = particle.GetUniqueID();
+  fMother[index] = particle.GetFirstMother();
+  fSecondMother[index] = particle.GetSecondMother();
+  fFirstDaughter[index] = particle.GetFirstDaughter();
+  fLastDaughter[index] = particle.GetLastDaughter();
+  fPx[index] = particle.Px();
+  fPy[index] = particle.Py();
+  fPz[index] = particle.Pz();
+  fE[index] = particle.Energy();
+  fVx[index] = particle.Vx();
+  fVy[index] = particle.Vy();
+  fVz[index] = particle.Vz();
+  fT[index] = particle.T();
+  fWeight[index] = particle.GetWeight();
+}
+
+//_____________________________________________________________________________
+void TMCTruthColumns::GetParticle(Int_t index, TParticle& particle) const
+{
+/// Fill the given particle with the data at the given index.
+
+  particle.SetPdgCode(fPdg[index]);
+  particle.SetStatusCode(fStatus[index]);
+  particle.SetUniqueID(fProcess[index]);
+  particle.SetFirstMother(fMother[index]);
+  particle.SetLastMother(fSecondMother[index]);
+  particle.SetFirstDaughter(fFirstDaughter[index]);
+  particle.SetLastDaughter(fLastDaughter[index]);
+  particle.SetMomentum(fPx[index], fPy[index], fPz[index], fE[index]);
+  particle.SetProductionVertex(fVx[index], fVy[index], fVz[index], fT[index]);
+  particle.SetWeight(fWeight[index]);
+}
+
+//_____________________________________________________________________________
+void TMCTruthColumns::SetBranchAddresses(TTree* tree, Bool_t create)
+{
+/// Create the branches in the given tree or update their addresses.
+/// \param tree    The tree
+/// \param create  If true, the branches are created
+
+  if ( create )
+    tree->Branch("n", &fN, "n/I");
+  else
+    tree->SetBranchAddress("n", &fN);
+
+  SetColumnAddress(tree, "pdg", fPdg, "I", create);
+  SetColumnAddress(tree, "status", fStatus, "I", create);
+  SetColumnAddress(tree, "process", fProcess, "I", create);
+  SetColumnAddress(tree, "mother", fMother, "I", create);
+  SetColumnAddress(tree, "secondMother", fSecondMother, "I", create);
+  SetColumnAddress(tree, "firstDaughter", fFirstDaughter, "I", create);
+  SetColumnAddress(tree, "lastDaughter", fLastDaughter, "I", create);
+  SetColumnAddress(tree, "px", fPx, "D", create);
+  SetColumnAddress(tree, "py", fPy, "D", create);
+  SetColumnAddress(tree, "pz", fPz, "D", create);
+  SetColumnAddress(tree, "e", fE, "D", create);
+  SetColumnAddress(tree, "vx", fVx, "D", create);
+  SetColumnAddress(tree, "vy", fVy, "D", create);
+  SetColumnAddress(tree, "vz", fVz, "D", create);
+  SetColumnAddress(tree, "t", fT, "D", create);
+  SetColumnAddress(tree, "weight", fWeight, "D", create);
+}
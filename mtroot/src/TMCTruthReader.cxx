@@ -0,0 +1,116 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2013, 2014 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TMCTruthReader.cxx
+/// \brief Implementation of the TMCTruthReader class
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include "TMCTruthReader.h"
+#include "TVirtualMCRootManager.h"
+#include "TFile.h"
+#include "TDirectory.h"
+#include "TTree.h"
+#include "TBranch.h"
+#include "TClonesArray.h"
+#include "TParticle.h"
+#include "TError.h"
+
+#include <cstdio>
+
+//
+// ctors, dtor
+//
+
+//_____________________________________________________________________________
+TMCTruthReader::TMCTruthReader(const char* fileName)
+  : fFile(0),
+    fTree(0),
+    fColumns()
+{
+/// Standard constructor
+/// \param fileName  The file written with TMCTruthWriter
+
+  // Keep the current directory unchanged
+  TDirectory::TContext context;
+
+  fFile = new TFile(fileName);
+  fTree = static_cast<TTree*>(fFile->Get("truth"));
+  if ( ! fTree ) {
+    Error("TMCTruthReader", "Tree truth not found in %s.", fileName);
+    return;
+  }
+  fColumns.SetBranchAddresses(fTree);
+}
+
+//_____________________________________________________________________________
+TMCTruthReader::~TMCTruthReader()
+{
+/// Destructor
+
+  delete fFile;
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+Bool_t TMCTruthReader::ReadEvent(Int_t i)
+{
+/// Read the particles of the \em i -th event.
+/// \param i  The event to be read
+
+  if ( ! fTree ) return false;
+
+  // Read the number of particles first and resize the columns
+  // so that the arrays can hold all event particles
+  Int_t nofParticles = 0;
+  TBranch* nBranch = fTree->GetBranch("n");
+  nBranch->SetAddress(&nofParticles);
+  if ( nBranch->GetEntry(i) <= 0 ) return false;
+
+  fColumns.Resize(nofParticles);
+  fColumns.SetBranchAddresses(fTree);
+  return fTree->GetEntry(i) > 0;
+}
+
+//_____________________________________________________________________________
+void TMCTruthReader::GetParticle(Int_t index, TParticle& particle) const
+{
+/// Rebuild the particle with the given index in the current event.
+
+  if ( index < 0 || index >= fColumns.GetNofParticles() ) {
+    Error("GetParticle", "Index %d out of range.", index);
+    return;
+  }
+
+  fColumns.GetParticle(index, particle);
+}
+
+//_____________________________________________________________________________
+void TMCTruthReader::GetParticles(TClonesArray& particles) const
+{
+/// Rebuild all particles of the current event in the given array
+/// of TParticle objects.
+
+  particles.Clear();
+  for ( Int_t i=0; i<fColumns.GetNofParticles(); ++i ) {
+    TParticle* particle = new (particles[i]) TParticle();
+    fColumns.GetParticle(i, *particle);
+  }
+}
+
+//_____________________________________________________________________________
+Int_t TMCTruthReader::GetNofEvents() const
+{
+/// Return the number of events in the file
+
+  return fTree ? fTree->GetEntries() : 0;
+}
@@ -0,0 +1,123 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2013, 2014 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TMCTruthWriter.cxx
+/// \brief Implementation of the TMCTruthWriter class
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include "TMCTruthWriter.h"
+#include "TVirtualMCRootManager.h"
+#include "TFile.h"
+#include "TDirectory.h"
+#include "TTree.h"
+#include "TObjArray.h"
+#include "TParticle.h"
+#include "TError.h"
+
+#include <cstdio>
+
+//
+// ctors, dtor
+//
+
+//_____________________________________________________________________________
+TMCTruthWriter::TMCTruthWriter(const char* projectName, Int_t threadRank)
+  : fFile(0),
+    fTree(0),
+    fColumns()
+{
+/// Standard constructor
+/// \param projectName  The project name (used in the file name)
+/// \param threadRank   The thread Id (-1 when sequential mode)
+
+  if ( TVirtualMCRootManager::GetDebug() )
+    printf("TMCTruthWriter::TMCTruthWriter %p \n", this);
+
+  TString fileName(projectName);
+  fileName += "_truth";
+  if ( threadRank >= 0 ) {
+    fileName += "_";
+    fileName += threadRank;
+  }
+  fileName += ".root";
+
+  // Keep the current directory unchanged
+  TDirectory::TContext context;
+
+  fFile = new TFile(fileName, "recreate");
+  fTree = new TTree("truth", TString(projectName) + " MC truth");
+  fColumns.SetBranchAddresses(fTree, true);
+}
+
+//_____________________________________________________________________________
+TMCTruthWriter::~TMCTruthWriter()
+{
+/// Destructor
+
+  if ( TVirtualMCRootManager::GetDebug() )
+    printf("TMCTruthWriter::~TMCTruthWriter %p \n", this);
+
+  if ( fFile && fFile->IsOpen() ) fFile->Close();
+  delete fFile;
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+void TMCTruthWriter::AddParticle(const TParticle& particle)
+{
+/// Add the particle in the current event
+
+  fColumns.Add(particle);
+}
+
+//_____________________________________________________________________________
+void TMCTruthWriter::Fill()
+{
+/// Fill the tree with the particles added in the current event
+/// and clear the columns for the next event.
+
+  // The columns may have been reallocated when adding particles
+  fColumns.SetBranchAddresses(fTree);
+
+  TDirectory::TContext context(fFile);
+  fTree->Fill();
+  fColumns.Clear();
+}
+
+//_____________________________________________________________________________
+void TMCTruthWriter::Fill(const TObjArray& particles)
+{
+/// Fill the tree with the particles from the given array
+/// (eg. the stack TClonesArray).
+
+  fColumns.Clear();
+  for ( Int_t i=0; i<particles.GetEntriesFast(); ++i ) {
+    TParticle* particle = static_cast<TParticle*>(particles.UncheckedAt(i));
+    if ( ! particle ) {
+      Error("Fill", "Particle %d not defined.", i);
+      continue;
+    }
+    fColumns.Add(*particle);
+  }
+  Fill();
+}
+
+//_____________________________________________________________________________
+void TMCTruthWriter::WriteAndClose()
+{
+/// Write the tree in the file and close the file
+
+  TDirectory::TContext context(fFile);
+  fFile->Write();
+  fFile->Close();
+}
@@ -14,12 +14,17 @@
 
 #include "TVirtualMCRootManager.h"
 #include "TError.h"
+#include "TThread.h"
+#include "TROOT.h"
+#include "RVersion.h"
 
 //
 // static data, methods
 //
 
                                Bool_t  TVirtualMCRootManager::fgDebug = false;
+                               Bool_t  TVirtualMCRootManager::fgAsyncFill = false;
+                               Int_t   TVirtualMCRootManager::fgAsyncFillQueueDepth = 2;
 TMCThreadLocal TVirtualMCRootManager*  TVirtualMCRootManager::fgInstance = 0;
 
 //_____________________________________________________________________________
@@ -30,6 +35,30 @@ TVirtualMCRootManager* TVirtualMCRootManager::Instance()
   return fgInstance;
 }  
 
+//_____________________________________________________________________________
+void TVirtualMCRootManager::SetAsyncFill(Bool_t asyncFill, Int_t queueDepth)
+{
+/// Activate the asynchronous fill; to be called on the master before 
+/// the workers are started.
+/// \param asyncFill   If true, the trees are filled in the I/O threads
+/// \param queueDepth  The max number of events waiting for fill
+///
+/// The Root thread safety, required by the I/O threads which fill the trees 
+/// while the transport threads may perform other Root I/O, is enabled here,
+/// so that it is done only once and before any worker thread is running.
+
+  fgAsyncFill = asyncFill;
+  fgAsyncFillQueueDepth = queueDepth;
+
+  if ( ! asyncFill ) return;
+
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,0,0)
+  ROOT::EnableThreadSafety();
+#else
+  TThread::Initialize();
+#endif
+}  
+
 //
 // ctors, dtor
 //
@@ -56,3 +85,60 @@ TVirtualMCRootManager::~TVirtualMCRootManager()
   fgInstance = 0;
 }
 
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+void  TVirtualMCRootManager::SetBranchOptions(const char* /*branchName*/, 
+                                  Int_t /*basketSize*/, Int_t /*splitLevel*/,
+                                  Int_t /*compression*/)
+{
+/// Set the branch options (not implemented by default)
+
+  Warning("TVirtualMCRootManager::SetBranchOptions", "Not implemented.");
+}
+
+//_____________________________________________________________________________
+void  TVirtualMCRootManager::SetCompression(Int_t /*algorithm*/, 
+                                            Int_t /*level*/)
+{
+/// Set the file compression (not implemented by default)
+
+  Warning("TVirtualMCRootManager::SetCompression", "Not implemented.");
+}
+
+//_____________________________________________________________________________
+void  TVirtualMCRootManager::SetAutoFlush(Long64_t /*autoFlush*/)
+{
+/// Set the tree auto flush (not implemented by default)
+
+  Warning("TVirtualMCRootManager::SetAutoFlush", "Not implemented.");
+}
+
+//_____________________________________________________________________________
+void  TVirtualMCRootManager::SetAutoSave(Long64_t /*autoSave*/)
+{
+/// Set the tree auto save (not implemented by default)
+
+  Warning("TVirtualMCRootManager::SetAutoSave", "Not implemented.");
+}
+
+//_____________________________________________________________________________
+void  TVirtualMCRootManager::SetAutoTuneBaskets(Int_t /*nofEvents*/, 
+                                                Long64_t /*maxMemory*/)
+{
+/// Set the baskets auto tuning (not implemented by default)
+
+  Warning("TVirtualMCRootManager::SetAutoTuneBaskets", "Not implemented.");
+}
+
+//_____________________________________________________________________________
+void  TVirtualMCRootManager::SetReadCache(Long64_t /*cacheSize*/, 
+                                          Int_t /*nofLearnEntries*/,
+                                          Bool_t /*asyncPrefetching*/)
+{
+/// Set the tree cache in the read mode (not implemented by default)
+
+  Warning("TVirtualMCRootManager::SetReadCache", "Not implemented.");
+}
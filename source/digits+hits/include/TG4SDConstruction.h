@@ -19,6 +19,10 @@
 #include "TG4SDMessenger.h"
 
 #include <set>
+#include <map>
+#include <vector>
+
+class TG4SensitiveDetector;
 
 class G4LogicalVolume;
 
@@ -32,6 +36,10 @@ class G4LogicalVolume;
 /// all cloned logical volumes (which a single G3 volume correspond to)
 /// share the same sensitive detector instance.
 ///
+/// In MT mode, the sensitive detector names and media IDs per logical volume
+/// are evaluated only once on master and they are then shared (read-only) 
+/// by workers.
+///
 /// \author I. Hrivnacova; IPN, Orsay
 
 class TG4SDConstruction : public TG4Verbose
@@ -54,8 +62,12 @@ class TG4SDConstruction : public TG4Verbose
     void SetIsGflash(G4bool isGflash);
 
   private:
+    /// The map of sensitive detectors names to their objects
+    typedef std::map<G4String, TG4SensitiveDetector*> SDMap;
+
     // methods
-    G4int CreateSD(G4LogicalVolume* lv) const;
+    G4int CreateSD(G4LogicalVolume* lv, const G4String& sdName, 
+                   G4int mediumId, SDMap& sdMap) const;
     void  FillSDSelectionFromTGeo();
     
     TG4SDMessenger  fMessenger;  ///< messenger
@@ -63,6 +75,13 @@ class TG4SDConstruction : public TG4Verbose
     /// default value of the sensitive volumes label
     static const G4String  fgkDefaultSVLabel; 
 
+    /// the sensitive detector names per logical volume store index
+    /// (empty if the volume is not sensitive), filled on master
+    static std::vector<G4String>  fgSDNames;
+
+    /// the medium IDs per logical volume store index, filled on master
+    static std::vector<G4int>  fgMediumIds;
+
     /// the flag to activate retrieving sensitive volumes from TGeo
     G4bool             fSelectionFromTGeo;
     
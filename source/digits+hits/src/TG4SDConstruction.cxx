@@ -18,6 +18,7 @@
 #include "TG4GflashSensitiveDetector.h"
 #include "TG4GeometryServices.h"
 #include "TG4StateManager.h"
+#include "TG4Globals.h"
 
 #include <G4SDManager.hh>
 #include <G4LogicalVolume.hh>
@@ -31,6 +32,8 @@
 #include <TVirtualMC.h>
 
 const G4String  TG4SDConstruction::fgkDefaultSVLabel = "SV";
+std::vector<G4String>  TG4SDConstruction::fgSDNames;
+std::vector<G4int>     TG4SDConstruction::fgMediumIds;
 
 //_____________________________________________________________________________
 TG4SDConstruction::TG4SDConstruction()
@@ -55,47 +58,38 @@ TG4SDConstruction::~TG4SDConstruction()
 //
 
 //_____________________________________________________________________________
-G4int TG4SDConstruction::CreateSD(G4LogicalVolume* lv) const
+G4int TG4SDConstruction::CreateSD(G4LogicalVolume* lv, 
+                                  const G4String& sdName, G4int mediumId,
+                                  SDMap& sdMap) const
 { 
 /// Create/retrieve a sensitive detector for the given logical volume.
 /// Return the ID of created/retrievd sensitive detector,
 
-  TG4GeometryServices* geometryServices = TG4GeometryServices::Instance();
-  G4SDManager* pSDManager = G4SDManager::GetSDMpointer();
-
-  G4String lvName = lv->GetName();   
-  G4String sdName = "/" + lvName;
-
-  // cut copy number from sdName
-  sdName = geometryServices->UserVolumeName(sdName);
-  
   // create/retrieve the sensitive detector
-  G4VSensitiveDetector* sd = 0; 
-  sd = pSDManager->FindSensitiveDetector(sdName, false);
-  if (!sd) {
-
-    G4int mediumId = TG4GeometryServices::Instance()->GetMediumId(lv);
-
-    TG4SensitiveDetector* newSD = 0;
+  TG4SensitiveDetector* sd = 0;
+  SDMap::const_iterator it = sdMap.find(sdName);
+  if ( it != sdMap.end() ) {
+    sd = it->second;
+  }
+  else {  
     if ( fIsGflash ) {
-      newSD = new TG4GflashSensitiveDetector(sdName, mediumId);
+      sd = new TG4GflashSensitiveDetector(sdName, mediumId);
     } else {
-      newSD = new TG4SensitiveDetector(sdName, mediumId);
+      sd = new TG4SensitiveDetector(sdName, mediumId);
     }
-    pSDManager->AddNewDetector(newSD);
+    G4SDManager::GetSDMpointer()->AddNewDetector(sd);
+    sdMap[sdName] = sd;
 
     if (VerboseLevel() > 1) {
       G4cout << "Sensitive detector " << sdName 
-             << "  ID="  << newSD->GetID() 
-             << "  medium ID="  << newSD->GetMediumID() 
+             << "  ID="  << sd->GetID() 
+             << "  medium ID="  << sd->GetMediumID() 
              << " has been created." << G4endl;
     }
-                 
-    sd = newSD;  
   }        
   lv->SetSensitiveDetector(sd);             
   
-  return ((TG4SensitiveDetector*)sd)->GetID();
+  return sd->GetID();
 }
 
 //_____________________________________________________________________________
@@ -150,16 +144,40 @@ void TG4SDConstruction::Construct()
   if ( fSelectionFromTGeo && isMaster ) FillSDSelectionFromTGeo();
 
   G4LogicalVolumeStore* lvStore = G4LogicalVolumeStore::GetInstance();
-  
-  for ( G4int i=0; i<G4int(lvStore->size()); i++ ) {
-    G4LogicalVolume* lv = (*lvStore)[i];
-    // Create SD if selection is empty; 
-    // or if volume name is in selection if selection is defined
-    if ( ! fSelection.size() ||
-          fSelection.find(lv->GetName()) != fSelection.end() ) {
-      G4int sdID = CreateSD(lv);
-      if ( isMaster ) TG4SDServices::Instance()->MapVolume(lv, sdID);
+  G4int nofLVs = lvStore->size();
+
+  // The sensitive detector names and media are retrieved only on master
+  // and then shared by workers, as they do not change between threads 
+  if ( isMaster ) {
+    TG4GeometryServices* geometryServices = TG4GeometryServices::Instance();
+    fgSDNames.assign(nofLVs, "");
+    fgMediumIds.assign(nofLVs, 0);
+    for ( G4int i=0; i<nofLVs; i++ ) {
+      G4LogicalVolume* lv = (*lvStore)[i];
+      // Create SD if selection is empty; 
+      // or if volume name is in selection if selection is defined
+      if ( fSelection.size() &&
+           fSelection.find(lv->GetName()) == fSelection.end() ) continue;
+ 
+      // cut copy number from sdName
+      fgSDNames[i] = geometryServices->UserVolumeName("/" + lv->GetName());
+      fgMediumIds[i] = geometryServices->GetMediumId(lv);
     }
+  }
+
+  if ( G4int(fgSDNames.size()) != nofLVs ) {
+    TG4Globals::Exception(
+      "TG4SDConstruction", "Construct", 
+      "The logical volumes store differs from master.");
+  }
+
+  SDMap sdMap;
+  for ( G4int i=0; i<nofLVs; i++ ) {
+    if ( ! fgSDNames[i].size() ) continue;
+
+    G4LogicalVolume* lv = (*lvStore)[i];
+    G4int sdID = CreateSD(lv, fgSDNames[i], fgMediumIds[i], sdMap);
+    if ( isMaster ) TG4SDServices::Instance()->MapVolume(lv, sdID);
   }    
 
   if ( fSelection.size() ) {
@@ -467,6 +467,10 @@ const char* TG4StepManager::CurrentVolOffName(Int_t off) const
 const char* TG4StepManager::CurrentVolPath()
 { 
 /// Return the current volume path.
+/// The Geant4 copy numbers are used, except for the replicas and 
+/// parameterised volumes created by TG4RegularPlacementsConverter, 
+/// which are shifted with the division copy number offset so that
+/// their paths are the same as before the conversion.
 
   TG4GeometryServices* geometryServices = TG4GeometryServices::Instance();
 
@@ -486,7 +490,10 @@ const char* TG4StepManager::CurrentVolPath()
     fNameBuffer
       += geometryServices->UserVolumeName(physVolume->GetName());
     fNameBuffer += "_";
-    TG4Globals::AppendNumberToString(fNameBuffer, physVolume->GetCopyNo());
+    G4int copyNo = physVolume->GetCopyNo();
+    if ( geometryServices->IsConvertedVolume(physVolume) )  
+      copyNo += fDivisionCopyNoOffset;
+    TG4Globals::AppendNumberToString(fNameBuffer, copyNo);
   }     
 
   // Add current volume to the path
@@ -494,7 +501,10 @@ const char* TG4StepManager::CurrentVolPath()
   fNameBuffer += "/";
   fNameBuffer += geometryServices->UserVolumeName(curPhysVolume->GetName());
   fNameBuffer += "_";
-  TG4Globals::AppendNumberToString(fNameBuffer, curPhysVolume->GetCopyNo());
+  G4int copyNo = curPhysVolume->GetCopyNo();
+  if ( geometryServices->IsConvertedVolume(curPhysVolume) )  
+    copyNo += fDivisionCopyNoOffset;
+  TG4Globals::AppendNumberToString(fNameBuffer, copyNo);
 
   return fNameBuffer.data();
 }
@@ -17,12 +17,15 @@
 
 #include "TG4Verbose.h"
 #include "TG4EventActionMessenger.h"
+#include "TG4EventWatchdog.h"
 
 #include <TStopwatch.h>
 
 #include <G4UserEventAction.hh>
 #include <globals.hh>
 
+#include <sstream>
+
 class TG4TrackingAction;
 class TG4TrackManager;
 class TG4StateManager;
@@ -35,6 +38,21 @@ class G4Event;
 /// \ingroup event
 /// \brief Actions at the beginning and the end of event.
 ///
+/// When saving random status for slow events is activated, the random
+/// engine status before the primary particles generation is kept
+/// in a per-thread memory buffer for each event: the Geant4 engine status
+/// is stored by the run manager in G4Event and the Root gRandom status is
+/// captured by BeginOfPrimaryGeneration(). Both are written in files
+/// (slowEvent_runXevtY.rndm, slowEvent_runXevtY.gRandom) only for the events
+/// which exceed the CPU time or the resident memory threshold.
+/// The event can be then re-simulated with TG4RunManager::ReplayEvent(),
+/// which restores both engines from these files before the primary
+/// particles are generated.
+///
+/// When the event watchdog limits are set, the events exceeding them are
+/// aborted (see TG4EventWatchdog); their random status is saved
+/// in a file (abortedEvent_runXevtY.rndm) in the same way as for slow events.
+///
 /// \author I. Hrivnacova; IPN, Orsay
 
 class TG4EventAction : public G4UserEventAction,
@@ -46,16 +64,27 @@ class TG4EventAction : public G4UserEventAction,
     
     // methods
     void LateInitialize();
+    void PrepareNewRun();
+    void BeginOfPrimaryGeneration();
     virtual void BeginOfEventAction(const G4Event* event);
     virtual void EndOfEventAction(const G4Event* event);
 
     // set methods
     void SetPrintMemory(G4bool printMemory);
     void SetSaveRandomStatus(G4bool saveRandomStatus);
+    void SetSaveSlowEventRandomStatus(G4bool saveSlowEventRandomStatus);
+    void SetSlowEventTimeThreshold(G4double timeThreshold);
+    void SetSlowEventMemoryThreshold(G4double memoryThreshold);
+    void SetReplayRandomStatusFile(const G4String& fileName);
     
     // get methods
     G4bool  GetPrintMemory() const;
     G4bool  GetSaveRandomStatus() const;
+    G4bool  GetSaveSlowEventRandomStatus() const;
+    G4double GetSlowEventTimeThreshold() const;
+    G4double GetSlowEventMemoryThreshold() const;
+    G4String GetReplayRandomStatusFile() const;
+    TG4EventWatchdog* GetWatchdog();
 
   private:
     /// Not implemented
@@ -63,9 +92,17 @@ class TG4EventAction : public G4UserEventAction,
     /// Not implemented
     TG4EventAction& operator=(const TG4EventAction& right);
 
+    // methods
+    G4bool IsRandomStatusKept() const;
+    void RestoreRandomStatus();
+    G4String WriteRandomStatus(const G4Event* event, const G4String& prefix);
+    void SaveSlowEventRandomStatus(const G4Event* event, 
+                                   G4double cpuTime, G4double memory);
+
     // data members
     TG4EventActionMessenger   fMessenger; ///< messenger
     TStopwatch  fTimer;          ///< timer
+    G4double    fStartCpuTime;   ///< the thread CPU time at the event start
 
     /// Cached pointer to thread-local VMC application
     TVirtualMCApplication*  fMCApplication;
@@ -87,6 +124,31 @@ class TG4EventAction : public G4UserEventAction,
 
     /// Control for saving random engine status for each event
     G4bool  fSaveRandomStatus;
+
+    /// Control for saving random engine status for slow events
+    G4bool  fSaveSlowEventRandomStatus;
+
+    /// The CPU time threshold (in s) for a slow event (not applied if <= 0)
+    G4double  fSlowEventTimeThreshold;
+
+    /// The resident memory threshold (in MB) for a slow event 
+    /// (not applied if <= 0)
+    G4double  fSlowEventMemoryThreshold;
+
+    /// The in-memory buffer with the random engine status 
+    /// before the primary generation of the current event
+    std::ostringstream  fRandomStatusBuffer;
+
+    /// The in-memory buffer with the streamed Root gRandom status
+    /// before the primary generation of the current event
+    std::string  fRootRandomStatusBuffer;
+
+    /// The file with the random engine status to be restored
+    /// at the beginning of each event (not applied if empty)
+    G4String  fReplayRandomStatusFile;
+
+    /// The event CPU time, number of steps and memory watchdog
+    TG4EventWatchdog  fWatchdog;
 };
 
 // inline methods
@@ -111,6 +173,53 @@ inline void TG4EventAction::SetSaveRandomStatus(G4bool saveRandomStatus) {
   fSaveRandomStatus = saveRandomStatus;
 }
 
+inline void TG4EventAction::SetSaveSlowEventRandomStatus(
+                                G4bool saveSlowEventRandomStatus) {
+  /// Set option for saving random engine status for slow events
+  fSaveSlowEventRandomStatus = saveSlowEventRandomStatus;
+}
+
+inline void TG4EventAction::SetSlowEventTimeThreshold(G4double timeThreshold) {
+  /// Set the CPU time threshold (in s) for a slow event
+  fSlowEventTimeThreshold = timeThreshold;
+}
+
+inline void TG4EventAction::SetSlowEventMemoryThreshold(G4double memoryThreshold) {
+  /// Set the resident memory threshold (in MB) for a slow event
+  fSlowEventMemoryThreshold = memoryThreshold;
+}
+
+inline void TG4EventAction::SetReplayRandomStatusFile(const G4String& fileName) {
+  /// Set the file with the random engine status to be restored
+  /// at the beginning of each event; an empty name switches the restoring off
+  fReplayRandomStatusFile = fileName;
+}
+
+inline G4bool TG4EventAction::GetSaveSlowEventRandomStatus() const {
+  /// Return the option for saving random engine status for slow events
+  return fSaveSlowEventRandomStatus;
+}
+
+inline G4double TG4EventAction::GetSlowEventTimeThreshold() const {
+  /// Return the CPU time threshold (in s) for a slow event
+  return fSlowEventTimeThreshold;
+}
+
+inline G4double TG4EventAction::GetSlowEventMemoryThreshold() const {
+  /// Return the resident memory threshold (in MB) for a slow event
+  return fSlowEventMemoryThreshold;
+}
+
+inline TG4EventWatchdog* TG4EventAction::GetWatchdog() {
+  /// Return the event watchdog
+  return &fWatchdog;
+}
+
+inline G4String TG4EventAction::GetReplayRandomStatusFile() const {
+  /// Return the file with the random engine status to be restored
+  return fReplayRandomStatusFile;
+}
+
 #endif //TG4_EVENT_ACTION_H
 
     
@@ -21,6 +21,9 @@ class TG4EventAction;
 
 class G4UIdirectory;
 class G4UIcmdWithABool;
+class G4UIcmdWithADouble;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithAString;
 
 /// \ingroup event
 /// \brief Messenger class that defines commands for TG4EventAction.
@@ -28,6 +31,13 @@ class G4UIcmdWithABool;
 /// Implements command
 /// - /mcEvent/printMemory [true|false]
 /// - /mcEvent/saveRandom [true|false]
+/// - /mcEvent/saveRandomForSlowEvents [true|false]
+/// - /mcEvent/slowEventTime [value]
+/// - /mcEvent/slowEventMemory [value]
+/// - /mcEvent/replayRandom [fileName|none]
+/// - /mcEvent/maxEventTime [value]
+/// - /mcEvent/maxEventSteps [value]
+/// - /mcEvent/maxEventMemory [value]
 ///
 /// \author I. Hrivnacova; IPN, Orsay
 
@@ -54,6 +64,27 @@ class TG4EventActionMessenger: public G4UImessenger
     G4UIdirectory*         fEventDirectory; ///< command directory
     G4UIcmdWithABool*      fPrintMemoryCmd; ///< command: printMemory
     G4UIcmdWithABool*      fSaveRandomStatusCmd; ///< command: saveRandom
+
+    /// command: saveRandomForSlowEvents
+    G4UIcmdWithABool*      fSaveSlowEventRandomStatusCmd;
+
+    /// command: slowEventTime
+    G4UIcmdWithADouble*    fSlowEventTimeThresholdCmd;
+
+    /// command: slowEventMemory
+    G4UIcmdWithADouble*    fSlowEventMemoryThresholdCmd;
+
+    /// command: replayRandom
+    G4UIcmdWithAString*    fReplayRandomStatusCmd;
+
+    /// command: maxEventTime
+    G4UIcmdWithADouble*    fMaxEventTimeCmd;
+
+    /// command: maxEventSteps
+    G4UIcmdWithAnInteger*  fMaxEventStepsCmd;
+
+    /// command: maxEventMemory
+    G4UIcmdWithADouble*    fMaxEventMemoryCmd;
 };
 
 #endif //TG4_EVENT_ACTION_MESSENGER_H
@@ -0,0 +1,161 @@
+#ifndef TG4_EVENT_WATCHDOG_H
+#define TG4_EVENT_WATCHDOG_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2017 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4EventWatchdog.h
+/// \brief Definition of the TG4EventWatchdog class 
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include <globals.hh>
+
+#include <map>
+
+class G4Step;
+class G4LogicalVolume;
+class G4ParticleDefinition;
+
+/// \ingroup event
+/// \brief The per-thread watchdog of the event CPU time, number of steps
+/// and resident memory
+///
+/// The watchdog is owned by TG4EventAction and it is notified about
+/// each step by TG4SteppingAction. The number of steps is checked at each 
+/// step, the thread CPU time every kCheckInterval steps and the growth
+/// of the resident memory (of the whole process) since the event start
+/// every kMemoryCheckInterval steps.
+/// When a limit is exceeded, the event is aborted via 
+/// G4RunManager::AbortEvent() and the run continues with the next event.
+/// The volumes and particles of every kCheckInterval-th step are counted
+/// so that the hottest ones can be reported for the aborted event.
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+class TG4EventWatchdog
+{
+  enum {
+    kCheckInterval = 100,
+    kMemoryCheckInterval = 10000,
+    kNofReported = 5
+  };
+
+  public:
+    TG4EventWatchdog();
+    virtual ~TG4EventWatchdog();
+
+    // methods
+    void StartEvent();
+    void Step(const G4Step* step);
+    void PrintReport(G4int eventId) const;
+    
+    // set methods
+    void SetMaxCpuTime(G4double maxCpuTime);
+    void SetMaxNofSteps(G4int maxNofSteps);
+    void SetMaxMemory(G4double maxMemory);
+
+    // get methods
+    G4double GetMaxCpuTime() const;
+    G4int    GetMaxNofSteps() const;
+    G4double GetMaxMemory() const;
+    G4bool   IsActive() const;
+    G4bool   IsEventAborted() const;
+    G4int    GetNofAbortedEvents() const;
+
+  private:
+    /// Not implemented
+    TG4EventWatchdog(const TG4EventWatchdog& right);
+    /// Not implemented
+    TG4EventWatchdog& operator=(const TG4EventWatchdog& right);
+
+    // static methods
+    static G4double GetResidentMemory();
+
+    // methods
+    void CheckLimits(const G4Step* step);
+    void AbortEvent(const G4String& reason);
+
+    // data members
+    G4double  fMaxCpuTime;   ///< the event CPU time limit (in s)
+    G4int     fMaxNofSteps;  ///< the event number of steps limit
+    G4double  fMaxMemory;    ///< the event resident memory growth limit (in MB)
+
+    G4double  fStartCpuTime; ///< the thread CPU time at the event start
+    G4double  fStartMemory;  ///< the resident memory at the event start
+    G4double  fCpuTime;      ///< the event CPU time at the last check
+    G4double  fMemory;       ///< the resident memory growth at the last check
+    G4int     fNofSteps;     ///< the number of steps in the event
+    G4bool    fIsAborted;    ///< info whether the event was aborted
+    G4String  fReason;       ///< the reason of the event abort
+    G4int     fNofAborted;   ///< the number of aborted events
+
+    /// The sampled numbers of steps per volume
+    std::map<const G4LogicalVolume*, G4int>       fVolumeSteps;
+
+    /// The sampled numbers of steps per particle
+    std::map<const G4ParticleDefinition*, G4int>  fParticleSteps;
+};
+
+// inline methods
+
+inline void TG4EventWatchdog::SetMaxCpuTime(G4double maxCpuTime) {
+  /// Set the event CPU time limit (in s); not applied if <= 0
+  fMaxCpuTime = maxCpuTime;
+}
+
+inline void TG4EventWatchdog::SetMaxNofSteps(G4int maxNofSteps) {
+  /// Set the event number of steps limit; not applied if <= 0
+  fMaxNofSteps = maxNofSteps;
+}
+
+inline void TG4EventWatchdog::SetMaxMemory(G4double maxMemory) {
+  /// Set the event resident memory growth limit (in MB); not applied if <= 0
+  fMaxMemory = maxMemory;
+}
+
+inline G4double TG4EventWatchdog::GetMaxCpuTime() const {
+  /// Return the event CPU time limit (in s)
+  return fMaxCpuTime;
+}
+
+inline G4int TG4EventWatchdog::GetMaxNofSteps() const {
+  /// Return the event number of steps limit
+  return fMaxNofSteps;
+}
+
+inline G4double TG4EventWatchdog::GetMaxMemory() const {
+  /// Return the event resident memory growth limit (in MB)
+  return fMaxMemory;
+}
+
+inline G4bool TG4EventWatchdog::IsActive() const {
+  /// Return true if any limit is set
+  return fMaxCpuTime > 0. || fMaxNofSteps > 0 || fMaxMemory > 0.;
+}
+
+inline G4bool TG4EventWatchdog::IsEventAborted() const {
+  /// Return true if the current event was aborted by the watchdog
+  return fIsAborted;
+}
+
+inline G4int TG4EventWatchdog::GetNofAbortedEvents() const {
+  /// Return the number of events aborted by the watchdog
+  return fNofAborted;
+}
+
+inline void TG4EventWatchdog::Step(const G4Step* step) {
+  /// Count the step and check the limits
+  if ( fIsAborted ) return;
+  ++fNofSteps;
+  if ( ( fMaxNofSteps > 0 && fNofSteps > fMaxNofSteps ) ||
+       fNofSteps % kCheckInterval == 0 ) CheckLimits(step);
+}
+
+#endif //TG4_EVENT_WATCHDOG_H
@@ -26,6 +26,7 @@ class TG4SpecialControlsV2;
 class TG4TrackManager;
 class TG4StepManager;
 class TG4StackPopper;
+class TG4EventWatchdog;
 
 class TVirtualMCApplication;
 
@@ -40,6 +41,8 @@ class G4Step;
 /// It also enables to define a maximum number of steps
 /// and takes care of stopping of a track when this number
 /// is reached.
+/// Each step is also passed to the event watchdog of TG4EventAction,
+/// if its limits are set.
 ///
 /// \author I. Hrivnacova; IPN, Orsay
 
@@ -120,6 +123,9 @@ class TG4SteppingAction : public G4UserSteppingAction
     /// Cached pointer to thread-local stack popper
     TG4StackPopper* fStackPopper;
 
+    /// Cached pointer to thread-local event watchdog
+    TG4EventWatchdog* fWatchdog;
+
     /// max number of allowed steps
     G4int  fMaxNofSteps;
     
@@ -24,27 +24,41 @@
 #include <G4Trajectory.hh>
 #include <G4VVisManager.hh>
 #include <G4UImanager.hh>
+#include <G4RunManager.hh>
+#include <G4Run.hh>
 #include <Randomize.hh>
 
 #include <TVirtualMC.h>
 #include <TVirtualMCStack.h>
 #include <TVirtualMCApplication.h>
 #include <TSystem.h>
+#include <TRandom.h>
+#include <TBufferFile.h>
 
 #include <math.h>
+#include <fstream>
+#include <iterator>
 
 //_____________________________________________________________________________
 TG4EventAction::TG4EventAction()
   : TG4Verbose("eventAction"),
     fMessenger(this),
     fTimer(),
+    fStartCpuTime(0.),
     fMCApplication(0),
     fMCStack(0),
     fTrackingAction(0),
     fTrackManager(0),
     fStateManager(0),
     fPrintMemory(false),
-    fSaveRandomStatus(false)
+    fSaveRandomStatus(false),
+    fSaveSlowEventRandomStatus(false),
+    fSlowEventTimeThreshold(0.),
+    fSlowEventMemoryThreshold(0.),
+    fRandomStatusBuffer(),
+    fRootRandomStatusBuffer(),
+    fReplayRandomStatusFile(),
+    fWatchdog()
 {
 /// Default constructor
 }
@@ -55,6 +69,116 @@ TG4EventAction::~TG4EventAction()
 /// Destructor
 }
 
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+G4bool TG4EventAction::IsRandomStatusKept() const
+{
+/// Return true if the random status of each event has to be kept in memory
+
+  return fSaveSlowEventRandomStatus || fWatchdog.IsActive();
+}
+
+//_____________________________________________________________________________
+void TG4EventAction::RestoreRandomStatus()
+{
+/// Restore the Geant4 random engine status from the replay file and 
+/// the Root gRandom status from the file with the same name and
+/// the .gRandom extension, if present
+
+  std::ifstream input(fReplayRandomStatusFile.data());
+  if ( ! input ) {
+    TG4Globals::Exception(
+      "TG4EventAction", "RestoreRandomStatus",
+      "Cannot open random status file " + TString(fReplayRandomStatusFile));
+    return;
+  }
+
+  CLHEP::HepRandom::restoreFullState(input);
+
+  if (VerboseLevel() > 0) {
+    G4cout << "Restored random status from " 
+           << fReplayRandomStatusFile << G4endl;
+  }
+
+  G4String rootFileName = fReplayRandomStatusFile;
+  if ( rootFileName.size() > 5 && 
+       rootFileName.substr(rootFileName.size() - 5) == ".rndm" ) {
+    rootFileName = rootFileName.substr(0, rootFileName.size() - 5);
+  }
+  rootFileName += ".gRandom";
+
+  std::ifstream rootInput(rootFileName.data(), std::ios::binary);
+  if ( ! rootInput || ! gRandom ) return;
+
+  std::string status((std::istreambuf_iterator<char>(rootInput)),
+                      std::istreambuf_iterator<char>());
+  TBufferFile buffer(TBuffer::kRead, status.size(), 
+                     const_cast<char*>(status.data()), kFALSE);
+  gRandom->Streamer(buffer);
+
+  if (VerboseLevel() > 0) {
+    G4cout << "Restored Root random status from " 
+           << rootFileName << G4endl;
+  }
+}
+
+//_____________________________________________________________________________
+G4String TG4EventAction::WriteRandomStatus(const G4Event* /*event*/,
+                                           const G4String& prefix)
+{
+/// Write the random engine status captured before the primary generation
+/// in the file prefix_runXevtY.rndm and the Root gRandom status
+/// in the file prefix_runXevtY.gRandom and return the first file name.
+/// The event number is taken from TVirtualMC::CurrentEvent() so that
+/// the names are unique also in forked processes.
+
+  G4int runID = 0;
+  const G4Run* run = G4RunManager::GetRunManager()->GetCurrentRun();
+  if ( run ) runID = run->GetRunID();
+
+  G4String fileName = prefix + "_run";
+  TG4Globals::AppendNumberToString(fileName, runID);
+  fileName += "evt";
+  TG4Globals::AppendNumberToString(fileName, gMC->CurrentEvent());
+
+  std::ofstream output((fileName + ".rndm").data());
+  output << fRandomStatusBuffer.str();
+  output.close();
+
+  if ( fRootRandomStatusBuffer.size() ) {
+    std::ofstream rootOutput((fileName + ".gRandom").data(), std::ios::binary);
+    rootOutput.write(fRootRandomStatusBuffer.data(), 
+                     fRootRandomStatusBuffer.size());
+    rootOutput.close();
+  }
+
+  return fileName + ".rndm";
+}
+
+//_____________________________________________________________________________
+void TG4EventAction::SaveSlowEventRandomStatus(const G4Event* event,
+                                               G4double cpuTime,
+                                               G4double memory)
+{
+/// Write the random engine status captured before the primary generation
+/// in a file if the event exceeded the CPU time or memory threshold.
+
+  G4bool isSlow 
+    = ( fSlowEventTimeThreshold > 0. && cpuTime > fSlowEventTimeThreshold ) ||
+      ( fSlowEventMemoryThreshold > 0. && memory > fSlowEventMemoryThreshold );
+  if ( ! isSlow ) return;
+
+  G4String fileName = WriteRandomStatus(event, "slowEvent");
+
+  G4cout << "Event " << event->GetEventID() << " exceeded slow event threshold"
+         << " (CPU time " << cpuTime << " s, resident memory " 
+         << memory << " MB)," << G4endl
+         << "  its random status was saved in " << fileName << G4endl;
+}
+
 //
 // public methods
 //
@@ -71,6 +195,41 @@ void TG4EventAction::LateInitialize()
   fStateManager = TG4StateManager::Instance();
 }
 
+//_____________________________________________________________________________
+void TG4EventAction::PrepareNewRun()
+{
+/// Let the run manager store the random engine status before the primary
+/// generation in G4Event if the random status of each event has to be kept.
+/// Called from TG4RunAction::BeginOfRunAction() on each thread.
+
+  if ( ! IsRandomStatusKept() ) return;
+
+  G4RunManager* runManager = G4RunManager::GetRunManager();
+  G4int flag = runManager->GetFlagRandomNumberStatusToG4Event();
+  if ( flag == 0 || flag == 2 ) {
+    runManager->StoreRandomNumberStatusToG4Event(flag + 1);
+  }
+}
+
+//_____________________________________________________________________________
+void TG4EventAction::BeginOfPrimaryGeneration()
+{
+/// Called by TG4PrimaryGeneratorAction before the primary particles are
+/// generated: restore the random status if replaying an event and keep
+/// the Root gRandom status in memory.
+
+  // restore the random number status if replaying an event
+  if ( fReplayRandomStatusFile.size() ) RestoreRandomStatus();
+
+  // keep the Root random number status in memory;
+  // the Geant4 engine status is kept in G4Event by the run manager 
+  if ( IsRandomStatusKept() && gRandom ) {
+    TBufferFile buffer(TBuffer::kWrite);
+    gRandom->Streamer(buffer);
+    fRootRandomStatusBuffer.assign(buffer.Buffer(), buffer.Length());
+  }
+}
+
 //_____________________________________________________________________________
 void TG4EventAction::BeginOfEventAction(const G4Event* event)
 {
@@ -103,10 +262,32 @@ void TG4EventAction::BeginOfEventAction(const G4Event* event)
       G4cout << G4endl;  
   }    
 
+  // keep the event random number status stored before the primary
+  // generation in memory
+  if ( IsRandomStatusKept() ) {
+    fRandomStatusBuffer.str("");
+    G4int flag 
+      = G4RunManager::GetRunManager()->GetFlagRandomNumberStatusToG4Event();
+    if ( flag == 1 || flag == 3 ) {
+      fRandomStatusBuffer << event->GetRandomNumberStatus();
+    }  
+  }
+
+  // reset the watchdog counters
+  fWatchdog.StartEvent();
+
   if (VerboseLevel() > 0) {
     G4cout << ">>> Event " << event->GetEventID() << G4endl;
+  }  
+
+  if ( VerboseLevel() > 0 ) {
     fTimer.Start();
   }  
+
+  // the thread CPU time, as the process CPU time includes all threads in MT
+  if ( fSaveSlowEventRandomStatus ) {
+    fStartCpuTime = TG4Globals::GetThreadCpuTime();
+  }
 }
 
 //_____________________________________________________________________________
@@ -136,6 +317,13 @@ void TG4EventAction::EndOfEventAction(const G4Event* event)
                   " all tracks processed." << G4endl;
   }               
 
+  // report the event aborted by the watchdog
+  if ( fWatchdog.IsEventAborted() ) {
+    fWatchdog.PrintReport(event->GetEventID());
+    G4cout << "  its random status was saved in " 
+           << WriteRandomStatus(event, "abortedEvent") << G4endl;
+  }
+
   // VMC application finish event
   fMCApplication->FinishEvent();
   fStateManager->SetNewState(kNotInApplication);
@@ -146,10 +334,20 @@ void TG4EventAction::EndOfEventAction(const G4Event* event)
     fTimer.Print();
   }  
 
-  if ( fPrintMemory ) {
-    ProcInfo_t procInfo;
+  ProcInfo_t procInfo;
+  if ( fPrintMemory || fSaveSlowEventRandomStatus ) {
     gSystem->GetProcInfo(&procInfo);
+  }
+
+  if ( fPrintMemory ) {
     G4cout << "Current memory usage: resident " 
            << procInfo.fMemResident << ", virtual " << procInfo.fMemVirtual << G4endl;
   }         
+
+  if ( fSaveSlowEventRandomStatus ) {
+    // ProcInfo_t memory is given in kB
+    SaveSlowEventRandomStatus(
+      event, TG4Globals::GetThreadCpuTime() - fStartCpuTime,
+      procInfo.fMemResident/1024.);
+  }
 }
@@ -18,6 +18,9 @@
 
 #include <G4UIdirectory.hh>
 #include <G4UIcmdWithABool.hh>
+#include <G4UIcmdWithADouble.hh>
+#include <G4UIcmdWithAString.hh>
+#include <G4UIcmdWithAnInteger.hh>
 
 //_____________________________________________________________________________
 TG4EventActionMessenger::TG4EventActionMessenger(TG4EventAction* eventAction)
@@ -25,7 +28,14 @@ TG4EventActionMessenger::TG4EventActionMessenger(TG4EventAction* eventAction)
     fEventAction(eventAction),
     fEventDirectory(0),
     fPrintMemoryCmd(0), 
-    fSaveRandomStatusCmd(0)
+    fSaveRandomStatusCmd(0),
+    fSaveSlowEventRandomStatusCmd(0),
+    fSlowEventTimeThresholdCmd(0),
+    fSlowEventMemoryThresholdCmd(0),
+    fReplayRandomStatusCmd(0),
+    fMaxEventTimeCmd(0),
+    fMaxEventStepsCmd(0),
+    fMaxEventMemoryCmd(0)
 { 
 /// Standard constructor
 
@@ -41,6 +51,67 @@ TG4EventActionMessenger::TG4EventActionMessenger(TG4EventAction* eventAction)
   fSaveRandomStatusCmd->SetGuidance("Save random engine status for each event");
   fSaveRandomStatusCmd->SetParameterName("SaveRandom", false);
   fSaveRandomStatusCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fSaveSlowEventRandomStatusCmd 
+    = new G4UIcmdWithABool("/mcEvent/saveRandomForSlowEvents", this);
+  fSaveSlowEventRandomStatusCmd
+    ->SetGuidance("Keep random engine status for each event in memory and save it");
+  fSaveSlowEventRandomStatusCmd
+    ->SetGuidance("in a file only for events exceeding the slow event thresholds");
+  fSaveSlowEventRandomStatusCmd->SetParameterName("SaveRandomForSlowEvents", false);
+  fSaveSlowEventRandomStatusCmd
+    ->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fSlowEventTimeThresholdCmd 
+    = new G4UIcmdWithADouble("/mcEvent/slowEventTime", this);
+  fSlowEventTimeThresholdCmd
+    ->SetGuidance("Set the event CPU time threshold (in s) for a slow event");
+  fSlowEventTimeThresholdCmd->SetGuidance("(the threshold is not applied if <= 0)");
+  fSlowEventTimeThresholdCmd->SetParameterName("SlowEventTime", false);
+  fSlowEventTimeThresholdCmd
+    ->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fSlowEventMemoryThresholdCmd 
+    = new G4UIcmdWithADouble("/mcEvent/slowEventMemory", this);
+  fSlowEventMemoryThresholdCmd
+    ->SetGuidance("Set the resident memory threshold (in MB) for a slow event");
+  fSlowEventMemoryThresholdCmd->SetGuidance("(the threshold is not applied if <= 0)");
+  fSlowEventMemoryThresholdCmd->SetParameterName("SlowEventMemory", false);
+  fSlowEventMemoryThresholdCmd
+    ->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fReplayRandomStatusCmd = new G4UIcmdWithAString("/mcEvent/replayRandom", this);
+  fReplayRandomStatusCmd
+    ->SetGuidance("Restore random engine status from the given file");
+  fReplayRandomStatusCmd
+    ->SetGuidance("before generating primaries of each event; \"none\" switches it off");
+  fReplayRandomStatusCmd->SetParameterName("ReplayRandom", false);
+  fReplayRandomStatusCmd
+    ->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fMaxEventTimeCmd = new G4UIcmdWithADouble("/mcEvent/maxEventTime", this);
+  fMaxEventTimeCmd
+    ->SetGuidance("Set the event CPU time limit (in s); the events exceeding");
+  fMaxEventTimeCmd->SetGuidance("it are aborted (the limit is not applied if <= 0)");
+  fMaxEventTimeCmd->SetParameterName("MaxEventTime", false);
+  fMaxEventTimeCmd
+    ->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fMaxEventStepsCmd = new G4UIcmdWithAnInteger("/mcEvent/maxEventSteps", this);
+  fMaxEventStepsCmd
+    ->SetGuidance("Set the event number of steps limit; the events exceeding");
+  fMaxEventStepsCmd->SetGuidance("it are aborted (the limit is not applied if <= 0)");
+  fMaxEventStepsCmd->SetParameterName("MaxEventSteps", false);
+  fMaxEventStepsCmd
+    ->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
+
+  fMaxEventMemoryCmd = new G4UIcmdWithADouble("/mcEvent/maxEventMemory", this);
+  fMaxEventMemoryCmd
+    ->SetGuidance("Set the event resident memory growth limit (in MB); the events exceeding");
+  fMaxEventMemoryCmd->SetGuidance("it are aborted (the limit is not applied if <= 0)");
+  fMaxEventMemoryCmd->SetParameterName("MaxEventMemory", false);
+  fMaxEventMemoryCmd
+    ->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
 }
 
 //_____________________________________________________________________________
@@ -51,6 +122,13 @@ TG4EventActionMessenger::~TG4EventActionMessenger()
   delete fEventDirectory;
   delete fPrintMemoryCmd;
   delete fSaveRandomStatusCmd;
+  delete fSaveSlowEventRandomStatusCmd;
+  delete fSlowEventTimeThresholdCmd;
+  delete fSlowEventMemoryThresholdCmd;
+  delete fReplayRandomStatusCmd;
+  delete fMaxEventTimeCmd;
+  delete fMaxEventStepsCmd;
+  delete fMaxEventMemoryCmd;
 }
 
 //
@@ -71,4 +149,39 @@ void TG4EventActionMessenger::SetNewValue(G4UIcommand* command,
   { 
     fEventAction->SetSaveRandomStatus(fSaveRandomStatusCmd->GetNewBoolValue(newValue)); 
   }   
+  else if ( command == fSaveSlowEventRandomStatusCmd )
+  { 
+    fEventAction->SetSaveSlowEventRandomStatus(
+      fSaveSlowEventRandomStatusCmd->GetNewBoolValue(newValue)); 
+  }   
+  else if ( command == fSlowEventTimeThresholdCmd )
+  { 
+    fEventAction->SetSlowEventTimeThreshold(
+      fSlowEventTimeThresholdCmd->GetNewDoubleValue(newValue)); 
+  }   
+  else if ( command == fSlowEventMemoryThresholdCmd )
+  { 
+    fEventAction->SetSlowEventMemoryThreshold(
+      fSlowEventMemoryThresholdCmd->GetNewDoubleValue(newValue)); 
+  }   
+  else if ( command == fReplayRandomStatusCmd )
+  { 
+    if ( newValue == "none" ) newValue = "";
+    fEventAction->SetReplayRandomStatusFile(newValue); 
+  }   
+  else if ( command == fMaxEventTimeCmd )
+  { 
+    fEventAction->GetWatchdog()->SetMaxCpuTime(
+      fMaxEventTimeCmd->GetNewDoubleValue(newValue)); 
+  }   
+  else if ( command == fMaxEventStepsCmd )
+  { 
+    fEventAction->GetWatchdog()->SetMaxNofSteps(
+      fMaxEventStepsCmd->GetNewIntValue(newValue)); 
+  }   
+  else if ( command == fMaxEventMemoryCmd )
+  { 
+    fEventAction->GetWatchdog()->SetMaxMemory(
+      fMaxEventMemoryCmd->GetNewDoubleValue(newValue)); 
+  }   
 }
@@ -0,0 +1,204 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2017 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4EventWatchdog.cxx
+/// \brief Implementation of the TG4EventWatchdog class 
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include "TG4EventWatchdog.h"
+#include "TG4Globals.h"
+
+#include <G4Step.hh>
+#include <G4Track.hh>
+#include <G4LogicalVolume.hh>
+#include <G4ParticleDefinition.hh>
+#include <G4RunManager.hh>
+
+#include <TSystem.h>
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+G4String GetName(const G4LogicalVolume* volume) 
+{
+  return volume->GetName();
+}
+
+G4String GetName(const G4ParticleDefinition* particle) 
+{
+  return particle->GetParticleName();
+}
+
+template <typename T>
+void PrintHottest(const std::map<const T*, G4int>& steps, 
+                  const G4String& title, G4int nofReported)
+{
+  // Print the objects with the highest numbers of sampled steps
+
+  std::vector< std::pair<G4int, const T*> > sorted;
+  G4int total = 0;
+  typename std::map<const T*, G4int>::const_iterator it;
+  for ( it = steps.begin(); it != steps.end(); ++it ) {
+    sorted.push_back(std::pair<G4int, const T*>(it->second, it->first));
+    total += it->second;
+  }
+  if ( ! total ) return;
+
+  std::sort(sorted.rbegin(), sorted.rend());
+
+  G4cout << "  Hottest " << title << " (fraction of sampled steps):" << G4endl;
+  for ( G4int i = 0; i < G4int(sorted.size()) && i < nofReported; ++i ) {
+    G4cout << "    " << GetName(sorted[i].second) << "  " 
+           << double(sorted[i].first)/total << G4endl;
+  }
+}
+
+}
+
+//_____________________________________________________________________________
+TG4EventWatchdog::TG4EventWatchdog()
+  : fMaxCpuTime(0.),
+    fMaxNofSteps(0),
+    fMaxMemory(0.),
+    fStartCpuTime(0.),
+    fStartMemory(0.),
+    fCpuTime(0.),
+    fMemory(0.),
+    fNofSteps(0),
+    fIsAborted(false),
+    fReason(),
+    fNofAborted(0),
+    fVolumeSteps(),
+    fParticleSteps()
+{
+/// Default constructor
+}
+
+//_____________________________________________________________________________
+TG4EventWatchdog::~TG4EventWatchdog() 
+{
+/// Destructor
+}
+
+//
+// private static methods
+//
+
+//_____________________________________________________________________________
+G4double TG4EventWatchdog::GetResidentMemory()
+{
+/// Return the resident memory (in MB) of the process
+
+  ProcInfo_t procInfo;
+  gSystem->GetProcInfo(&procInfo);
+
+  // ProcInfo_t memory is given in kB
+  return procInfo.fMemResident/1024.;
+}
+
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+void TG4EventWatchdog::CheckLimits(const G4Step* step)
+{
+/// Sample the step volume and particle and check the limits
+
+  const G4Track* track = step->GetTrack();
+  if ( track->GetVolume() ) {
+    ++fVolumeSteps[track->GetVolume()->GetLogicalVolume()];
+  }  
+  ++fParticleSteps[track->GetDefinition()];
+
+  if ( fMaxNofSteps > 0 && fNofSteps > fMaxNofSteps ) {
+    std::ostringstream reason;
+    reason << "number of steps exceeded " << fMaxNofSteps;
+    AbortEvent(reason.str());
+    return;
+  }
+
+  if ( fMaxCpuTime > 0. ) {
+    fCpuTime = TG4Globals::GetThreadCpuTime() - fStartCpuTime;
+    if ( fCpuTime > fMaxCpuTime ) {
+      std::ostringstream reason;
+      reason << "CPU time exceeded " << fMaxCpuTime << " s";
+      AbortEvent(reason.str());
+      return;
+    }
+  }  
+
+  if ( fMaxMemory > 0. && fNofSteps % kMemoryCheckInterval == 0 ) {
+    fMemory = GetResidentMemory() - fStartMemory;
+    if ( fMemory > fMaxMemory ) {
+      std::ostringstream reason;
+      reason << "resident memory growth exceeded " << fMaxMemory << " MB";
+      AbortEvent(reason.str());
+      return;
+    }
+  }  
+}
+
+//_____________________________________________________________________________
+void TG4EventWatchdog::AbortEvent(const G4String& reason)
+{
+/// Abort the current event; the track is killed and the stacked tracks
+/// are cleared by the Geant4 event manager, the end of event actions
+/// are still called.
+
+  fIsAborted = true;
+  fReason = reason;
+  ++fNofAborted;
+  fCpuTime = TG4Globals::GetThreadCpuTime() - fStartCpuTime;
+
+  G4RunManager::GetRunManager()->AbortEvent();
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+void TG4EventWatchdog::StartEvent()
+{
+/// Reset the event counters
+
+  fStartCpuTime = TG4Globals::GetThreadCpuTime();
+  fStartMemory = ( fMaxMemory > 0. ) ? GetResidentMemory() : 0.;
+  fCpuTime = 0.;
+  fMemory = 0.;
+  fNofSteps = 0;
+  fIsAborted = false;
+  fReason = "";
+  fVolumeSteps.clear();
+  fParticleSteps.clear();
+}
+
+//_____________________________________________________________________________
+void TG4EventWatchdog::PrintReport(G4int eventId) const
+{
+/// Print the reason of the event abort and the hottest volumes
+/// and particles
+
+  G4cout << "*** Event " << eventId << " aborted by watchdog: " 
+         << fReason << " ***" << G4endl
+         << "  CPU time " << fCpuTime << " s, " 
+         << fNofSteps << " steps";
+  if ( fMaxMemory > 0. ) {
+    G4cout << ", resident memory growth " << fMemory << " MB";
+  }
+  G4cout << G4endl;
+
+  PrintHottest(fVolumeSteps, "volumes", kNofReported);
+  PrintHottest(fParticleSteps, "particles", kNofReported);
+}
@@ -21,12 +21,15 @@
 #include "TG4SpecialControlsV2.h"
 #include "TG4SDServices.h"
 #include "TG4StackPopper.h"
+#include "TG4EventAction.h"
+#include "TG4EventWatchdog.h"
 #include "TG4Limits.h"
 #include "TG4G3Units.h"
 #include "TG4Globals.h"
 
 #include <G4Track.hh>
 #include <G4SteppingManager.hh>
+#include <G4RunManager.hh>
 
 #include <TVirtualMCApplication.h>
 
@@ -43,6 +46,7 @@ TG4SteppingAction::TG4SteppingAction()
     fTrackManager(0),
     fStepManager(0),
     fStackPopper(0),
+    fWatchdog(0),
     fMaxNofSteps(kMaxNofSteps),
     fStandardVerboseLevel(-1),
     fLoopVerboseLevel(1),
@@ -283,6 +287,12 @@ void TG4SteppingAction::LateInitialize()
   fTrackManager = TG4TrackManager::Instance();
   fStepManager = TG4StepManager::Instance();
   fStackPopper = TG4StackPopper::Instance();
+
+  TG4EventAction* eventAction
+    = dynamic_cast<TG4EventAction*>(
+        const_cast<G4UserEventAction*>(
+          G4RunManager::GetRunManager()->GetUserEventAction()));
+  if ( eventAction ) fWatchdog = eventAction->GetWatchdog();
 }
 
 #include "TGeoVolume.h"
@@ -299,6 +309,9 @@ void TG4SteppingAction::UserSteppingAction(const G4Step* step)
   // stop track if maximum number of steps has been reached
   ProcessTrackIfLooping(step);  
 
+  // check the event limits
+  if ( fWatchdog && fWatchdog->IsActive() ) fWatchdog->Step(step);
+
 /*
   // TO BE REMOVED   
   G4LogicalVolume* currLV 
@@ -25,6 +25,7 @@ class G4UIcommand;
 class G4UIdirectory;
 class G4UIcmdWithoutParameter;
 class G4UIcmdWithABool;
+class G4UIcmdWithAnInteger;
 class G4UIcmdWithAString;
 class G4UIcmdWithADoubleAndUnit;
 
@@ -46,6 +47,14 @@ class G4UIcmdWithADoubleAndUnit;
 /// - /mcDet/setIsMaxStepInLowDensityMaterials true|false
 /// - /mcDet/setMaxStepInLowDensityMaterials value
 /// - /mcDet/setLimitDensity value
+/// - /mcDet/setGeometryCacheDir dirName - for geomRootToGeant4 only
+/// - /mcDet/convertRegularPlacements true|false - for geomRootToGeant4 only
+/// - /mcDet/checkOverlaps true|false
+/// - /mcDet/setOverlapsResolution nofPoints
+/// - /mcDet/setOverlapsTolerance value
+/// - /mcDet/setOverlapsNofThreads nofThreads
+/// - /mcDet/setOverlapsReport fileName
+/// - /mcDet/setOverlapsCacheDir dirName
 /// - /mcDet/setNewRadiator volumeName xtrModel foilNumber
 /// - /mcDet/setRadiatorLayer materialName thickness [fluctuation]
 /// - /mcDet/setRadiatorStrawTube gasMaterialName wallThickness gassThickness
@@ -129,6 +138,30 @@ class TG4DetConstructionMessenger: public G4UImessenger
     /// command: setMaxStepInLowDensityMaterials
     G4UIcmdWithADoubleAndUnit*  fSetMaxStepInLowDensityMaterialsCmd;
 
+    /// command: setGeometryCacheDir
+    G4UIcmdWithAString*         fSetGeometryCacheDirCmd;
+
+    /// command: convertRegularPlacements
+    G4UIcmdWithABool*           fConvertRegularPlacementsCmd;
+
+    /// command: checkOverlaps
+    G4UIcmdWithABool*           fCheckOverlapsCmd;
+
+    /// command: setOverlapsResolution
+    G4UIcmdWithAnInteger*       fSetOverlapsResolutionCmd;
+
+    /// command: setOverlapsTolerance
+    G4UIcmdWithADoubleAndUnit*  fSetOverlapsToleranceCmd;
+
+    /// command: setOverlapsNofThreads
+    G4UIcmdWithAnInteger*       fSetOverlapsNofThreadsCmd;
+
+    /// command: setOverlapsReport
+    G4UIcmdWithAString*         fSetOverlapsReportCmd;
+
+    /// command: setOverlapsCacheDir
+    G4UIcmdWithAString*         fSetOverlapsCacheDirCmd;
+
     /// command: setNewRadiator
     G4UIcommand*                fSetNewRadiatorCmd;
 
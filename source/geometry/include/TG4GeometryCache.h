@@ -0,0 +1,89 @@
+#ifndef TG4_GEOMETRY_CACHE_H
+#define TG4_GEOMETRY_CACHE_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2015 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4GeometryCache.h
+/// \brief Definition of the TG4GeometryCache class
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include <globals.hh>
+
+class G4VPhysicalVolume;
+
+/// \ingroup geometry
+/// \brief The on-disk cache of the Geant4 geometry converted from Root
+///
+/// The Geant4 geometry converted from the Root geometry via VGM is saved
+/// in a GDML file in the cache directory. The file name contains a hash
+/// of the Root geometry (materials, media, shapes, volumes and their
+/// placements), so that the cached geometry is loaded instead of
+/// the conversion only if the Root geometry has not changed.
+///
+/// The cache is activated by setting the cache directory via
+/// /mcDet/setGeometryCacheDir; it requires Geant4 VMC built with
+/// the Geant4 GDML library (Geant4VMC_USE_GEANT4_GDML option).
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+class TG4GeometryCache
+{
+  public:
+    TG4GeometryCache();
+    virtual ~TG4GeometryCache();
+
+    // methods
+    G4VPhysicalVolume* Load(G4int verboseLevel);
+    void Save(G4VPhysicalVolume* world, G4int verboseLevel);
+
+    // set methods
+    void SetDirectory(const G4String& directory);
+
+    // get methods
+    G4String GetDirectory() const;
+    G4bool   IsActive() const;
+
+  private:
+    /// Not implemented
+    TG4GeometryCache(const TG4GeometryCache& right);
+    /// Not implemented
+    TG4GeometryCache& operator=(const TG4GeometryCache& right);
+
+    // methods
+    G4String ComputeHash() const;
+    G4String GetFileName();
+
+    // static data members
+    static const G4String  fgkFilePrefix; ///< the cache file name prefix
+
+    // data members
+    G4String  fDirectory; ///< the cache directory
+    G4String  fHash;      ///< the Root geometry hash
+};
+
+// inline methods
+
+inline void TG4GeometryCache::SetDirectory(const G4String& directory) {
+  /// Set the cache directory; the cache is not used if empty
+  fDirectory = directory;
+}
+
+inline G4String TG4GeometryCache::GetDirectory() const {
+  /// Return the cache directory
+  return fDirectory;
+}
+
+inline G4bool TG4GeometryCache::IsActive() const {
+  /// Return true if the cache directory is defined
+  return fDirectory.size() > 0;
+}
+
+#endif //TG4_GEOMETRY_CACHE_H
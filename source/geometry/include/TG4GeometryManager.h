@@ -24,6 +24,10 @@
 
 class TG4MagneticField;
 class TG4GeometryServices;
+class TG4GeometryCache;
+class TG4LegoScanner;
+class TG4OverlapChecker;
+class TG4RegularPlacementsConverter;
 class TG4OpGeometryManager;
 class TG4ModelConfigurationManager;
 class TG4G3CutVector;
@@ -58,6 +62,8 @@ class TG4GeometryManager : public TG4Verbose
     TG4OpGeometryManager* GetOpManager() const;
     TG4ModelConfigurationManager* GetFastModelsManager() const;
     TG4ModelConfigurationManager* GetEmModelsManager() const;
+    TG4LegoScanner*       GetLegoScanner() const;
+    TG4OverlapChecker*    GetOverlapChecker() const;
 
     // functions for building geometry
     void ConstructGeometry();
@@ -72,6 +78,8 @@ class TG4GeometryManager : public TG4Verbose
     void SetIsLocalMagField(G4bool isLocalMagField);
     void SetIsUserMaxStep(G4bool isUserMaxStep);
     void SetIsMaxStepInLowDensityMaterials(G4bool isMaxStep);
+    void SetGeometryCacheDirectory(const G4String& directory);
+    void SetIsConvertRegularPlacements(G4bool isConvert);
      
     // set user region construction
     void SetUserRegionConstruction(
@@ -123,6 +131,13 @@ class TG4GeometryManager : public TG4Verbose
     // data members
     TG4DetConstructionMessenger  fMessenger; ///< messenger
     TG4GeometryServices*  fGeometryServices; ///< geometry services
+    TG4GeometryCache*     fGeometryCache;    ///< converted geometry cache
+    TG4LegoScanner*       fLegoScanner;      ///< material budget scanner
+    TG4OverlapChecker*    fOverlapChecker;   ///< overlaps checker
+
+    /// Regular placements converter
+    TG4RegularPlacementsConverter*  fPlacementsConverter;
+
     TVirtualMCGeometry*   fMCGeometry;       ///< VirtualMC geometry
     TG4OpGeometryManager* fOpManager;        ///< optical geometry manager    
 
@@ -191,6 +206,16 @@ inline TG4ModelConfigurationManager* TG4GeometryManager::GetEmModelsManager() co
   return fEmModelsManager;
 }
 
+inline TG4LegoScanner* TG4GeometryManager::GetLegoScanner() const {
+  /// Return the material budget (lego) scanner
+  return fLegoScanner;
+}
+
+inline TG4OverlapChecker* TG4GeometryManager::GetOverlapChecker() const {
+  /// Return the overlaps checker
+  return fOverlapChecker;
+}
+
 inline void TG4GeometryManager::SetLimitDensity(G4double density) {
   /// Set the material density limit for setting max allowed step
   fLimitDensity = density;
@@ -30,6 +30,7 @@
 #include <TMCOptical.h>
 
 #include <map>
+#include <set>
 
 class TG4MediumMap;
 class TG4NameMap;
@@ -76,6 +77,8 @@ class TG4GeometryServices : public TG4Verbose
     G4SurfaceType          SurfaceType(EMCOpSurfaceType surfType) const;
     G4OpticalSurfaceFinish SurfaceFinish(EMCOpSurfaceFinish finish) const; 
     void  Convert(const G4Transform3D& transform, TGeoHMatrix& matrix) const;                                           
+    G4Transform3D GetConvertedCopyTransform(const G4VPhysicalVolume* pv,
+                                            G4int copyNo) const;
 
     G4Material* MixMaterials(G4String name, G4double density,
                              const TG4StringVector& matNames, 
@@ -97,6 +100,7 @@ class TG4GeometryServices : public TG4Verbose
     void SetWorld(G4VPhysicalVolume* world);
     void SetIsG3toG4(G4bool isG3toG4);
     void SetG3toG4Separator(char separator);
+    void AddConvertedVolume(const G4VPhysicalVolume* pv);
 
     // get methods
            // volumes
@@ -104,6 +108,7 @@ class TG4GeometryServices : public TG4Verbose
     Int_t NofG4LogicalVolumes() const; 
     Int_t NofG4PhysicalVolumes() const; 
     G4VPhysicalVolume* GetWorld() const;
+    G4bool IsConvertedVolume(const G4VPhysicalVolume* pv) const;
 
     TG4Limits* GetLimits(G4UserLimits* limits) const;
     TG4Limits* GetLimits(G4UserLimits* limits,
@@ -170,6 +175,10 @@ class TG4GeometryServices : public TG4Verbose
 
     /// top physical volume (world)
     G4VPhysicalVolume* fWorld;
+
+    /// replicas and parameterised volumes created by 
+    /// TG4RegularPlacementsConverter
+    std::set<const G4VPhysicalVolume*>  fConvertedVolumes;
 };
 
 // inline methods
@@ -194,6 +203,18 @@ inline G4VPhysicalVolume* TG4GeometryServices::GetWorld() const {
   return fWorld; 
 }
 
+inline void TG4GeometryServices::AddConvertedVolume(const G4VPhysicalVolume* pv) {
+  /// Register the replica or parameterised volume created by
+  /// TG4RegularPlacementsConverter
+  fConvertedVolumes.insert(pv);
+}
+
+inline G4bool 
+TG4GeometryServices::IsConvertedVolume(const G4VPhysicalVolume* pv) const {
+  /// Return true if the volume was created by TG4RegularPlacementsConverter
+  return fConvertedVolumes.size() && fConvertedVolumes.count(pv);
+}
+
 inline TG4MediumMap* TG4GeometryServices::GetMediumMap() const {
   /// Return the medium map
   return fMediumMap;
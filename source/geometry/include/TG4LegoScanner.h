@@ -0,0 +1,158 @@
+#ifndef TG4_LEGO_SCANNER_H
+#define TG4_LEGO_SCANNER_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2015 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4LegoScanner.h
+/// \brief Definition of the TG4LegoScanner class
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include "TG4LegoScannerMessenger.h"
+
+#include <G4ThreeVector.hh>
+#include <globals.hh>
+
+#include <map>
+#include <vector>
+
+class TH2D;
+
+struct TG4LegoScanTask;
+
+/// \ingroup geometry
+/// \brief The material budget (lego) scanner
+///
+/// The scanner shoots straight rays from the vertex over a grid in
+/// eta (or theta) and phi and accumulates along each ray the material
+/// thickness in radiation lengths, in nuclear interaction lengths and
+/// the path length. The rays stop when leaving the world or reaching
+/// the scan cylinder defined by the maximum radius and half-length.
+/// Optionally, the radiation, interaction and path lengths are also
+/// accumulated per material and per volume at the given geometry level.
+///
+/// The rays are navigated directly through the geometry, without the
+/// event loop, stacking or the application callbacks. When the Root
+/// geometry is available, it is navigated with TGeo navigators by
+/// the given number of threads; otherwise the Geant4 geometry is navigated
+/// with a dedicated G4Navigator in the calling thread.
+///
+/// The result is written as TH2D histograms in a Root file.
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+class TG4LegoScanner
+{
+  friend struct TG4LegoScanTask;
+
+  public:
+    /// The grid types
+    enum GridType {
+      kEtaPhi,   ///< grid in eta and phi
+      kThetaPhi  ///< grid in theta and phi
+    };
+
+  public:
+    TG4LegoScanner();
+    virtual ~TG4LegoScanner();
+
+    // methods
+    void Scan();
+
+    // set methods
+    void SetGrid(GridType gridType,
+                 G4int nx, G4double xmin, G4double xmax,
+                 G4int nphi, G4double phimin, G4double phimax);
+    void SetVertex(const G4ThreeVector& vertex);
+    void SetRmax(G4double rmax);
+    void SetZmax(G4double zmax);
+    void SetNofThreads(G4int nofThreads);
+    void SetFileName(const G4String& fileName);
+    void SetIsMaterialMaps(G4bool isMaterialMaps);
+    void SetVolumeLevel(G4int volumeLevel);
+
+  private:
+    /// Not implemented
+    TG4LegoScanner(const TG4LegoScanner& right);
+    /// Not implemented
+    TG4LegoScanner& operator=(const TG4LegoScanner& right);
+
+    // static methods
+    static void* RunRootTask(void* task);
+
+    // methods
+    G4ThreeVector GetDirection(G4int ix, G4int iphi) const;
+    G4double GetMaxDistance(const G4ThreeVector& direction) const;
+    void ScanRoot(TG4LegoScanTask& task) const;
+    void ScanGeant4(TG4LegoScanTask& task) const;
+    TH2D* CreateHistogram(const G4String& name, const G4String& title,
+                          const std::vector<G4double>& values) const;
+    void CreateHistograms(const G4String& name, const G4String& title,
+             const std::map<G4String, std::vector<G4double> >& maps) const;
+    void Write(const std::vector<TG4LegoScanTask*>& tasks) const;
+
+    // data members
+    TG4LegoScannerMessenger  fMessenger; ///< messenger
+    GridType       fGridType;      ///< the grid type
+    G4int          fNx;            ///< number of bins in eta or theta
+    G4double       fXmin;          ///< minimum eta or theta
+    G4double       fXmax;          ///< maximum eta or theta
+    G4int          fNphi;          ///< number of bins in phi
+    G4double       fPhimin;        ///< minimum phi
+    G4double       fPhimax;        ///< maximum phi
+    G4ThreeVector  fVertex;        ///< the rays origin
+    G4double       fRmax;          ///< the scan cylinder radius (0 = unlimited)
+    G4double       fZmax;          ///< the scan cylinder half-length (0 = unlimited)
+    G4int          fNofThreads;    ///< the number of threads
+    G4String       fFileName;      ///< the output file name
+    G4bool         fIsMaterialMaps;///< option to fill the maps per material
+    G4int          fVolumeLevel;   ///< the level of per volume maps (-1 = none)
+};
+
+// inline methods
+
+inline void TG4LegoScanner::SetVertex(const G4ThreeVector& vertex) {
+  /// Set the rays origin
+  fVertex = vertex;
+}
+
+inline void TG4LegoScanner::SetRmax(G4double rmax) {
+  /// Set the scan cylinder radius (0 = unlimited)
+  fRmax = rmax;
+}
+
+inline void TG4LegoScanner::SetZmax(G4double zmax) {
+  /// Set the scan cylinder half-length (0 = unlimited)
+  fZmax = zmax;
+}
+
+inline void TG4LegoScanner::SetNofThreads(G4int nofThreads) {
+  /// Set the number of threads navigating the Root geometry
+  fNofThreads = nofThreads;
+}
+
+inline void TG4LegoScanner::SetFileName(const G4String& fileName) {
+  /// Set the output file name
+  fFileName = fileName;
+}
+
+inline void TG4LegoScanner::SetIsMaterialMaps(G4bool isMaterialMaps) {
+  /// Set the option to fill the radiation, interaction and path length
+  /// maps per material
+  fIsMaterialMaps = isMaterialMaps;
+}
+
+inline void TG4LegoScanner::SetVolumeLevel(G4int volumeLevel) {
+  /// Set the geometry level of the volumes for which the radiation,
+  /// interaction and path length maps are filled (-1 = none)
+  fVolumeLevel = volumeLevel;
+}
+
+#endif //TG4_LEGO_SCANNER_H
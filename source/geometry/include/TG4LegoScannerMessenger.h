@@ -0,0 +1,99 @@
+#ifndef TG4_LEGO_SCANNER_MESSENGER_H
+#define TG4_LEGO_SCANNER_MESSENGER_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2015 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4LegoScannerMessenger.h
+/// \brief Definition of the TG4LegoScannerMessenger class 
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include <G4UImessenger.hh>
+#include <globals.hh>
+
+class TG4LegoScanner;
+
+class G4UIcommand;
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithABool;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWith3VectorAndUnit;
+
+/// \ingroup geometry
+/// \brief Messenger class that defines commands for TG4LegoScanner.
+///
+/// Implements commands:
+/// - /mcLego/setGrid gridType nx xmin xmax nphi phimin phimax \n
+///       gridType = eta | theta; theta and phi in degrees
+/// - /mcLego/setVertex x y z unit
+/// - /mcLego/setRmax value unit
+/// - /mcLego/setZmax value unit
+/// - /mcLego/setNofThreads value
+/// - /mcLego/setFileName fileName
+/// - /mcLego/setMaterialMaps true|false
+/// - /mcLego/setVolumeLevel level
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+class TG4LegoScannerMessenger: public G4UImessenger
+{
+  public:
+    TG4LegoScannerMessenger(TG4LegoScanner* legoScanner);
+    virtual ~TG4LegoScannerMessenger();
+
+    // methods
+    virtual void SetNewValue(G4UIcommand* command, G4String newValues);
+    
+  private:
+    /// Not implemented
+    TG4LegoScannerMessenger();
+    /// Not implemented
+    TG4LegoScannerMessenger(const TG4LegoScannerMessenger& right);
+    /// Not implemented
+    TG4LegoScannerMessenger& operator=(const TG4LegoScannerMessenger &right);
+
+    // methods
+    void CreateSetGridCmd();
+
+    // data members
+    TG4LegoScanner*  fLegoScanner; ///< associated class
+    G4UIdirectory*   fDirectory;   ///< command directory
+    
+    //
+    // commands data members
+    
+    /// command: setGrid
+    G4UIcommand*                fSetGridCmd;
+
+    /// command: setVertex
+    G4UIcmdWith3VectorAndUnit*  fSetVertexCmd;
+
+    /// command: setRmax
+    G4UIcmdWithADoubleAndUnit*  fSetRmaxCmd;
+
+    /// command: setZmax
+    G4UIcmdWithADoubleAndUnit*  fSetZmaxCmd;
+
+    /// command: setNofThreads
+    G4UIcmdWithAnInteger*       fSetNofThreadsCmd;
+
+    /// command: setFileName
+    G4UIcmdWithAString*         fSetFileNameCmd;
+
+    /// command: setMaterialMaps
+    G4UIcmdWithABool*           fSetMaterialMapsCmd;
+
+    /// command: setVolumeLevel
+    G4UIcmdWithAnInteger*       fSetVolumeLevelCmd;
+};
+
+#endif //TG4_LEGO_SCANNER_MESSENGER_H
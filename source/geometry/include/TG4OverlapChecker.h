@@ -0,0 +1,132 @@
+#ifndef TG4_OVERLAP_CHECKER_H
+#define TG4_OVERLAP_CHECKER_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2015 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4OverlapChecker.h
+/// \brief Definition of the TG4OverlapChecker class
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include <globals.hh>
+
+#include <vector>
+
+class G4LogicalVolume;
+class G4VPhysicalVolume;
+
+struct TG4OverlapCheckTask;
+
+/// \ingroup geometry
+/// \brief The parallel checker of the geometry overlaps
+///
+/// The checker tests the daughters of each mother logical volume with
+/// the same method as G4PVPlacement::CheckOverlaps(): the given number
+/// of points is generated on the surface of each daughter and tested
+/// against the mother and the sister volumes. As the logical volumes are
+/// independent, they are distributed over the given number of threads;
+/// each logical volume is checked once, whatever the number of its
+/// placements. The random engine is seeded for each mother volume, so that
+/// the result does not depend on the number of threads; the state of
+/// the calling thread engine is restored after the check.
+///
+/// The overlaps found are written in a machine-readable report with one
+/// tab-separated line per overlap. If the cache directory is set,
+/// the report is saved there under a name containing the hash of
+/// the Geant4 geometry and of the check parameters, and it is reused
+/// instead of repeating the check on an unchanged geometry.
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+class TG4OverlapChecker
+{
+  friend struct TG4OverlapCheckTask;
+
+  public:
+    TG4OverlapChecker();
+    virtual ~TG4OverlapChecker();
+
+    // methods
+    G4int Check(G4VPhysicalVolume* world);
+
+    // set methods
+    void SetIsActive(G4bool isActive);
+    void SetResolution(G4int resolution);
+    void SetTolerance(G4double tolerance);
+    void SetNofThreads(G4int nofThreads);
+    void SetReportFileName(const G4String& fileName);
+    void SetCacheDirectory(const G4String& directory);
+
+    // get methods
+    G4bool IsActive() const;
+
+  private:
+    /// Not implemented
+    TG4OverlapChecker(const TG4OverlapChecker& right);
+    /// Not implemented
+    TG4OverlapChecker& operator=(const TG4OverlapChecker& right);
+
+    // static methods
+    static void* RunTask(void* task);
+
+    // methods
+    void CollectMothers(G4VPhysicalVolume* world,
+                        std::vector<G4LogicalVolume*>& mothers) const;
+    G4String ComputeHash(const std::vector<G4LogicalVolume*>& mothers) const;
+    void CheckMother(G4LogicalVolume* mother, G4int index,
+                     std::vector<G4String>& overlaps) const;
+
+    // data members
+    G4bool    fIsActive;       ///< option to check overlaps
+    G4int     fResolution;     ///< number of points per daughter surface
+    G4double  fTolerance;      ///< overlaps tolerance
+    G4int     fNofThreads;     ///< number of threads
+    G4String  fReportFileName; ///< the report file name
+    G4String  fCacheDirectory; ///< the cache directory
+};
+
+// inline methods
+
+inline void TG4OverlapChecker::SetIsActive(G4bool isActive) {
+  /// Set the option to check overlaps at geometry construction
+  fIsActive = isActive;
+}
+
+inline void TG4OverlapChecker::SetResolution(G4int resolution) {
+  /// Set the number of points generated on each daughter surface
+  fResolution = resolution;
+}
+
+inline void TG4OverlapChecker::SetTolerance(G4double tolerance) {
+  /// Set the tolerance; the overlaps below it are not reported
+  fTolerance = tolerance;
+}
+
+inline void TG4OverlapChecker::SetNofThreads(G4int nofThreads) {
+  /// Set the number of threads
+  fNofThreads = nofThreads;
+}
+
+inline void TG4OverlapChecker::SetReportFileName(const G4String& fileName) {
+  /// Set the report file name
+  fReportFileName = fileName;
+}
+
+inline void TG4OverlapChecker::SetCacheDirectory(const G4String& directory) {
+  /// Set the cache directory; the cache is not used if empty
+  fCacheDirectory = directory;
+}
+
+inline G4bool TG4OverlapChecker::IsActive() const {
+  /// Return the option to check overlaps at geometry construction
+  return fIsActive;
+}
+
+#endif //TG4_OVERLAP_CHECKER_H
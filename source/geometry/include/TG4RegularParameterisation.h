@@ -0,0 +1,75 @@
+#ifndef TG4_REGULAR_PARAMETERISATION_H
+#define TG4_REGULAR_PARAMETERISATION_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2015 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4RegularParameterisation.h
+/// \brief Definition of the TG4RegularParameterisation class
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include <G4VPVParameterisation.hh>
+#include <G4ThreeVector.hh>
+#include <G4RotationMatrix.hh>
+#include <globals.hh>
+
+/// \ingroup geometry
+/// \brief The parameterisation of the copies of a volume placed
+/// with the same rotation at regularly spaced positions
+///
+/// The copy with the number i is placed at the position origin + i*step.
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+class TG4RegularParameterisation : public G4VPVParameterisation
+{
+  public:
+    TG4RegularParameterisation(const G4ThreeVector& origin,
+                               const G4ThreeVector& step,
+                               const G4RotationMatrix* rotation);
+    virtual ~TG4RegularParameterisation();
+
+    // methods
+    virtual void ComputeTransformation(const G4int copyNo,
+                                       G4VPhysicalVolume* physVolume) const;
+
+    // get methods
+    G4ThreeVector GetTranslation(G4int copyNo) const;
+    const G4RotationMatrix* GetRotation() const;
+
+  private:
+    /// Not implemented
+    TG4RegularParameterisation();
+    /// Not implemented
+    TG4RegularParameterisation(const TG4RegularParameterisation& right);
+    /// Not implemented
+    TG4RegularParameterisation& operator=(
+                                const TG4RegularParameterisation& right);
+
+    // data members
+    G4ThreeVector      fOrigin;   ///< the position of the first copy
+    G4ThreeVector      fStep;     ///< the step between the copies positions
+    G4RotationMatrix*  fRotation; ///< the copies rotation (owned)
+};
+
+// inline methods
+
+inline G4ThreeVector 
+TG4RegularParameterisation::GetTranslation(G4int copyNo) const {
+  /// Return the translation of the copy with the given number
+  return fOrigin + copyNo*fStep;
+}
+
+inline const G4RotationMatrix* TG4RegularParameterisation::GetRotation() const {
+  /// Return the copies rotation (null if no rotation)
+  return fRotation;
+}
+
+#endif //TG4_REGULAR_PARAMETERISATION_H
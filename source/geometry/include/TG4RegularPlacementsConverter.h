@@ -0,0 +1,113 @@
+#ifndef TG4_REGULAR_PLACEMENTS_CONVERTER_H
+#define TG4_REGULAR_PLACEMENTS_CONVERTER_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2015 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4RegularPlacementsConverter.h
+/// \brief Definition of the TG4RegularPlacementsConverter class
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include <G4ThreeVector.hh>
+#include <geomdefs.hh>
+#include <globals.hh>
+
+#include <vector>
+
+class G4LogicalVolume;
+class G4VPhysicalVolume;
+
+class TG4RegularParameterisation;
+
+/// \ingroup geometry
+/// \brief The converter of regular placements in replicas or
+/// parameterised volumes
+///
+/// The converter looks for the logical volumes whose daughters are all
+/// placements of the same volume, with the same name and rotation, at
+/// positions in arithmetic progression and with the copy numbers following
+/// the same order starting from the first copy number (1 as in Root).
+/// The placements of such volume are replaced with a single replica,
+/// if the daughters are boxes slicing a box mother along a Cartesian axis,
+/// or with a single parameterised volume otherwise.
+///
+/// As Geant4 numbers the replicated copies from 0, the copy numbers
+/// returned to VMC by CurrentVolID() and CurrentVolOffID() are the same
+/// as before the conversion, given the division copy number offset applied
+/// in TG4StepManager. The converted volumes are registered in
+/// TG4GeometryServices, so that the same offset is applied to them (and
+/// only to them) in CurrentVolPath(), and their paths can be resolved
+/// in TG4MCGeometry::GetTransformation().
+/// Note that the converted volume is then seen as a single daughter
+/// by the VMC volumes daughters queries, as the divisions.
+///
+/// The conversion is activated via /mcDet/convertRegularPlacements;
+/// it is available only with the geomRootToGeant4 option.
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+class TG4RegularPlacementsConverter
+{
+  public:
+    TG4RegularPlacementsConverter();
+    virtual ~TG4RegularPlacementsConverter();
+
+    // methods
+    G4int Convert(G4VPhysicalVolume* world, G4int verboseLevel);
+
+    // set methods
+    void SetIsActive(G4bool isActive);
+
+    // get methods
+    G4bool IsActive() const;
+
+  private:
+    /// Not implemented
+    TG4RegularPlacementsConverter(const TG4RegularPlacementsConverter& right);
+    /// Not implemented
+    TG4RegularPlacementsConverter& operator=(
+                                const TG4RegularPlacementsConverter& right);
+
+    // static data members
+    static const G4int     fgkMinNofPlacements; ///< min number of placements
+    static const G4double  fgkTolerance;        ///< positions tolerance
+
+    // methods
+    G4bool IsRegular(G4LogicalVolume* mother,
+                     std::vector<G4VPhysicalVolume*>& placements,
+                     G4ThreeVector& step) const;
+    EAxis  GetAxis(const G4ThreeVector& step) const;
+    G4bool IsReplica(G4LogicalVolume* mother,
+                     const std::vector<G4VPhysicalVolume*>& placements,
+                     const G4ThreeVector& step, EAxis axis) const;
+    void   MeasureVoxels(const std::vector<G4LogicalVolume*>& volumes,
+                         G4double& time, G4double& memory) const;
+
+    // data members
+    G4bool  fIsActive;     ///< option to convert the regular placements
+    G4int   fFirstCopyNo;  ///< the copy number of the first placement
+
+    /// the created parameterisations
+    std::vector<TG4RegularParameterisation*>  fParameterisations;
+};
+
+// inline methods
+
+inline void TG4RegularPlacementsConverter::SetIsActive(G4bool isActive) {
+  /// Set the option to convert the regular placements
+  fIsActive = isActive;
+}
+
+inline G4bool TG4RegularPlacementsConverter::IsActive() const {
+  /// Return the option to convert the regular placements
+  return fIsActive;
+}
+
+#endif //TG4_REGULAR_PLACEMENTS_CONVERTER_H
@@ -16,6 +16,7 @@
 #include "TG4DetConstructionMessenger.h"
 #include "TG4DetConstruction.h"
 #include "TG4GeometryManager.h"
+#include "TG4OverlapChecker.h"
 #include "TG4RadiatorDescription.h"
 #include "TG4GeometryServices.h"
 #include "TG4G3Units.h"
@@ -24,6 +25,7 @@
 #include <G4UIdirectory.hh>
 #include <G4UIcmdWithoutParameter.hh>
 #include <G4UIcmdWithABool.hh>
+#include <G4UIcmdWithAnInteger.hh>
 #include <G4UIcmdWithAString.hh>
 #include <G4UIcmdWithADoubleAndUnit.hh>
 #include <G4AnalysisUtilities.hh>
@@ -45,6 +47,14 @@ TG4DetConstructionMessenger::TG4DetConstructionMessenger(
     fIsMaxStepInLowDensityMaterialsCmd(0),
     fSetLimitDensityCmd(0),
     fSetMaxStepInLowDensityMaterialsCmd(0),
+    fSetGeometryCacheDirCmd(0),
+    fConvertRegularPlacementsCmd(0),
+    fCheckOverlapsCmd(0),
+    fSetOverlapsResolutionCmd(0),
+    fSetOverlapsToleranceCmd(0),
+    fSetOverlapsNofThreadsCmd(0),
+    fSetOverlapsReportCmd(0),
+    fSetOverlapsCacheDirCmd(0),
     fSetNewRadiatorCmd(0),
     fSetRadiatorLayerCmd(0),
     fSetRadiatorStrawTubeCmd(0),
@@ -162,6 +172,87 @@ TG4DetConstructionMessenger::TG4DetConstructionMessenger(
   fSetMaxStepInLowDensityMaterialsCmd->SetUnitCategory("Length");
   fSetMaxStepInLowDensityMaterialsCmd->AvailableForStates(G4State_PreInit);
 
+  fSetGeometryCacheDirCmd 
+    = new G4UIcmdWithAString("/mcDet/setGeometryCacheDir", this);
+  fSetGeometryCacheDirCmd
+    ->SetGuidance("Set the directory of the cache of Geant4 geometry converted from Root.");
+  fSetGeometryCacheDirCmd
+    ->SetGuidance("The cached geometry is loaded instead of the conversion if the Root geometry");
+  fSetGeometryCacheDirCmd
+    ->SetGuidance("was not changed, otherwise it is saved after the conversion.");
+  fSetGeometryCacheDirCmd
+    ->SetGuidance("Available only with geomRootToGeant4 and Geant4 GDML.");
+  fSetGeometryCacheDirCmd->SetParameterName("GeometryCacheDir", false);
+  fSetGeometryCacheDirCmd->AvailableForStates(G4State_PreInit);
+
+  fConvertRegularPlacementsCmd
+    = new G4UIcmdWithABool("/mcDet/convertRegularPlacements", this);
+  fConvertRegularPlacementsCmd
+    ->SetGuidance("Convert the regular placements of the same volume in a replica");
+  fConvertRegularPlacementsCmd
+    ->SetGuidance("or a parameterised volume, preserving the VMC copy numbers.");
+  fConvertRegularPlacementsCmd
+    ->SetGuidance("Available only with geomRootToGeant4.");
+  fConvertRegularPlacementsCmd->SetParameterName("ConvertRegularPlacements", false);
+  fConvertRegularPlacementsCmd->AvailableForStates(G4State_PreInit);
+
+  fCheckOverlapsCmd = new G4UIcmdWithABool("/mcDet/checkOverlaps", this);
+  fCheckOverlapsCmd
+    ->SetGuidance("Activate checking overlaps when the geometry is closed.");
+  fCheckOverlapsCmd
+    ->SetGuidance("The mother volumes are checked in parallel, see /mcDet/setOverlapsNofThreads.");
+  fCheckOverlapsCmd->SetParameterName("CheckOverlaps", false);
+  fCheckOverlapsCmd->AvailableForStates(G4State_PreInit);
+
+  fSetOverlapsResolutionCmd
+    = new G4UIcmdWithAnInteger("/mcDet/setOverlapsResolution", this);
+  fSetOverlapsResolutionCmd
+    ->SetGuidance("Set the number of points generated on each daughter surface");
+  fSetOverlapsResolutionCmd
+    ->SetGuidance("when checking overlaps.");
+  fSetOverlapsResolutionCmd->SetParameterName("OverlapsResolution", false);
+  fSetOverlapsResolutionCmd->SetRange("OverlapsResolution > 0");
+  fSetOverlapsResolutionCmd->AvailableForStates(G4State_PreInit);
+
+  fSetOverlapsToleranceCmd
+    = new G4UIcmdWithADoubleAndUnit("/mcDet/setOverlapsTolerance", this);
+  fSetOverlapsToleranceCmd
+    ->SetGuidance("Set the tolerance for checking overlaps;");
+  fSetOverlapsToleranceCmd
+    ->SetGuidance("the overlaps below this value are not reported.");
+  fSetOverlapsToleranceCmd->SetParameterName("OverlapsTolerance", false);
+  fSetOverlapsToleranceCmd->SetDefaultUnit("mm");
+  fSetOverlapsToleranceCmd->SetUnitCategory("Length");
+  fSetOverlapsToleranceCmd->AvailableForStates(G4State_PreInit);
+
+  fSetOverlapsNofThreadsCmd
+    = new G4UIcmdWithAnInteger("/mcDet/setOverlapsNofThreads", this);
+  fSetOverlapsNofThreadsCmd
+    ->SetGuidance("Set the number of threads for checking overlaps.");
+  fSetOverlapsNofThreadsCmd
+    ->SetGuidance("Available only with Geant4 built in multi-threading mode.");
+  fSetOverlapsNofThreadsCmd->SetParameterName("OverlapsNofThreads", false);
+  fSetOverlapsNofThreadsCmd->SetRange("OverlapsNofThreads > 0");
+  fSetOverlapsNofThreadsCmd->AvailableForStates(G4State_PreInit);
+
+  fSetOverlapsReportCmd
+    = new G4UIcmdWithAString("/mcDet/setOverlapsReport", this);
+  fSetOverlapsReportCmd
+    ->SetGuidance("Set the name of the overlaps report file.");
+  fSetOverlapsReportCmd->SetParameterName("OverlapsReport", false);
+  fSetOverlapsReportCmd->AvailableForStates(G4State_PreInit);
+
+  fSetOverlapsCacheDirCmd
+    = new G4UIcmdWithAString("/mcDet/setOverlapsCacheDir", this);
+  fSetOverlapsCacheDirCmd
+    ->SetGuidance("Set the directory of the overlaps reports cache.");
+  fSetOverlapsCacheDirCmd
+    ->SetGuidance("The cached report is used instead of the check if the geometry");
+  fSetOverlapsCacheDirCmd
+    ->SetGuidance("and the check parameters were not changed.");
+  fSetOverlapsCacheDirCmd->SetParameterName("OverlapsCacheDir", false);
+  fSetOverlapsCacheDirCmd->AvailableForStates(G4State_PreInit);
+
   CreateSetNewRadiatorCmd();
   CreateSetRadiatorLayerCmd();
   CreateSetRadiatorStrawTubeCmd();
@@ -191,6 +282,14 @@ TG4DetConstructionMessenger::~TG4DetConstructionMessenger()
   delete fIsMaxStepInLowDensityMaterialsCmd;
   delete fSetLimitDensityCmd;
   delete fSetMaxStepInLowDensityMaterialsCmd;
+  delete fSetGeometryCacheDirCmd;
+  delete fConvertRegularPlacementsCmd;
+  delete fCheckOverlapsCmd;
+  delete fSetOverlapsResolutionCmd;
+  delete fSetOverlapsToleranceCmd;
+  delete fSetOverlapsNofThreadsCmd;
+  delete fSetOverlapsReportCmd;
+  delete fSetOverlapsCacheDirCmd;
   delete fSetNewRadiatorCmd;
   delete fSetRadiatorLayerCmd;
   delete fSetRadiatorStrawTubeCmd;
@@ -370,6 +469,38 @@ void TG4DetConstructionMessenger::SetNewValue(G4UIcommand* command,
       ->SetMaxStepInLowDensityMaterials(
           fSetMaxStepInLowDensityMaterialsCmd->GetNewDoubleValue(newValues));
   }
+  else if (command == fSetGeometryCacheDirCmd) {
+    TG4GeometryManager::Instance()->SetGeometryCacheDirectory(newValues);
+  }
+  else if (command == fConvertRegularPlacementsCmd) {
+    TG4GeometryManager::Instance()
+      ->SetIsConvertRegularPlacements(
+          fConvertRegularPlacementsCmd->GetNewBoolValue(newValues));
+  }
+  else if (command == fCheckOverlapsCmd) {
+    TG4GeometryManager::Instance()->GetOverlapChecker()
+      ->SetIsActive(fCheckOverlapsCmd->GetNewBoolValue(newValues));
+  }
+  else if (command == fSetOverlapsResolutionCmd) {
+    TG4GeometryManager::Instance()->GetOverlapChecker()
+      ->SetResolution(fSetOverlapsResolutionCmd->GetNewIntValue(newValues));
+  }
+  else if (command == fSetOverlapsToleranceCmd) {
+    TG4GeometryManager::Instance()->GetOverlapChecker()
+      ->SetTolerance(fSetOverlapsToleranceCmd->GetNewDoubleValue(newValues));
+  }
+  else if (command == fSetOverlapsNofThreadsCmd) {
+    TG4GeometryManager::Instance()->GetOverlapChecker()
+      ->SetNofThreads(fSetOverlapsNofThreadsCmd->GetNewIntValue(newValues));
+  }
+  else if (command == fSetOverlapsReportCmd) {
+    TG4GeometryManager::Instance()->GetOverlapChecker()
+      ->SetReportFileName(newValues);
+  }
+  else if (command == fSetOverlapsCacheDirCmd) {
+    TG4GeometryManager::Instance()->GetOverlapChecker()
+      ->SetCacheDirectory(newValues);
+  }
   else if (command == fSetNewRadiatorCmd) {
     // tokenize parameters in a vector
     std::vector<G4String> parameters;
@@ -0,0 +1,248 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2015 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4GeometryCache.cxx
+/// \brief Implementation of the TG4GeometryCache class
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include "TG4GeometryCache.h"
+#include "TG4Globals.h"
+
+#include <G4VPhysicalVolume.hh>
+#include <G4Timer.hh>
+#include <G4Version.hh>
+
+#ifdef USE_G4GDML
+#include <G4GDMLParser.hh>
+#endif
+
+#include <TGeoManager.h>
+#include <TGeoMaterial.h>
+#include <TGeoMedium.h>
+#include <TGeoVolume.h>
+#include <TGeoNode.h>
+#include <TGeoMatrix.h>
+#include <TGeoShape.h>
+#include <TBufferFile.h>
+#include <TMD5.h>
+#include <TSystem.h>
+#include <TList.h>
+
+#include <cstring>
+
+const G4String TG4GeometryCache::fgkFilePrefix = "g4geometry_";
+
+namespace {
+
+/// The cache format version, to be increased when the hashed data change
+const Int_t gCacheVersion = 1;
+
+/// Update the MD5 digest with the given string
+void Update(TMD5& md5, const char* value)
+{
+  md5.Update((const UChar_t*)value, strlen(value) + 1);
+}
+
+/// Update the MD5 digest with the given number
+template <typename T>
+void Update(TMD5& md5, T value)
+{
+  md5.Update((const UChar_t*)&value, sizeof(T));
+}
+
+/// Update the MD5 digest with the given array of numbers
+void Update(TMD5& md5, const Double_t* values, Int_t n)
+{
+  md5.Update((const UChar_t*)values, n*sizeof(Double_t));
+}
+
+}
+
+//_____________________________________________________________________________
+TG4GeometryCache::TG4GeometryCache()
+  : fDirectory(),
+    fHash()
+{
+/// Default constructor
+}
+
+//_____________________________________________________________________________
+TG4GeometryCache::~TG4GeometryCache()
+{
+/// Destructor
+}
+
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+G4String TG4GeometryCache::ComputeHash() const
+{
+/// Compute the MD5 hash of the Root geometry: materials, media,
+/// volumes with their shapes and the daughters placements.
+/// The Geant4 version is included as the GDML output may change with it.
+
+  TMD5 md5;
+  Update(md5, gCacheVersion);
+  Update(md5, G4VERSION_NUMBER);
+  Update(md5, gGeoManager->GetName());
+
+  // Materials
+  TIter nextMaterial(gGeoManager->GetListOfMaterials());
+  TGeoMaterial* material;
+  while ( ( material = (TGeoMaterial*)nextMaterial() ) ) {
+    Update(md5, material->GetName());
+    Update(md5, material->GetA());
+    Update(md5, material->GetZ());
+    Update(md5, material->GetDensity());
+    if ( material->IsMixture() ) {
+      TGeoMixture* mixture = (TGeoMixture*)material;
+      Update(md5, mixture->GetAmixt(), mixture->GetNelements());
+      Update(md5, mixture->GetZmixt(), mixture->GetNelements());
+      Update(md5, mixture->GetWmixt(), mixture->GetNelements());
+    }
+  }
+
+  // Media
+  TIter nextMedium(gGeoManager->GetListOfMedia());
+  TGeoMedium* medium;
+  while ( ( medium = (TGeoMedium*)nextMedium() ) ) {
+    Update(md5, medium->GetId());
+    Update(md5, medium->GetName());
+    Update(md5, medium->GetMaterial()->GetName());
+    for ( Int_t i=0; i<10; ++i ) Update(md5, medium->GetParam(i));
+  }
+
+  // Volumes, shapes and daughters placements
+  TBufferFile buffer(TBuffer::kWrite);
+  TIter nextVolume(gGeoManager->GetListOfVolumes());
+  TGeoVolume* volume;
+  while ( ( volume = (TGeoVolume*)nextVolume() ) ) {
+    Update(md5, volume->GetName());
+    if ( volume->GetMedium() ) Update(md5, volume->GetMedium()->GetId());
+
+    buffer.Reset();
+    volume->GetShape()->Streamer(buffer);
+    md5.Update((const UChar_t*)buffer.Buffer(), buffer.Length());
+
+    for ( Int_t i=0; i<volume->GetNdaughters(); ++i ) {
+      TGeoNode* node = volume->GetNode(i);
+      TGeoMatrix* matrix = node->GetMatrix();
+      Update(md5, node->GetName());
+      Update(md5, node->GetVolume()->GetName());
+      Update(md5, node->GetNumber());
+      Update(md5, matrix->GetTranslation(), 3);
+      Update(md5, matrix->GetRotationMatrix(), 9);
+    }
+  }
+
+  md5.Final();
+  return md5.AsString();
+}
+
+//_____________________________________________________________________________
+G4String TG4GeometryCache::GetFileName()
+{
+/// Return the cache file name for the current Root geometry;
+/// the hash is computed only once.
+
+  if ( ! fHash.size() ) fHash = ComputeHash();
+
+  return fDirectory + "/" + fgkFilePrefix + fHash + ".gdml";
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+G4VPhysicalVolume* TG4GeometryCache::Load(G4int verboseLevel)
+{
+/// Load the Geant4 geometry from the cache file matching the current
+/// Root geometry; return 0 if there is no such file.
+
+#ifdef USE_G4GDML
+  G4Timer timer;
+  timer.Start();
+
+  G4String fileName = GetFileName();
+  if ( gSystem->AccessPathName(fileName.data(), kReadPermission) ) {
+    if ( verboseLevel > 0 ) {
+      G4cout << "Geometry cache " << fileName << " not found." << G4endl;
+    }
+    return 0;
+  }
+
+  // The names are stripped from the pointer suffixes added when writing
+  G4GDMLParser parser;
+  parser.Read(fileName, false);
+  G4VPhysicalVolume* world = parser.GetWorldVolume();
+
+  timer.Stop();
+  if ( world && verboseLevel > 0 ) {
+    G4cout << "Geant4 geometry loaded from cache " << fileName
+           << " in " << timer.GetRealElapsed() << " s" << G4endl;
+  }
+
+  return world;
+#else
+  TG4Globals::Warning(
+    "TG4GeometryCache", "Load",
+    "Geant4 VMC has been installed without Geant4 GDML." + TG4Globals::Endl() +
+    "The geometry cache is not supported.");
+  return 0;
+#endif
+}
+
+//_____________________________________________________________________________
+void TG4GeometryCache::Save(G4VPhysicalVolume* world, G4int verboseLevel)
+{
+/// Save the Geant4 geometry in the cache file matching the current
+/// Root geometry. The geometry is first written in a temporary file
+/// and then renamed, so that the jobs sharing the cache directory
+/// never read an incomplete file.
+
+#ifdef USE_G4GDML
+  G4Timer timer;
+  timer.Start();
+
+  G4String fileName = GetFileName();
+  gSystem->mkdir(fDirectory.data(), kTRUE);
+
+  TString tmpFileName = fDirectory + "/" + fgkFilePrefix + fHash;
+  tmpFileName += "_";
+  tmpFileName += gSystem->GetPid();
+  tmpFileName += ".gdml";
+  gSystem->Unlink(tmpFileName);
+
+  G4GDMLParser parser;
+  parser.Write(tmpFileName.Data(), world, true);
+
+  if ( gSystem->Rename(tmpFileName, fileName.data()) != 0 ) {
+    TG4Globals::Warning(
+      "TG4GeometryCache", "Save",
+      TString("Failed to write geometry cache ") + fileName.data());
+    gSystem->Unlink(tmpFileName);
+    return;
+  }
+
+  timer.Stop();
+  if ( verboseLevel > 0 ) {
+    G4cout << "Geant4 geometry saved in cache " << fileName
+           << " in " << timer.GetRealElapsed() << " s" << G4endl;
+  }
+#else
+  TG4Globals::Warning(
+    "TG4GeometryCache", "Save",
+    "Geant4 VMC has been installed without Geant4 GDML." + TG4Globals::Endl() +
+    "The geometry cache is not supported.");
+#endif
+}
@@ -14,6 +14,10 @@
 
 #include "TG4GeometryManager.h"
 #include "TG4GeometryServices.h"
+#include "TG4GeometryCache.h"
+#include "TG4LegoScanner.h"
+#include "TG4OverlapChecker.h"
+#include "TG4RegularPlacementsConverter.h"
 #include "TG4SDManager.h"
 #include "TG4MCGeometry.h"
 #include "TG4OpGeometryManager.h"
@@ -39,6 +43,7 @@
 #include <G4PVPlacement.hh>
 #include <G4SystemOfUnits.hh>
 #include <G4AutoDelete.hh>
+#include <G4Timer.hh>
 
 #include <TGeoManager.h>
 #include <TGeoVolume.h>
@@ -74,6 +79,10 @@ TG4GeometryManager::TG4GeometryManager(const TString& userGeometry)
   : TG4Verbose("geometryManager"),
     fMessenger(this),
     fGeometryServices(new TG4GeometryServices()),
+    fGeometryCache(new TG4GeometryCache()),
+    fLegoScanner(new TG4LegoScanner()),
+    fOverlapChecker(new TG4OverlapChecker()),
+    fPlacementsConverter(new TG4RegularPlacementsConverter()),
     fMCGeometry(0),
     fOpManager(0),
     fFastModelsManager(0),
@@ -123,6 +132,10 @@ TG4GeometryManager::~TG4GeometryManager()
      // magnetic field objects are deleted via G4AutoDelete;
 
   delete fGeometryServices;
+  delete fGeometryCache;
+  delete fLegoScanner;
+  delete fOverlapChecker;
+  delete fPlacementsConverter;
   delete fOpManager;
   delete fFastModelsManager;
   delete fEmModelsManager;
@@ -211,7 +224,9 @@ void TG4GeometryManager::ConstructG4GeometryViaVMC()
 void TG4GeometryManager::ConstructG4GeometryViaVGM()
 {
 /// Convert Root geometry to G4 geometry objects
-/// using roottog4 convertor.
+/// using roottog4 convertor. If the geometry cache is active,
+/// the Geant4 geometry is loaded from the cache if available
+/// or saved in the cache after the conversion.
 
 #ifdef USE_VGM
   if ( VerboseLevel() > 1 ) 
@@ -239,9 +254,21 @@ void TG4GeometryManager::ConstructG4GeometryViaVGM()
   // Close Root geometry
   if (!gGeoManager->IsClosed()) gGeoManager->CloseGeometry();  
 
+  // Load G4 geometry from cache
+  if ( fGeometryCache->IsActive() ) {
+    G4VPhysicalVolume* g4World = fGeometryCache->Load(VerboseLevel());
+    if ( g4World ) {
+      fGeometryServices->SetWorld(g4World);
+      return;
+    }  
+  }    
+
   // Convert Root geometry to G4
   if (VerboseLevel()>0)
     G4cout << "Converting Root geometry to Geant4 via VGM ... " << G4endl;
+
+  G4Timer timer;
+  timer.Start();
   
   // import Root geometry in VGM
   RootGM::Factory rootFactory;
@@ -256,6 +283,16 @@ void TG4GeometryManager::ConstructG4GeometryViaVGM()
     
   G4VPhysicalVolume* g4World = g4Factory.World();
   fGeometryServices->SetWorld(g4World);
+
+  timer.Stop();
+  if (VerboseLevel()>0) {
+    G4cout << "Root geometry converted to Geant4 in " 
+           << timer.GetRealElapsed() << " s" << G4endl;
+  }
+
+  // Save G4 geometry in cache
+  if ( fGeometryCache->IsActive() ) 
+    fGeometryCache->Save(g4World, VerboseLevel());
     
 #else
   TG4Globals::Exception(
@@ -317,9 +354,16 @@ void TG4GeometryManager::ConstructG4Geometry()
 
     ConstructG4GeometryViaVMC();
   
-  if ( fUserGeometry == "RootToGeant4" ) 
+  if ( fUserGeometry == "RootToGeant4" ) {
     ConstructG4GeometryViaVGM();
 
+    // Convert regular placements in replicas or parameterised volumes;
+    // done after saving the geometry cache so that it does not depend
+    // on this option
+    if ( fPlacementsConverter->IsActive() )
+      fPlacementsConverter->Convert(fGeometryServices->GetWorld(), VerboseLevel());
+  }  
+
   // print G4 geometry statistics
   if ( VerboseLevel() > 0 ) {
     G4cout << "G4 Stat: instantiated " 
@@ -754,6 +798,10 @@ void TG4GeometryManager::FinishGeometry()
   fGeometryServices->SetWorld(
     G4TransportationManager::GetTransportationManager()
       ->GetNavigatorForTracking()->GetWorldVolume());
+
+  // Check overlaps if activated
+  if ( fOverlapChecker->IsActive() )
+    fOverlapChecker->Check(fGeometryServices->GetWorld());
     
   if ( VerboseLevel() > 1 ) 
     G4cout << "TG4GeometryManager::FinishGeometry done" << G4endl;
@@ -807,6 +855,40 @@ TG4GeometryManager::CreateRadiator(const G4String& volName)
   return radiatorDescription;
 }
 
+//_____________________________________________________________________________
+void TG4GeometryManager::SetGeometryCacheDirectory(const G4String& directory)
+{
+/// Set the directory of the converted geometry cache;
+/// the cache is used only with the geomRootToGeant4 option.
+
+  if ( fUserGeometry != "RootToGeant4" ) {
+    TG4Globals::Warning(
+      "TG4GeometryManager", "SetGeometryCacheDirectory",
+      "The geometry cache is supported only with geomRootToGeant4." 
+      + TG4Globals::Endl() + "The setting is ignored.");
+    return;
+  }  
+
+  fGeometryCache->SetDirectory(directory);
+}
+
+//_____________________________________________________________________________
+void TG4GeometryManager::SetIsConvertRegularPlacements(G4bool isConvert)
+{
+/// Set the option to convert the regular placements in replicas or
+/// parameterised volumes; available only with the geomRootToGeant4 option.
+
+  if ( fUserGeometry != "RootToGeant4" ) {
+    TG4Globals::Warning(
+      "TG4GeometryManager", "SetIsConvertRegularPlacements",
+      "The regular placements conversion is supported only with geomRootToGeant4." 
+      + TG4Globals::Endl() + "The setting is ignored.");
+    return;
+  }  
+
+  fPlacementsConverter->SetIsActive(isConvert);
+}
+
 //_____________________________________________________________________________
 void TG4GeometryManager::SetUserLimits(const TG4G3CutVector& cuts,
                                const TG4G3ControlVector& controls) const
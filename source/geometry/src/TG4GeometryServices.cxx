@@ -21,6 +21,7 @@
 #include "TG4G3Units.h"
 #include "TG4G3ControlVector.h"
 #include "TG4Globals.h"
+#include "TG4RegularParameterisation.h"
 
 #include <G4LogicalVolumeStore.hh>
 #include <G4LogicalVolume.hh>
@@ -57,7 +58,8 @@ TG4GeometryServices::TG4GeometryServices()
     fIsG3toG4(false),
     fMediumMap(0),
     fOpSurfaceMap(0),
-    fWorld(0)
+    fWorld(0),
+    fConvertedVolumes()
 {
 /// Default constructor
 
@@ -426,6 +428,39 @@ void  TG4GeometryServices::Convert(const G4Transform3D& transform,
   delete [] rotation;
 }      
 
+//_____________________________________________________________________________
+G4Transform3D 
+TG4GeometryServices::GetConvertedCopyTransform(const G4VPhysicalVolume* pv,
+                                               G4int copyNo) const
+{
+/// Return the transformation of the copy with the given (VMC) copy number
+/// of the replica or parameterised volume created by 
+/// TG4RegularPlacementsConverter. The copy number of the first copy is 1.
+
+  G4int index = copyNo - 1;
+
+  const TG4RegularParameterisation* parameterisation
+    = dynamic_cast<const TG4RegularParameterisation*>(
+        pv->GetParameterisation());
+  if ( parameterisation ) {
+    G4RotationMatrix rotation;
+    if ( parameterisation->GetRotation() ) 
+      rotation = parameterisation->GetRotation()->inverse();
+    return G4Transform3D(rotation, parameterisation->GetTranslation(index));
+  }
+
+  // The replicas are placed at -width*(nofReplicas-1)/2 + index*width
+  EAxis axis;
+  G4int nofReplicas;
+  G4double width;
+  G4double offset;
+  G4bool consuming;
+  pv->GetReplicationData(axis, nofReplicas, width, offset, consuming);
+  G4ThreeVector translation;
+  translation[axis] = -width*(nofReplicas-1)*0.5 + index*width;
+  return G4Transform3D(G4RotationMatrix(), translation);
+}
+
 //_____________________________________________________________________________
 G4Material* TG4GeometryServices::MixMaterials(G4String name, G4double density, 
                                     const TG4StringVector& matNames, 
@@ -870,12 +905,18 @@ TG4GeometryServices::FindDaughter(const G4String& name, G4int copyNo,
                                   G4LogicalVolume* mlv, G4bool silent) const
 {
 /// Find daughter specified by name and copyNo in the given
-/// mother logical volume
+/// mother logical volume.
+/// The replica or parameterised volume created by TG4RegularPlacementsConverter
+/// is returned for all copy numbers of the converted placements
+/// (1, ..., number of copies).
 
   for (G4int i=0; i<mlv->GetNoDaughters(); i++) {
     G4VPhysicalVolume* dpv = mlv->GetDaughter(i);
-    if ( UserVolumeName(dpv->GetName()) == name &&
-         dpv->GetCopyNo() == copyNo ) return dpv;
+    if ( UserVolumeName(dpv->GetName()) != name ) continue;
+    if ( IsConvertedVolume(dpv) ) {
+      if ( copyNo >= 1 && copyNo <= dpv->GetMultiplicity() ) return dpv;
+    }
+    else if ( dpv->GetCopyNo() == copyNo ) return dpv;
   }         
   
   if ( ! silent ) {
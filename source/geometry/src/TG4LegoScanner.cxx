@@ -0,0 +1,506 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2015 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4LegoScanner.cxx
+/// \brief Implementation of the TG4LegoScanner class
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include "TG4LegoScanner.h"
+#include "TG4GeometryServices.h"
+#include "TG4Globals.h"
+
+#include <G4Navigator.hh>
+#include <G4TouchableHistory.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4LogicalVolume.hh>
+#include <G4Material.hh>
+#include <G4Threading.hh>
+#include <G4SystemOfUnits.hh>
+
+#include <TGeoManager.h>
+#include <TGeoNavigator.h>
+#include <TGeoNode.h>
+#include <TGeoVolume.h>
+#include <TGeoMaterial.h>
+#include <TGeoShape.h>
+#include <TFile.h>
+#include <TDirectory.h>
+#include <TH2D.h>
+#include <TStopwatch.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/// The maximum number of consecutive zero steps along a ray
+const G4int gMaxZeroSteps = 10;
+
+}
+
+/// \brief The part of the lego scan performed by one thread
+///
+/// The task scans the grid rows (eta or theta bins) in the range
+/// [fFirstRow, fLastRow) and accumulates the results in its own maps
+/// over the full grid, which are summed when writing the output.
+
+struct TG4LegoScanTask
+{
+  /// The maps per material or volume name
+  typedef std::map<G4String, std::vector<G4double> > Maps;
+
+  TG4LegoScanTask(const TG4LegoScanner* scanner, G4int firstRow, G4int lastRow)
+    : fScanner(scanner),
+      fFirstRow(firstRow),
+      fLastRow(lastRow),
+      fX0(scanner->fNx*scanner->fNphi, 0.),
+      fLambda(scanner->fNx*scanner->fNphi, 0.),
+      fLength(scanner->fNx*scanner->fNphi, 0.),
+      fMaterialX0(),
+      fMaterialLambda(),
+      fMaterialLength(),
+      fVolumeX0(),
+      fVolumeLambda(),
+      fVolumeLength()
+  {}
+
+  void Add(G4int cell, G4double step, G4double radLength, G4double intLength,
+           const G4String& materialName, const G4String& volumeName);
+  void AddToMap(Maps& maps, const G4String& name, G4int cell, G4double value);
+  void AddMaps(Maps& maps, const Maps& other);
+
+  const TG4LegoScanner* fScanner;   ///< the scanner
+  G4int                 fFirstRow;  ///< the first row
+  G4int                 fLastRow;   ///< the last row + 1
+  std::vector<G4double> fX0;        ///< the radiation lengths
+  std::vector<G4double> fLambda;    ///< the nuclear interaction lengths
+  std::vector<G4double> fLength;    ///< the path lengths
+  Maps                  fMaterialX0;    ///< the radiation lengths per material
+  Maps                  fMaterialLambda;///< the interaction lengths per material
+  Maps                  fMaterialLength;///< the path lengths per material
+  Maps                  fVolumeX0;      ///< the radiation lengths per volume
+  Maps                  fVolumeLambda;  ///< the interaction lengths per volume
+  Maps                  fVolumeLength;  ///< the path lengths per volume
+};
+
+//_____________________________________________________________________________
+void TG4LegoScanTask::Add(G4int cell, G4double step,
+                          G4double radLength, G4double intLength,
+                          const G4String& materialName,
+                          const G4String& volumeName)
+{
+/// Accumulate the step in the given material (the lengths in cm).
+
+  G4double x0 = ( radLength > 0. ) ? step/radLength : 0.;
+  G4double lambda = ( intLength > 0. ) ? step/intLength : 0.;
+  fX0[cell] += x0;
+  fLambda[cell] += lambda;
+  fLength[cell] += step;
+
+  if ( fScanner->fIsMaterialMaps ) {
+    AddToMap(fMaterialX0, materialName, cell, x0);
+    AddToMap(fMaterialLambda, materialName, cell, lambda);
+    AddToMap(fMaterialLength, materialName, cell, step);
+  }
+  if ( volumeName.size() ) {
+    AddToMap(fVolumeX0, volumeName, cell, x0);
+    AddToMap(fVolumeLambda, volumeName, cell, lambda);
+    AddToMap(fVolumeLength, volumeName, cell, step);
+  }
+}
+
+//_____________________________________________________________________________
+void TG4LegoScanTask::AddToMap(Maps& maps, const G4String& name,
+                               G4int cell, G4double value)
+{
+/// Add the value in the map with the given name, create the map if needed.
+
+  Maps::iterator it = maps.find(name);
+  if ( it == maps.end() ) {
+    it = maps.insert(
+           Maps::value_type(name, std::vector<G4double>(fX0.size(), 0.))).first;
+  }
+  it->second[cell] += value;
+}
+
+//_____________________________________________________________________________
+void TG4LegoScanTask::AddMaps(Maps& maps, const Maps& other)
+{
+/// Add the other maps in the given maps.
+
+  Maps::const_iterator it;
+  for ( it = other.begin(); it != other.end(); ++it ) {
+    for ( G4int cell=0; cell<G4int(it->second.size()); ++cell ) {
+      AddToMap(maps, it->first, cell, it->second[cell]);
+    }
+  }
+}
+
+//_____________________________________________________________________________
+TG4LegoScanner::TG4LegoScanner()
+  : fMessenger(this),
+    fGridType(kEtaPhi),
+    fNx(50),
+    fXmin(-2.5),
+    fXmax(2.5),
+    fNphi(36),
+    fPhimin(0.),
+    fPhimax(360.*deg),
+    fVertex(),
+    fRmax(0.),
+    fZmax(0.),
+    fNofThreads(1),
+    fFileName("lego.root"),
+    fIsMaterialMaps(false),
+    fVolumeLevel(-1)
+{
+/// Default constructor
+}
+
+//_____________________________________________________________________________
+TG4LegoScanner::~TG4LegoScanner()
+{
+/// Destructor
+}
+
+//
+// static private methods
+//
+
+//_____________________________________________________________________________
+void* TG4LegoScanner::RunRootTask(void* object)
+{
+/// The scan thread function
+
+  TG4LegoScanTask* task = static_cast<TG4LegoScanTask*>(object);
+  task->fScanner->ScanRoot(*task);
+  return 0;
+}
+
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+G4ThreeVector TG4LegoScanner::GetDirection(G4int ix, G4int iphi) const
+{
+/// Return the ray direction in the centre of the given grid cell.
+
+  G4double x = fXmin + (ix + 0.5)*(fXmax - fXmin)/fNx;
+  G4double phi = fPhimin + (iphi + 0.5)*(fPhimax - fPhimin)/fNphi;
+  G4double theta = ( fGridType == kEtaPhi ) ? 2.*std::atan(std::exp(-x)) : x;
+
+  return G4ThreeVector(std::sin(theta)*std::cos(phi),
+                       std::sin(theta)*std::sin(phi),
+                       std::cos(theta));
+}
+
+//_____________________________________________________________________________
+G4double TG4LegoScanner::GetMaxDistance(const G4ThreeVector& direction) const
+{
+/// Return the distance from the vertex to the scan cylinder along
+/// the given direction.
+
+  G4double distance = kInfinity;
+
+  G4double dr2 = direction.perp2();
+  if ( fRmax > 0. && dr2 > 0. ) {
+    // solve |v + t*d| = rmax in the transverse plane
+    G4double b = fVertex.x()*direction.x() + fVertex.y()*direction.y();
+    G4double c = fVertex.perp2() - fRmax*fRmax;
+    G4double t = (-b + std::sqrt(std::max(b*b - dr2*c, 0.)))/dr2;
+    distance = std::min(distance, std::max(t, 0.));
+  }
+
+  if ( fZmax > 0. && direction.z() != 0. ) {
+    G4double zmax = ( direction.z() > 0. ) ? fZmax : -fZmax;
+    G4double t = (zmax - fVertex.z())/direction.z();
+    distance = std::min(distance, std::max(t, 0.));
+  }
+
+  return distance;
+}
+
+//_____________________________________________________________________________
+void TG4LegoScanner::ScanRoot(TG4LegoScanTask& task) const
+{
+/// Scan the task rows with a new TGeo navigator.
+
+  TGeoNavigator* currentNavigator = gGeoManager->GetCurrentNavigator();
+  TGeoNavigator* navigator = gGeoManager->AddNavigator();
+
+  Double_t point[3];
+  Double_t dir[3];
+  for ( G4int ix=task.fFirstRow; ix<task.fLastRow; ++ix ) {
+    for ( G4int iphi=0; iphi<fNphi; ++iphi ) {
+      G4int cell = ix*fNphi + iphi;
+      G4ThreeVector direction = GetDirection(ix, iphi);
+      G4double maxDistance = std::min(GetMaxDistance(direction)/cm, TGeoShape::Big());
+
+      point[0] = fVertex.x()/cm; point[1] = fVertex.y()/cm; point[2] = fVertex.z()/cm;
+      dir[0] = direction.x(); dir[1] = direction.y(); dir[2] = direction.z();
+      navigator->InitTrack(point, dir);
+
+      G4double distance = 0.;
+      G4int nofZeroSteps = 0;
+      while ( ! navigator->IsOutside() && distance < maxDistance ) {
+        TGeoVolume* volume = navigator->GetCurrentVolume();
+        TGeoMaterial* material = volume->GetMaterial();
+        G4String volumeName;
+        G4int level = navigator->GetLevel();
+        if ( fVolumeLevel >= 0 && level >= fVolumeLevel ) {
+          volumeName
+            = navigator->GetMother(level - fVolumeLevel)->GetVolume()->GetName();
+        }
+
+        navigator->FindNextBoundaryAndStep(maxDistance - distance);
+        G4double step = std::min(navigator->GetStep(), maxDistance - distance);
+        if ( step <= 0. ) {
+          if ( ++nofZeroSteps > gMaxZeroSteps ) break;
+          continue;
+        }
+        nofZeroSteps = 0;
+
+        task.Add(cell, step, material->GetRadLen(), material->GetIntLen(),
+                 material->GetName(), volumeName);
+        distance += step;
+      }
+    }
+  }
+
+  gGeoManager->RemoveNavigator(navigator);
+  if ( currentNavigator ) {
+    gGeoManager->SetCurrentNavigator(
+      gGeoManager->GetListOfNavigators()->IndexOf(currentNavigator));
+  }
+}
+
+//_____________________________________________________________________________
+void TG4LegoScanner::ScanGeant4(TG4LegoScanTask& task) const
+{
+/// Scan the task rows with a new G4Navigator.
+
+  G4Navigator navigator;
+  navigator.SetWorldVolume(TG4GeometryServices::Instance()->GetWorld());
+
+  for ( G4int ix=task.fFirstRow; ix<task.fLastRow; ++ix ) {
+    for ( G4int iphi=0; iphi<fNphi; ++iphi ) {
+      G4int cell = ix*fNphi + iphi;
+      G4ThreeVector direction = GetDirection(ix, iphi);
+      G4double maxDistance = GetMaxDistance(direction);
+
+      G4ThreeVector point = fVertex;
+      G4VPhysicalVolume* pv
+        = navigator.LocateGlobalPointAndSetup(point, &direction, false, false);
+
+      G4double distance = 0.;
+      G4int nofZeroSteps = 0;
+      while ( pv && distance < maxDistance ) {
+        G4Material* material = pv->GetLogicalVolume()->GetMaterial();
+        G4String volumeName;
+        if ( fVolumeLevel >= 0 ) {
+          G4TouchableHistory* touchable = navigator.CreateTouchableHistory();
+          G4int depth = touchable->GetHistoryDepth();
+          if ( depth >= fVolumeLevel ) {
+            volumeName
+              = touchable->GetVolume(depth - fVolumeLevel)->GetLogicalVolume()->GetName();
+          }
+          delete touchable;
+        }
+
+        G4double safety;
+        G4double step
+          = navigator.ComputeStep(point, direction, maxDistance - distance, safety);
+        step = std::min(step, maxDistance - distance);
+        if ( step <= 0. && ++nofZeroSteps > gMaxZeroSteps ) break;
+        if ( step > 0. ) nofZeroSteps = 0;
+
+        task.Add(cell, step/cm, material->GetRadlen()/cm,
+                 material->GetNuclearInterLength()/cm,
+                 material->GetName(), volumeName);
+        point += step*direction;
+        distance += step;
+
+        navigator.SetGeometricallyLimitedStep();
+        pv = navigator.LocateGlobalPointAndSetup(point, &direction, true);
+      }
+    }
+  }
+}
+
+//_____________________________________________________________________________
+TH2D* TG4LegoScanner::CreateHistogram(const G4String& name,
+                                      const G4String& title,
+                                      const std::vector<G4double>& values) const
+{
+/// Create the histogram over the scan grid with the given values.
+
+  G4double xunit = ( fGridType == kEtaPhi ) ? 1. : deg;
+  G4String xtitle = ( fGridType == kEtaPhi ) ? "#eta" : "#theta (deg)";
+  TH2D* histogram
+    = new TH2D(name.data(), (title + ";" + xtitle + ";#phi (deg)").data(),
+               fNx, fXmin/xunit, fXmax/xunit, fNphi, fPhimin/deg, fPhimax/deg);
+  for ( G4int ix=0; ix<fNx; ++ix ) {
+    for ( G4int iphi=0; iphi<fNphi; ++iphi ) {
+      histogram->SetBinContent(ix+1, iphi+1, values[ix*fNphi + iphi]);
+    }
+  }
+  return histogram;
+}
+
+//_____________________________________________________________________________
+void TG4LegoScanner::CreateHistograms(const G4String& name,
+                 const G4String& title,
+                 const std::map<G4String, std::vector<G4double> >& maps) const
+{
+/// Create the histograms for all maps; the map name is appended
+/// to the histogram name and title.
+
+  std::map<G4String, std::vector<G4double> >::const_iterator it;
+  for ( it = maps.begin(); it != maps.end(); ++it ) {
+    CreateHistogram(name + it->first, title + it->first, it->second);
+  }
+}
+
+//_____________________________________________________________________________
+void TG4LegoScanner::Write(const std::vector<TG4LegoScanTask*>& tasks) const
+{
+/// Sum the tasks results and write the histograms in the output file.
+
+  TG4LegoScanTask* result = tasks[0];
+  for ( G4int i=1; i<G4int(tasks.size()); ++i ) {
+    TG4LegoScanTask* task = tasks[i];
+    for ( G4int cell=0; cell<G4int(result->fX0.size()); ++cell ) {
+      result->fX0[cell] += task->fX0[cell];
+      result->fLambda[cell] += task->fLambda[cell];
+      result->fLength[cell] += task->fLength[cell];
+    }
+    result->AddMaps(result->fMaterialX0, task->fMaterialX0);
+    result->AddMaps(result->fMaterialLambda, task->fMaterialLambda);
+    result->AddMaps(result->fMaterialLength, task->fMaterialLength);
+    result->AddMaps(result->fVolumeX0, task->fVolumeX0);
+    result->AddMaps(result->fVolumeLambda, task->fVolumeLambda);
+    result->AddMaps(result->fVolumeLength, task->fVolumeLength);
+  }
+
+  // Restore the current directory when the file is closed
+  TDirectory::TContext context;
+  TFile file(fFileName.data(), "recreate");
+  CreateHistogram("lego_x0", "Radiation length (X/X_{0})", result->fX0);
+  CreateHistogram("lego_lambda", "Interaction length (X/#lambda_{I})", result->fLambda);
+  CreateHistogram("lego_length", "Path length (cm)", result->fLength);
+
+  CreateHistograms("lego_x0_mat_",
+                   "Radiation length (X/X_{0}) in material ", result->fMaterialX0);
+  CreateHistograms("lego_lambda_mat_",
+                   "Interaction length (X/#lambda_{I}) in material ",
+                   result->fMaterialLambda);
+  CreateHistograms("lego_length_mat_",
+                   "Path length (cm) in material ", result->fMaterialLength);
+  CreateHistograms("lego_x0_vol_",
+                   "Radiation length (X/X_{0}) in volume ", result->fVolumeX0);
+  CreateHistograms("lego_lambda_vol_",
+                   "Interaction length (X/#lambda_{I}) in volume ",
+                   result->fVolumeLambda);
+  CreateHistograms("lego_length_vol_",
+                   "Path length (cm) in volume ", result->fVolumeLength);
+
+  file.Write();
+  file.Close();
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+void TG4LegoScanner::Scan()
+{
+/// Perform the scan and write the output file.
+/// The Root geometry is scanned with the given number of threads, if TGeo
+/// is not yet used in the multi-threading mode (that is with g4root in
+/// Geant4 MT mode); otherwise the scan runs in the calling thread.
+/// TGeo is switched back to the single-thread mode after the scan.
+
+  G4bool isRoot = gGeoManager && gGeoManager->IsClosed();
+  if ( ! isRoot && ! TG4GeometryServices::Instance()->GetWorld() ) {
+    TG4Globals::Warning(
+      "TG4LegoScanner", "Scan", "Geometry is not yet constructed.");
+    return;
+  }
+
+  TStopwatch timer;
+  G4int nofThreads = 1;
+#ifdef G4MULTITHREADED
+  if ( isRoot && ! gGeoManager->IsMultiThread() ) {
+    nofThreads = std::max(std::min(fNofThreads, fNx), 1);
+  }
+#endif
+
+  std::vector<TG4LegoScanTask*> tasks;
+  for ( G4int i=0; i<nofThreads; ++i ) {
+    tasks.push_back(
+      new TG4LegoScanTask(this, fNx*i/nofThreads, fNx*(i+1)/nofThreads));
+  }
+
+  if ( ! isRoot ) {
+    ScanGeant4(*tasks[0]);
+  }
+  else if ( nofThreads == 1 ) {
+    ScanRoot(*tasks[0]);
+  }
+  else {
+#ifdef G4MULTITHREADED
+    gGeoManager->SetMaxThreads(nofThreads);
+    std::vector<G4Thread> threads(nofThreads);
+    for ( G4int i=0; i<nofThreads; ++i ) {
+      G4THREADCREATE(&threads[i], &TG4LegoScanner::RunRootTask, tasks[i]);
+    }
+    for ( G4int i=0; i<nofThreads; ++i ) {
+      G4THREADJOIN(threads[i]);
+    }
+
+    // Restore the TGeo single-thread mode
+    gGeoManager->ClearThreadsMap();
+    gGeoManager->SetMultiThread(kFALSE);
+#endif
+  }
+
+  Write(tasks);
+
+  for ( G4int i=0; i<nofThreads; ++i ) delete tasks[i];
+
+  G4cout << "Lego scan: " << fNx*fNphi << " rays through "
+         << ( isRoot ? "Root" : "Geant4" ) << " geometry with "
+         << nofThreads << " thread(s) in " << timer.RealTime() << " s, "
+         << "output written in " << fFileName << G4endl;
+}
+
+//_____________________________________________________________________________
+void TG4LegoScanner::SetGrid(GridType gridType,
+                             G4int nx, G4double xmin, G4double xmax,
+                             G4int nphi, G4double phimin, G4double phimax)
+{
+/// Set the scan grid; theta and phi are given in the Geant4 units.
+
+  if ( nx <= 0 || nphi <= 0 || xmin >= xmax || phimin >= phimax ) {
+    TG4Globals::Warning(
+      "TG4LegoScanner", "SetGrid", "Wrong grid parameters, the setting is ignored.");
+    return;
+  }
+
+  fGridType = gridType;
+  fNx = nx;
+  fXmin = xmin;
+  fXmax = xmax;
+  fNphi = nphi;
+  fPhimin = phimin;
+  fPhimax = phimax;
+}
@@ -0,0 +1,204 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2015 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4LegoScannerMessenger.cxx
+/// \brief Implementation of the TG4LegoScannerMessenger class 
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include "TG4LegoScannerMessenger.h"
+#include "TG4LegoScanner.h"
+
+#include <G4UIdirectory.hh>
+#include <G4UIcmdWithAString.hh>
+#include <G4UIcmdWithABool.hh>
+#include <G4UIcmdWithAnInteger.hh>
+#include <G4UIcmdWithADoubleAndUnit.hh>
+#include <G4UIcmdWith3VectorAndUnit.hh>
+#include <G4SystemOfUnits.hh>
+
+#include <sstream>
+
+//_____________________________________________________________________________
+TG4LegoScannerMessenger::TG4LegoScannerMessenger(TG4LegoScanner* legoScanner)
+  : G4UImessenger(),
+    fLegoScanner(legoScanner),
+    fDirectory(0),
+    fSetGridCmd(0),
+    fSetVertexCmd(0),
+    fSetRmaxCmd(0),
+    fSetZmaxCmd(0),
+    fSetNofThreadsCmd(0),
+    fSetFileNameCmd(0),
+    fSetMaterialMapsCmd(0),
+    fSetVolumeLevelCmd(0)
+{
+/// Standard constructor
+
+  fDirectory = new G4UIdirectory("/mcLego/");
+  fDirectory->SetGuidance("Material budget (lego) scan control commands.");
+  fDirectory->SetGuidance("The scan is performed with TVirtualMC::InitLego().");
+
+  CreateSetGridCmd();
+
+  fSetVertexCmd = new G4UIcmdWith3VectorAndUnit("/mcLego/setVertex", this);
+  fSetVertexCmd->SetGuidance("Set the origin of the scan rays.");
+  fSetVertexCmd->SetParameterName("VertexX", "VertexY", "VertexZ", false);
+  fSetVertexCmd->SetDefaultUnit("cm");
+  fSetVertexCmd->SetUnitCategory("Length");
+  fSetVertexCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSetRmaxCmd = new G4UIcmdWithADoubleAndUnit("/mcLego/setRmax", this);
+  fSetRmaxCmd->SetGuidance("Set the radius of the scan cylinder (0 = unlimited).");
+  fSetRmaxCmd->SetParameterName("Rmax", false);
+  fSetRmaxCmd->SetDefaultUnit("cm");
+  fSetRmaxCmd->SetUnitCategory("Length");
+  fSetRmaxCmd->SetRange("Rmax >= 0");
+  fSetRmaxCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSetZmaxCmd = new G4UIcmdWithADoubleAndUnit("/mcLego/setZmax", this);
+  fSetZmaxCmd->SetGuidance("Set the half-length of the scan cylinder (0 = unlimited).");
+  fSetZmaxCmd->SetParameterName("Zmax", false);
+  fSetZmaxCmd->SetDefaultUnit("cm");
+  fSetZmaxCmd->SetUnitCategory("Length");
+  fSetZmaxCmd->SetRange("Zmax >= 0");
+  fSetZmaxCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSetNofThreadsCmd = new G4UIcmdWithAnInteger("/mcLego/setNofThreads", this);
+  fSetNofThreadsCmd->SetGuidance("Set the number of threads scanning the Root geometry.");
+  fSetNofThreadsCmd->SetParameterName("NofThreads", false);
+  fSetNofThreadsCmd->SetRange("NofThreads > 0");
+  fSetNofThreadsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSetFileNameCmd = new G4UIcmdWithAString("/mcLego/setFileName", this);
+  fSetFileNameCmd->SetGuidance("Set the output file name.");
+  fSetFileNameCmd->SetParameterName("FileName", false);
+  fSetFileNameCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSetMaterialMapsCmd = new G4UIcmdWithABool("/mcLego/setMaterialMaps", this);
+  fSetMaterialMapsCmd->SetGuidance("Fill the radiation, interaction and path length maps per material.");
+  fSetMaterialMapsCmd->SetParameterName("MaterialMaps", false);
+  fSetMaterialMapsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSetVolumeLevelCmd = new G4UIcmdWithAnInteger("/mcLego/setVolumeLevel", this);
+  fSetVolumeLevelCmd
+    ->SetGuidance("Fill the radiation, interaction and path length maps per volume");
+  fSetVolumeLevelCmd
+    ->SetGuidance("at the given geometry level");
+  fSetVolumeLevelCmd
+    ->SetGuidance("(0 = world, -1 = no maps per volume).");
+  fSetVolumeLevelCmd->SetParameterName("VolumeLevel", false);
+  fSetVolumeLevelCmd->SetRange("VolumeLevel >= -1");
+  fSetVolumeLevelCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//_____________________________________________________________________________
+TG4LegoScannerMessenger::~TG4LegoScannerMessenger() 
+{
+/// Destructor
+
+  delete fDirectory;
+  delete fSetGridCmd;
+  delete fSetVertexCmd;
+  delete fSetRmaxCmd;
+  delete fSetZmaxCmd;
+  delete fSetNofThreadsCmd;
+  delete fSetFileNameCmd;
+  delete fSetMaterialMapsCmd;
+  delete fSetVolumeLevelCmd;
+}
+
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+void TG4LegoScannerMessenger::CreateSetGridCmd()
+{
+  G4UIparameter* gridType = new G4UIparameter("gridType", 's', false);
+  gridType->SetGuidance("The grid type: eta (eta-phi) or theta (theta-phi).");
+  gridType->SetParameterCandidates("eta theta");
+
+  G4UIparameter* nx = new G4UIparameter("nx", 'i', false);
+  nx->SetGuidance("Number of bins in eta or theta.");
+
+  G4UIparameter* xmin = new G4UIparameter("xmin", 'd', false);
+  xmin->SetGuidance("Minimum eta or theta (deg).");
+
+  G4UIparameter* xmax = new G4UIparameter("xmax", 'd', false);
+  xmax->SetGuidance("Maximum eta or theta (deg).");
+
+  G4UIparameter* nphi = new G4UIparameter("nphi", 'i', false);
+  nphi->SetGuidance("Number of bins in phi.");
+
+  G4UIparameter* phimin = new G4UIparameter("phimin", 'd', false);
+  phimin->SetGuidance("Minimum phi (deg).");
+
+  G4UIparameter* phimax = new G4UIparameter("phimax", 'd', false);
+  phimax->SetGuidance("Maximum phi (deg).");
+
+  fSetGridCmd = new G4UIcommand("/mcLego/setGrid", this);
+  fSetGridCmd->SetGuidance("Define the scan grid.");
+  fSetGridCmd->SetParameter(gridType);
+  fSetGridCmd->SetParameter(nx);
+  fSetGridCmd->SetParameter(xmin);
+  fSetGridCmd->SetParameter(xmax);
+  fSetGridCmd->SetParameter(nphi);
+  fSetGridCmd->SetParameter(phimin);
+  fSetGridCmd->SetParameter(phimax);
+  fSetGridCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+//
+// public methods
+//
+  
+//_____________________________________________________________________________
+void TG4LegoScannerMessenger::SetNewValue(G4UIcommand* command, 
+                                          G4String newValues)
+{
+/// Apply command to the associated object.
+
+  if ( command == fSetGridCmd ) {
+    G4String gridType;
+    G4int nx, nphi;
+    G4double xmin, xmax, phimin, phimax;
+    std::istringstream is(newValues);
+    is >> gridType >> nx >> xmin >> xmax >> nphi >> phimin >> phimax;
+
+    TG4LegoScanner::GridType type = TG4LegoScanner::kEtaPhi;
+    if ( gridType == "theta" ) {
+      type = TG4LegoScanner::kThetaPhi;
+      xmin *= deg;
+      xmax *= deg;
+    }
+    fLegoScanner->SetGrid(type, nx, xmin, xmax, nphi, phimin*deg, phimax*deg);
+  }
+  else if ( command == fSetVertexCmd ) {
+    fLegoScanner->SetVertex(fSetVertexCmd->GetNew3VectorValue(newValues));
+  }
+  else if ( command == fSetRmaxCmd ) {
+    fLegoScanner->SetRmax(fSetRmaxCmd->GetNewDoubleValue(newValues));
+  }
+  else if ( command == fSetZmaxCmd ) {
+    fLegoScanner->SetZmax(fSetZmaxCmd->GetNewDoubleValue(newValues));
+  }
+  else if ( command == fSetNofThreadsCmd ) {
+    fLegoScanner->SetNofThreads(fSetNofThreadsCmd->GetNewIntValue(newValues));
+  }
+  else if ( command == fSetFileNameCmd ) {
+    fLegoScanner->SetFileName(newValues);
+  }
+  else if ( command == fSetMaterialMapsCmd ) {
+    fLegoScanner->SetIsMaterialMaps(fSetMaterialMapsCmd->GetNewBoolValue(newValues));
+  }
+  else if ( command == fSetVolumeLevelCmd ) {
+    fLegoScanner->SetVolumeLevel(fSetVolumeLevelCmd->GetNewIntValue(newValues));
+  }
+}
@@ -753,8 +753,14 @@ Bool_t TG4MCGeometry::GetTransformation(const TString& volumePath,
       return false;
     }
     
-    transform = transform * G4Transform3D(*pvDaughter->GetObjectRotation(),
-                                            pvDaughter->GetObjectTranslation());
+    if ( fGeometryServices->IsConvertedVolume(pvDaughter) ) {
+      transform = transform 
+                * fGeometryServices->GetConvertedCopyTransform(pvDaughter, copyNo);
+    }
+    else {                                                    
+      transform = transform * G4Transform3D(*pvDaughter->GetObjectRotation(),
+                                              pvDaughter->GetObjectTranslation());
+    }
     pvMother = pvDaughter; 
   }   
   
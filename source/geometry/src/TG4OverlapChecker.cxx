@@ -0,0 +1,414 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2015 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4OverlapChecker.cxx
+/// \brief Implementation of the TG4OverlapChecker class
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include "TG4OverlapChecker.h"
+#include "TG4Globals.h"
+
+#include <G4LogicalVolume.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4VSolid.hh>
+#include <G4Material.hh>
+#include <G4AffineTransform.hh>
+#include <G4Threading.hh>
+#include <G4AutoLock.hh>
+#include <Randomize.hh>
+#include <G4SystemOfUnits.hh>
+
+#ifdef G4MULTITHREADED
+#include <G4GeometryWorkspace.hh>
+#include <G4SolidsWorkspace.hh>
+#endif
+
+#include <TMD5.h>
+#include <TSystem.h>
+#include <TStopwatch.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <set>
+#include <sstream>
+
+namespace {
+
+/// The mutex protecting the next mother volume index
+G4Mutex nextMotherMutex = G4MUTEX_INITIALIZER;
+
+/// The report header
+const char* gReportHeader
+  = "# mother\tvolume\tcopyNo\ttype\toverlapping\tcopyNo\tnofPoints\tmaxDepth(mm)";
+
+}
+
+/// \brief The overlap check thread data
+///
+/// The threads take the next mother volume to be checked from the shared
+/// index and write the overlaps found in the output vector element of
+/// this mother volume, so that the report does not depend on the threads
+/// scheduling.
+
+struct TG4OverlapCheckTask
+{
+  const TG4OverlapChecker*              fChecker;   ///< the checker
+  const std::vector<G4LogicalVolume*>*  fMothers;   ///< the mother volumes
+  std::vector< std::vector<G4String> >* fOverlaps;  ///< the overlaps per mother
+  G4int*                                fNext;      ///< the next mother index
+  G4bool                                fIsWorker;  ///< true if in a new thread
+};
+
+//_____________________________________________________________________________
+TG4OverlapChecker::TG4OverlapChecker()
+  : fIsActive(false),
+    fResolution(1000),
+    fTolerance(0.),
+    fNofThreads(1),
+    fReportFileName("overlaps.txt"),
+    fCacheDirectory()
+{
+/// Default constructor
+}
+
+//_____________________________________________________________________________
+TG4OverlapChecker::~TG4OverlapChecker()
+{
+/// Destructor
+}
+
+//
+// static private methods
+//
+
+//_____________________________________________________________________________
+void* TG4OverlapChecker::RunTask(void* object)
+{
+/// The check thread function: check the mother volumes until all are done.
+
+  TG4OverlapCheckTask* task = static_cast<TG4OverlapCheckTask*>(object);
+
+#ifdef G4MULTITHREADED
+  // The geometry objects data are thread-local in the MT mode;
+  // they are initialised from the master ones as in the Geant4 worker threads
+  G4GeometryWorkspace* geometryWorkspace = 0;
+  G4SolidsWorkspace* solidsWorkspace = 0;
+  if ( task->fIsWorker ) {
+    geometryWorkspace = new G4GeometryWorkspace();
+    geometryWorkspace->UseWorkspace();
+    geometryWorkspace->InitialiseWorkspace();
+    solidsWorkspace = new G4SolidsWorkspace();
+    solidsWorkspace->UseWorkspace();
+    solidsWorkspace->InitialiseWorkspace();
+  }
+#endif
+
+  while ( true ) {
+    G4AutoLock lm(&nextMotherMutex);
+    G4int index = (*task->fNext)++;
+    lm.unlock();
+    if ( index >= G4int(task->fMothers->size()) ) break;
+
+    // The seed depends only on the mother volume, so that the result
+    // does not depend on the number of threads and their scheduling
+    G4Random::setTheSeed(index + 1);
+
+    task->fChecker->CheckMother(
+      (*task->fMothers)[index], index, (*task->fOverlaps)[index]);
+  }
+
+#ifdef G4MULTITHREADED
+  if ( geometryWorkspace ) {
+    solidsWorkspace->ReleaseWorkspace();
+    delete solidsWorkspace;
+    geometryWorkspace->ReleaseWorkspace();
+    delete geometryWorkspace;
+  }
+#endif
+
+  return 0;
+}
+
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+void TG4OverlapChecker::CollectMothers(
+                          G4VPhysicalVolume* world,
+                          std::vector<G4LogicalVolume*>& mothers) const
+{
+/// Collect the logical volumes with placed daughters, each once,
+/// starting from the world volume.
+
+  std::set<G4LogicalVolume*> collected;
+  std::vector<G4LogicalVolume*> volumes;
+  volumes.push_back(world->GetLogicalVolume());
+  collected.insert(world->GetLogicalVolume());
+
+  for ( G4int i=0; i<G4int(volumes.size()); ++i ) {
+    G4LogicalVolume* volume = volumes[i];
+    G4bool hasPlacements = false;
+    for ( G4int j=0; j<G4int(volume->GetNoDaughters()); ++j ) {
+      G4VPhysicalVolume* daughter = volume->GetDaughter(j);
+      if ( ! daughter->IsReplicated() ) hasPlacements = true;
+      if ( collected.insert(daughter->GetLogicalVolume()).second ) {
+        volumes.push_back(daughter->GetLogicalVolume());
+      }
+    }
+    if ( hasPlacements ) mothers.push_back(volume);
+  }
+}
+
+//_____________________________________________________________________________
+G4String TG4OverlapChecker::ComputeHash(
+                          const std::vector<G4LogicalVolume*>& mothers) const
+{
+/// Compute the MD5 hash of the checked geometry (the mother volumes,
+/// their daughters solids and placements) and of the check parameters.
+
+  TMD5 md5;
+  std::ostringstream parameters;
+  parameters << fResolution << " " << std::setprecision(17) << fTolerance;
+  md5.Update((const UChar_t*)parameters.str().data(), parameters.str().size());
+
+  for ( G4int i=0; i<G4int(mothers.size()); ++i ) {
+    G4LogicalVolume* mother = mothers[i];
+    std::ostringstream os;
+    os << std::setprecision(17);
+    os << mother->GetName() << "\n";
+    mother->GetSolid()->StreamInfo(os);
+    for ( G4int j=0; j<G4int(mother->GetNoDaughters()); ++j ) {
+      G4VPhysicalVolume* daughter = mother->GetDaughter(j);
+      os << daughter->GetName() << " " << daughter->GetCopyNo() << " "
+         << daughter->GetLogicalVolume()->GetName() << " "
+         << daughter->GetTranslation() << " ";
+      if ( daughter->GetRotation() ) os << *daughter->GetRotation();
+      daughter->GetLogicalVolume()->GetSolid()->StreamInfo(os);
+    }
+    md5.Update((const UChar_t*)os.str().data(), os.str().size());
+  }
+
+  md5.Final();
+  return md5.AsString();
+}
+
+//_____________________________________________________________________________
+void TG4OverlapChecker::CheckMother(G4LogicalVolume* mother, G4int /*index*/,
+                                    std::vector<G4String>& overlaps) const
+{
+/// Check the daughters of the given mother volume as in
+/// G4PVPlacement::CheckOverlaps(): the points generated on each daughter
+/// surface must be inside the mother and outside the sisters, and a point
+/// on each sister surface must be outside the daughter.
+/// The overlaps deeper than the tolerance are added in the output.
+
+  G4VSolid* motherSolid = mother->GetSolid();
+  G4int nofDaughters = mother->GetNoDaughters();
+
+  // The daughters transformations (to the mother frame) and their inverse
+  std::vector<G4AffineTransform> transforms(nofDaughters);
+  std::vector<G4AffineTransform> inverseTransforms(nofDaughters);
+  for ( G4int i=0; i<nofDaughters; ++i ) {
+    G4VPhysicalVolume* daughter = mother->GetDaughter(i);
+    transforms[i]
+      = G4AffineTransform(daughter->GetRotation(), daughter->GetTranslation());
+    inverseTransforms[i] = transforms[i].Inverse();
+  }
+
+  // The number of points and the maximum depth per overlapping volume;
+  // the index nofDaughters is used for the mother
+  std::vector<G4int> nofPoints(nofDaughters + 1);
+  std::vector<G4double> maxDepth(nofDaughters + 1);
+
+  for ( G4int i=0; i<nofDaughters; ++i ) {
+    G4VPhysicalVolume* daughter = mother->GetDaughter(i);
+    if ( daughter->IsReplicated() ) continue;
+    G4VSolid* solid = daughter->GetLogicalVolume()->GetSolid();
+
+    std::fill(nofPoints.begin(), nofPoints.end(), 0);
+    std::fill(maxDepth.begin(), maxDepth.end(), 0.);
+
+    for ( G4int n=0; n<fResolution; ++n ) {
+      G4ThreeVector mp = transforms[i].TransformPoint(solid->GetPointOnSurface());
+
+      // Check the mother
+      if ( motherSolid->Inside(mp) == kOutside ) {
+        G4double depth = motherSolid->DistanceToIn(mp);
+        if ( depth > fTolerance ) {
+          ++nofPoints[nofDaughters];
+          maxDepth[nofDaughters] = std::max(maxDepth[nofDaughters], depth);
+        }
+      }
+
+      // Check the sisters
+      for ( G4int j=0; j<nofDaughters; ++j ) {
+        if ( j == i || mother->GetDaughter(j)->IsReplicated() ) continue;
+        G4VSolid* sisterSolid = mother->GetDaughter(j)->GetLogicalVolume()->GetSolid();
+        G4ThreeVector md = inverseTransforms[j].TransformPoint(mp);
+        if ( sisterSolid->Inside(md) == kInside ) {
+          G4double depth = sisterSolid->DistanceToOut(md);
+          if ( depth > fTolerance ) {
+            ++nofPoints[j];
+            maxDepth[j] = std::max(maxDepth[j], depth);
+          }
+        }
+      }
+    }
+
+    // Check the sisters fully contained in the daughter
+    for ( G4int j=0; j<nofDaughters; ++j ) {
+      if ( j == i || nofPoints[j] || mother->GetDaughter(j)->IsReplicated() ) continue;
+      G4VSolid* sisterSolid = mother->GetDaughter(j)->GetLogicalVolume()->GetSolid();
+      G4ThreeVector mp
+        = transforms[j].TransformPoint(sisterSolid->GetPointOnSurface());
+      G4ThreeVector md = inverseTransforms[i].TransformPoint(mp);
+      if ( solid->Inside(md) == kInside ) {
+        G4double depth = solid->DistanceToOut(md);
+        if ( depth > fTolerance ) {
+          ++nofPoints[j];
+          maxDepth[j] = depth;
+        }
+      }
+    }
+
+    // Add the overlaps found
+    for ( G4int j=0; j<=nofDaughters; ++j ) {
+      if ( ! nofPoints[j] ) continue;
+      G4VPhysicalVolume* other = ( j < nofDaughters ) ? mother->GetDaughter(j) : 0;
+      std::ostringstream os;
+      os << mother->GetName() << "\t"
+         << daughter->GetName() << "\t" << daughter->GetCopyNo() << "\t"
+         << ( other ? "sister" : "mother" ) << "\t"
+         << ( other ? other->GetName() : mother->GetName() ) << "\t"
+         << ( other ? other->GetCopyNo() : -1 ) << "\t"
+         << nofPoints[j] << "\t" << maxDepth[j]/mm;
+      overlaps.push_back(os.str());
+    }
+  }
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+G4int TG4OverlapChecker::Check(G4VPhysicalVolume* world)
+{
+/// Check the overlaps in the geometry starting from the given world volume,
+/// write the report and return the number of overlaps found.
+
+  TStopwatch timer;
+
+  std::vector<G4LogicalVolume*> mothers;
+  CollectMothers(world, mothers);
+
+  // Take the report from the cache if available
+  G4String cacheFileName;
+  if ( fCacheDirectory.size() ) {
+    cacheFileName
+      = fCacheDirectory + "/overlaps_" + ComputeHash(mothers) + ".txt";
+    if ( ! gSystem->AccessPathName(cacheFileName.data(), kReadPermission) ) {
+      gSystem->CopyFile(cacheFileName.data(), fReportFileName.data(), kTRUE);
+      G4int nofOverlaps = 0;
+      std::ifstream input(cacheFileName.data());
+      std::string line;
+      while ( std::getline(input, line) ) {
+        if ( line.size() && line[0] != '#' ) ++nofOverlaps;
+      }
+      G4cout << "Overlaps check: " << nofOverlaps << " overlaps (from cache "
+             << cacheFileName << "), report written in "
+             << fReportFileName << G4endl;
+      return nofOverlaps;
+    }
+  }
+
+  // Check the mother volumes
+  std::vector< std::vector<G4String> > overlaps(mothers.size());
+  G4int next = 0;
+  G4int nofThreads = 1;
+#ifdef G4MULTITHREADED
+  nofThreads = std::max(std::min(fNofThreads, G4int(mothers.size())), 1);
+#endif
+
+  std::vector<TG4OverlapCheckTask> tasks(nofThreads);
+  for ( G4int i=0; i<nofThreads; ++i ) {
+    tasks[i].fChecker = this;
+    tasks[i].fMothers = &mothers;
+    tasks[i].fOverlaps = &overlaps;
+    tasks[i].fNext = &next;
+    tasks[i].fIsWorker = ( nofThreads > 1 );
+  }
+
+  if ( nofThreads == 1 ) {
+    // The check reseeds the random engine of this thread; its state is
+    // saved and restored, so that the simulation random numbers
+    // are not affected
+    std::ostringstream state;
+    G4Random::saveFullState(state);
+    RunTask(&tasks[0]);
+    std::istringstream input(state.str());
+    G4Random::restoreFullState(input);
+  }
+  else {
+#ifdef G4MULTITHREADED
+    std::vector<G4Thread> threads(nofThreads);
+    for ( G4int i=0; i<nofThreads; ++i ) {
+      G4THREADCREATE(&threads[i], &TG4OverlapChecker::RunTask, &tasks[i]);
+    }
+    for ( G4int i=0; i<nofThreads; ++i ) {
+      G4THREADJOIN(threads[i]);
+    }
+#endif
+  }
+
+  // Write the report
+  G4int nofOverlaps = 0;
+  std::ofstream output(fReportFileName.data());
+  output << gReportHeader << std::endl;
+  for ( G4int i=0; i<G4int(overlaps.size()); ++i ) {
+    for ( G4int j=0; j<G4int(overlaps[i].size()); ++j ) {
+      output << overlaps[i][j] << std::endl;
+      ++nofOverlaps;
+    }
+  }
+  output.close();
+
+  // Save the report in the cache via a temporary file,
+  // so that the jobs sharing the cache never read an incomplete file
+  if ( cacheFileName.size() ) {
+    gSystem->mkdir(fCacheDirectory.data(), kTRUE);
+    TString tmpFileName = cacheFileName.data();
+    tmpFileName += ".";
+    tmpFileName += gSystem->GetPid();
+    if ( gSystem->CopyFile(fReportFileName.data(), tmpFileName, kTRUE) != 0 ||
+         gSystem->Rename(tmpFileName, cacheFileName.data()) != 0 ) {
+      TG4Globals::Warning(
+        "TG4OverlapChecker", "Check",
+        TString("Failed to write overlaps cache ") + cacheFileName.data());
+      gSystem->Unlink(tmpFileName);
+    }
+  }
+
+  G4cout << "Overlaps check: " << nofOverlaps << " overlaps in "
+         << mothers.size() << " mother volumes (" << fResolution
+         << " points per volume, " << nofThreads << " threads) in "
+         << timer.RealTime() << " s, report written in "
+         << fReportFileName << G4endl;
+
+  if ( nofOverlaps ) {
+    TString message = "Overlaps found in geometry, see ";
+    message += fReportFileName.data();
+    TG4Globals::Warning("TG4OverlapChecker", "Check", message);
+  }
+
+  return nofOverlaps;
+}
@@ -0,0 +1,56 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2015 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4RegularParameterisation.cxx
+/// \brief Implementation of the TG4RegularParameterisation class
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include "TG4RegularParameterisation.h"
+
+#include <G4VPhysicalVolume.hh>
+
+//_____________________________________________________________________________
+TG4RegularParameterisation::TG4RegularParameterisation(
+                                      const G4ThreeVector& origin,
+                                      const G4ThreeVector& step,
+                                      const G4RotationMatrix* rotation)
+  : G4VPVParameterisation(),
+    fOrigin(origin),
+    fStep(step),
+    fRotation(0)
+{
+/// Standard constructor;
+/// the rotation is copied, no rotation is applied if it is null.
+
+  if ( rotation ) fRotation = new G4RotationMatrix(*rotation);
+}
+
+//_____________________________________________________________________________
+TG4RegularParameterisation::~TG4RegularParameterisation()
+{
+/// Destructor
+
+  delete fRotation;
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+void TG4RegularParameterisation::ComputeTransformation(
+                                     const G4int copyNo,
+                                     G4VPhysicalVolume* physVolume) const
+{
+/// Set the translation and the rotation of the copy with the given number
+
+  physVolume->SetTranslation(GetTranslation(copyNo));
+  physVolume->SetRotation(fRotation);
+}
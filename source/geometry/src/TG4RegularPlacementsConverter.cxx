@@ -0,0 +1,352 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2007 - 2015 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4RegularPlacementsConverter.cxx
+/// \brief Implementation of the TG4RegularPlacementsConverter class
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include "TG4RegularPlacementsConverter.h"
+#include "TG4RegularParameterisation.h"
+#include "TG4GeometryServices.h"
+#include "TG4Globals.h"
+
+#include <G4LogicalVolume.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4PVPlacement.hh>
+#include <G4PVReplica.hh>
+#include <G4PVParameterised.hh>
+#include <G4Box.hh>
+#include <G4SmartVoxelHeader.hh>
+#include <G4SmartVoxelStat.hh>
+#include <G4Timer.hh>
+#include <G4SystemOfUnits.hh>
+#include <voxeldefs.hh>
+
+#include <cmath>
+#include <set>
+
+const G4int    TG4RegularPlacementsConverter::fgkMinNofPlacements = 3;
+const G4double TG4RegularPlacementsConverter::fgkTolerance = 1.e-09*mm;
+
+namespace {
+
+/// Return true if the given rotations are equal; null means no rotation
+G4bool IsSameRotation(const G4RotationMatrix* rotation1,
+                      const G4RotationMatrix* rotation2,
+                      G4double tolerance)
+{
+  G4RotationMatrix identity;
+  const G4RotationMatrix& r1 = rotation1 ? *rotation1 : identity;
+  const G4RotationMatrix& r2 = rotation2 ? *rotation2 : identity;
+
+  return r1.isNear(r2, tolerance);
+}
+
+}
+
+//_____________________________________________________________________________
+TG4RegularPlacementsConverter::TG4RegularPlacementsConverter()
+  : fIsActive(false),
+    fFirstCopyNo(1),
+    fParameterisations()
+{
+/// Default constructor.
+/// The first copy number is 1 as the copy numbers of the replicated volumes
+/// returned to VMC are incremented by 1 with the geomRootToGeant4 option.
+}
+
+//_____________________________________________________________________________
+TG4RegularPlacementsConverter::~TG4RegularPlacementsConverter()
+{
+/// Destructor
+
+  for ( G4int i=0; i<G4int(fParameterisations.size()); ++i )
+    delete fParameterisations[i];
+}
+
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+G4bool TG4RegularPlacementsConverter::IsRegular(
+                                 G4LogicalVolume* mother,
+                                 std::vector<G4VPhysicalVolume*>& placements,
+                                 G4ThreeVector& step) const
+{
+/// Return true if all daughters of the given mother are the regular
+/// placements of the same volume; fill the placements ordered by their
+/// copy numbers and the step between their positions.
+
+  G4int nofDaughters = mother->GetNoDaughters();
+  if ( nofDaughters < fgkMinNofPlacements ) return false;
+
+  G4VPhysicalVolume* first = mother->GetDaughter(0);
+  placements.assign(nofDaughters, 0);
+  for ( G4int i=0; i<nofDaughters; ++i ) {
+    G4VPhysicalVolume* daughter = mother->GetDaughter(i);
+    if ( daughter->IsReplicated() ||
+         daughter->GetLogicalVolume() != first->GetLogicalVolume() ||
+         daughter->GetName() != first->GetName() ||
+         ! IsSameRotation(daughter->GetRotation(), first->GetRotation(),
+                          fgkTolerance) ) return false;
+
+    // The copy numbers must be fFirstCopyNo, fFirstCopyNo + 1, ...
+    G4int index = daughter->GetCopyNo() - fFirstCopyNo;
+    if ( index < 0 || index >= nofDaughters || placements[index] ) return false;
+    placements[index] = daughter;
+  }
+
+  // The positions must be in arithmetic progression
+  G4ThreeVector origin = placements[0]->GetTranslation();
+  step = placements[1]->GetTranslation() - origin;
+  if ( step.mag() < fgkTolerance ) return false;
+
+  for ( G4int i=2; i<nofDaughters; ++i ) {
+    G4ThreeVector position = origin + G4double(i)*step;
+    if ( ( placements[i]->GetTranslation() - position ).mag() > fgkTolerance )
+      return false;
+  }
+
+  return true;
+}
+
+//_____________________________________________________________________________
+EAxis TG4RegularPlacementsConverter::GetAxis(const G4ThreeVector& step) const
+{
+/// Return the Cartesian axis of the given step, or kUndefined if the step
+/// is not parallel with any of them.
+
+  if ( std::fabs(step.y()) < fgkTolerance && std::fabs(step.z()) < fgkTolerance )
+    return kXAxis;
+
+  if ( std::fabs(step.x()) < fgkTolerance && std::fabs(step.z()) < fgkTolerance )
+    return kYAxis;
+
+  if ( std::fabs(step.x()) < fgkTolerance && std::fabs(step.y()) < fgkTolerance )
+    return kZAxis;
+
+  return kUndefined;
+}
+
+//_____________________________________________________________________________
+G4bool TG4RegularPlacementsConverter::IsReplica(
+                                 G4LogicalVolume* mother,
+                                 const std::vector<G4VPhysicalVolume*>& placements,
+                                 const G4ThreeVector& step, EAxis axis) const
+{
+/// Return true if the given regular placements can be converted in
+/// a replica: the not rotated boxes slicing completely a box mother
+/// along the given axis.
+
+  if ( axis == kUndefined ) return false;
+
+  G4VPhysicalVolume* first = placements[0];
+  if ( ! IsSameRotation(first->GetRotation(), 0, fgkTolerance) ) return false;
+
+  G4VSolid* motherSolid = mother->GetSolid();
+  G4VSolid* solid = first->GetLogicalVolume()->GetSolid();
+  if ( motherSolid->GetEntityType() != "G4Box" ||
+       solid->GetEntityType() != "G4Box" ) return false;
+
+  G4Box* motherBox = static_cast<G4Box*>(motherSolid);
+  G4Box* box = static_cast<G4Box*>(solid);
+  G4ThreeVector motherHalfLength(motherBox->GetXHalfLength(),
+                                 motherBox->GetYHalfLength(),
+                                 motherBox->GetZHalfLength());
+  G4ThreeVector halfLength(box->GetXHalfLength(),
+                           box->GetYHalfLength(),
+                           box->GetZHalfLength());
+
+  // The replicas are placed at -width*(nofReplicas-1)/2 + copyNo*width
+  G4double width = step[axis];
+  G4int nofReplicas = placements.size();
+  if ( width <= 0. ||
+       std::fabs(nofReplicas*width - 2.*motherHalfLength[axis]) > fgkTolerance )
+    return false;
+
+  G4ThreeVector origin = first->GetTranslation();
+  for ( G4int i=0; i<3; ++i ) {
+    if ( i == axis ) {
+      if ( std::fabs(2.*halfLength[i] - width) > fgkTolerance ||
+           std::fabs(origin[i] + 0.5*(nofReplicas-1)*width) > fgkTolerance )
+        return false;
+    }
+    else {
+      if ( std::fabs(halfLength[i] - motherHalfLength[i]) > fgkTolerance ||
+           std::fabs(origin[i]) > fgkTolerance )
+        return false;
+    }
+  }
+
+  return true;
+}
+
+//_____________________________________________________________________________
+void TG4RegularPlacementsConverter::MeasureVoxels(
+                                 const std::vector<G4LogicalVolume*>& volumes,
+                                 G4double& time, G4double& memory) const
+{
+/// Build the smart voxels of the given volumes as when closing geometry
+/// and add their build time and memory in the output parameters.
+/// The voxels are deleted, they are built again when geometry is closed.
+
+  for ( G4int i=0; i<G4int(volumes.size()); ++i ) {
+    G4LogicalVolume* volume = volumes[i];
+    G4int nofDaughters = volume->GetNoDaughters();
+    if ( nofDaughters < kMinVoxelVolumesLevel1 &&
+         ! ( nofDaughters == 1 && volume->GetDaughter(0)->IsReplicated() ) )
+      continue;
+
+    G4Timer timer;
+    timer.Start();
+    G4SmartVoxelHeader* header = new G4SmartVoxelHeader(volume);
+    timer.Stop();
+
+    G4SmartVoxelStat stat(volume, header,
+                          timer.GetSystemElapsed(), timer.GetUserElapsed());
+    time += stat.GetTotalTime();
+    memory += stat.GetMemoryUse();
+
+    delete header;
+  }
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+G4int TG4RegularPlacementsConverter::Convert(G4VPhysicalVolume* world,
+                                             G4int verboseLevel)
+{
+/// Replace the regular placements in the geometry starting from the given
+/// world volume with the replicas or parameterised volumes; return the
+/// number of the replaced placements.
+/// With verbose level > 1, the smart voxels of the converted mother volumes
+/// are built before and after the conversion to report the savings.
+
+  G4Timer timer;
+  timer.Start();
+
+  // Collect the mother volumes with the regular placements,
+  // each logical volume is processed once
+  std::vector<G4LogicalVolume*> mothers;
+  std::vector< std::vector<G4VPhysicalVolume*> > placementsList;
+  std::vector<G4ThreeVector> steps;
+
+  std::set<G4LogicalVolume*> collected;
+  std::vector<G4LogicalVolume*> volumes;
+  volumes.push_back(world->GetLogicalVolume());
+  collected.insert(world->GetLogicalVolume());
+
+  for ( G4int i=0; i<G4int(volumes.size()); ++i ) {
+    G4LogicalVolume* volume = volumes[i];
+    for ( G4int j=0; j<G4int(volume->GetNoDaughters()); ++j ) {
+      G4LogicalVolume* daughter = volume->GetDaughter(j)->GetLogicalVolume();
+      if ( collected.insert(daughter).second ) volumes.push_back(daughter);
+    }
+
+    std::vector<G4VPhysicalVolume*> placements;
+    G4ThreeVector step;
+    if ( IsRegular(volume, placements, step) ) {
+      mothers.push_back(volume);
+      placementsList.push_back(placements);
+      steps.push_back(step);
+    }
+  }
+
+  G4double voxelsTimeBefore = 0.;
+  G4double voxelsMemoryBefore = 0.;
+  if ( verboseLevel > 1 )
+    MeasureVoxels(mothers, voxelsTimeBefore, voxelsMemoryBefore);
+
+  // Replace the placements
+  G4int nofPlacements = 0;
+  G4int nofReplicas = 0;
+  G4int nofParameterised = 0;
+  for ( G4int i=0; i<G4int(mothers.size()); ++i ) {
+    G4LogicalVolume* mother = mothers[i];
+    const std::vector<G4VPhysicalVolume*>& placements = placementsList[i];
+    G4VPhysicalVolume* first = placements[0];
+    G4String name = first->GetName();
+    G4LogicalVolume* volume = first->GetLogicalVolume();
+    G4int nofCopies = placements.size();
+    EAxis axis = GetAxis(steps[i]);
+    G4bool isReplica = IsReplica(mother, placements, steps[i], axis);
+
+    // The parameterisation copies the placement data before its deletion
+    TG4RegularParameterisation* parameterisation = 0;
+    if ( ! isReplica ) {
+      parameterisation
+        = new TG4RegularParameterisation(
+                first->GetTranslation(), steps[i], first->GetRotation());
+      fParameterisations.push_back(parameterisation);
+    }
+
+    for ( G4int j=0; j<nofCopies; ++j ) {
+      mother->RemoveDaughter(placements[j]);
+      delete placements[j];
+    }
+
+    G4VPhysicalVolume* converted = 0;
+    if ( isReplica ) {
+      converted 
+        = new G4PVReplica(name, volume, mother, axis, nofCopies, steps[i][axis]);
+      ++nofReplicas;
+    }
+    else {
+      converted
+        = new G4PVParameterised(name, volume, mother, axis, nofCopies,
+                                parameterisation);
+      ++nofParameterised;
+    }
+    TG4GeometryServices::Instance()->AddConvertedVolume(converted);
+
+    nofPlacements += nofCopies;
+
+    if ( verboseLevel > 2 ) {
+      G4cout << "Converted " << nofCopies << " placements of " << name
+             << " in " << mother->GetName()
+             << ( isReplica ? " in a replica" : " in a parameterised volume" )
+             << G4endl;
+    }
+  }
+
+  timer.Stop();
+
+  if ( verboseLevel > 0 ) {
+    G4cout << "Converted " << nofPlacements << " regular placements in "
+           << nofReplicas << " replicas and " << nofParameterised
+           << " parameterised volumes in " << timer.GetRealElapsed() << " s"
+           << G4endl;
+    G4cout << "  physical volumes memory saved (estimated from the object sizes): "
+           << ( G4double(nofPlacements)*sizeof(G4PVPlacement)
+                - nofReplicas*sizeof(G4PVReplica)
+                - nofParameterised*( sizeof(G4PVParameterised)
+                                     + sizeof(TG4RegularParameterisation) ) )/1024.
+           << " kB" << G4endl;
+  }
+
+  if ( verboseLevel > 1 ) {
+    G4double voxelsTimeAfter = 0.;
+    G4double voxelsMemoryAfter = 0.;
+    MeasureVoxels(mothers, voxelsTimeAfter, voxelsMemoryAfter);
+
+    G4cout << "  smart voxels memory saved: "
+           << ( voxelsMemoryBefore - voxelsMemoryAfter )/1024. << " kB ("
+           << voxelsMemoryBefore/1024. << " kB before conversion)" << G4endl;
+    G4cout << "  smart voxels build time saved: "
+           << voxelsTimeBefore - voxelsTimeAfter << " s ("
+           << voxelsTimeBefore << " s before conversion)" << G4endl;
+  }
+
+  return nofPlacements;
+}
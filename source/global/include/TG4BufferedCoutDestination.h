@@ -0,0 +1,87 @@
+#ifndef TG4_BUFFERED_COUT_DESTINATION_H
+#define TG4_BUFFERED_COUT_DESTINATION_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2017 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4BufferedCoutDestination.h
+/// \brief Definition of the TG4BufferedCoutDestination class 
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include <G4coutDestination.hh>
+#include <globals.hh>
+
+#include <deque>
+#include <string>
+#include <utility>
+
+/// \ingroup global
+/// \brief The buffered per-thread destination of G4cout and G4cerr
+///
+/// The output of the thread is collected in a thread-local buffer
+/// (with the "G4WT<id> > " prefix at the beginning of each line) 
+/// and, when the buffer is full, it is passed to a writer thread 
+/// shared by all destinations, which writes it to the standard output,
+/// so that the threads do not wait for each other when printing.
+/// The error output is passed to the writer immediately, after flushing
+/// the output collected before.
+/// The writer thread is started with the first destination and it is 
+/// stopped, after writing all pending output, with the deletion
+/// of the last destination.
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+class TG4BufferedCoutDestination : public G4coutDestination
+{
+  public:
+    TG4BufferedCoutDestination(G4int threadId, 
+                               G4int bufferSize = fgkDefaultBufferSize);
+    virtual ~TG4BufferedCoutDestination();
+
+    // methods
+    virtual G4int ReceiveG4cout(const G4String& message);
+    virtual G4int ReceiveG4cerr(const G4String& message);
+
+    void Flush();
+
+  private:
+    /// Not implemented
+    TG4BufferedCoutDestination();
+    /// Not implemented
+    TG4BufferedCoutDestination(const TG4BufferedCoutDestination& right);
+    /// Not implemented
+    TG4BufferedCoutDestination& operator=(
+                                  const TG4BufferedCoutDestination& right);
+
+    // static methods
+    static void* RunWriter(void* object);
+    static void  Write(const std::string& text, G4bool isError);
+
+    // methods
+    void Append(const G4String& message);
+
+    // static data members
+    /// The default buffer size (in characters)
+    static const G4int fgkDefaultBufferSize;
+    /// The output waiting for the writer (text, isError)
+    static std::deque< std::pair<std::string, G4bool> >  fgQueue;
+    /// The number of existing destinations
+    static G4int   fgNofDestinations;
+    /// Info whether the writer thread should stop
+    static G4bool  fgIsStopping;
+
+    // data members
+    G4String     fPrefix;     ///< the line prefix
+    G4int        fBufferSize; ///< the buffer size (in characters)
+    std::string  fBuffer;     ///< the collected output
+    G4bool       fIsNewLine;  ///< info whether the next message starts a line
+};
+
+#endif //TG4_BUFFERED_COUT_DESTINATION_H
@@ -80,6 +80,9 @@ class TG4Globals
                         const TString& text);
       // Global warning function prints string to cerr
 
+    static void   SetMaxWarnings(G4int maxWarnings);
+    static G4int  GetMaxWarnings();
+    static void   PrintWarningsSummary();
 
     static TString Endl();
     static void AppendNumberToString(G4String& string, G4int number);
@@ -88,16 +91,28 @@ class TG4Globals
     static G4String Help();
     
     static G4String  GetToken(Int_t i, const TString& s);
+    static G4double  GetThreadCpuTime();
 
   private:
     TG4Globals();  
 
     static const TString fgkEndl;           ///< Special endl
     static const char    fgkTokenSeparator; ///< Separator in GetToken() method
+
+    /// The maximum number of printed warnings per method and thread (0 = no limit)
+    static G4int  fgMaxWarnings;
+    /// The numbers of warnings per method (className::methodName) 
+    static G4ThreadLocal std::map<TString, G4int>* fgWarningCounts;
 };  
 
 // inline functions
 
+inline G4int  TG4Globals::GetMaxWarnings()
+{
+  /// Return the maximum number of printed warnings per method and thread
+  return fgMaxWarnings;
+}  
+
 inline TString  TG4Globals::Endl()
 {
   /// Special endl which is then reformatted in Warning and Exception
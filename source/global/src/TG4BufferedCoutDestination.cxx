@@ -0,0 +1,224 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2017 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4BufferedCoutDestination.cxx
+/// \brief Implementation of the TG4BufferedCoutDestination class 
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include "TG4BufferedCoutDestination.h"
+
+#include <G4AutoLock.hh>
+#include <G4Threading.hh>
+
+#include <iostream>
+#include <sstream>
+
+// mutex, condition and writer thread in a file scope
+
+namespace {
+  //Mutex to lock the writer queue
+  G4Mutex queueMutex = G4MUTEX_INITIALIZER;
+#ifdef G4MULTITHREADED
+  //Condition to signal a change of the writer queue
+  G4Condition queueChanged = G4CONDITION_INITIALIZER;
+  //The writer thread
+  G4Thread writerThread;
+#endif
+}
+
+const G4int TG4BufferedCoutDestination::fgkDefaultBufferSize = 100000;
+std::deque< std::pair<std::string, G4bool> >  
+                        TG4BufferedCoutDestination::fgQueue;
+G4int   TG4BufferedCoutDestination::fgNofDestinations = 0;
+G4bool  TG4BufferedCoutDestination::fgIsStopping = false;
+
+//_____________________________________________________________________________
+TG4BufferedCoutDestination::TG4BufferedCoutDestination(G4int threadId,
+                                                       G4int bufferSize)
+  : G4coutDestination(),
+    fPrefix(),
+    fBufferSize(bufferSize),
+    fBuffer(),
+    fIsNewLine(true)
+{
+/// Standard constructor
+/// \param threadId    The thread Id used in the line prefix
+/// \param bufferSize  The number of characters collected before passing
+///                    the output to the writer thread
+
+  std::ostringstream prefix;
+  prefix << "G4WT" << threadId << " > ";
+  fPrefix = prefix.str();
+
+  fBuffer.reserve(fBufferSize + 1000);
+
+  G4AutoLock lm(&queueMutex);
+  if ( fgNofDestinations++ == 0 ) {
+    fgIsStopping = false;
+#ifdef G4MULTITHREADED
+    G4THREADCREATE(&writerThread, &TG4BufferedCoutDestination::RunWriter, 0);
+#endif
+  }
+  lm.unlock();
+}
+
+//_____________________________________________________________________________
+TG4BufferedCoutDestination::~TG4BufferedCoutDestination()
+{
+/// Destructor: flush the collected output and, with the last destination,
+/// stop the writer thread.
+
+  Flush();
+
+  G4AutoLock lm(&queueMutex);
+  G4bool isLast = ( --fgNofDestinations == 0 );
+  if ( isLast ) {
+    fgIsStopping = true;
+#ifdef G4MULTITHREADED
+    G4CONDITIONBROADCAST(&queueChanged);
+#endif
+  }
+  lm.unlock();
+
+#ifdef G4MULTITHREADED
+  if ( isLast ) G4THREADJOIN(writerThread);
+#endif
+}
+
+//
+// static private methods
+//
+
+//_____________________________________________________________________________
+void* TG4BufferedCoutDestination::RunWriter(void* /*object*/)
+{
+/// The writer thread function: write the queued output until the stop 
+/// is requested and there is no more output.
+
+#ifdef G4MULTITHREADED
+  G4AutoLock lm(&queueMutex);
+  while ( true ) {
+    while ( fgQueue.empty() && ! fgIsStopping ) {
+      G4CONDITIONWAIT(&queueChanged, &queueMutex);
+    }
+    if ( fgQueue.empty() ) break;
+
+    std::pair<std::string, G4bool> output;
+    output.first.swap(fgQueue.front().first);
+    output.second = fgQueue.front().second;
+    fgQueue.pop_front();
+
+    // write without holding the lock, so that the threads can queue
+    // their output in the meantime
+    lm.unlock();
+    Write(output.first, output.second);
+    lm.lock();
+  }
+  lm.unlock();
+#endif
+
+  return 0;
+}
+
+//_____________________________________________________________________________
+void TG4BufferedCoutDestination::Write(const std::string& text, G4bool isError)
+{
+/// Write the text to the standard output or error
+
+  if ( isError ) {
+    std::cerr << text << std::flush;
+  }
+  else {
+    std::cout << text << std::flush;
+  }
+}
+
+//
+// private methods
+//
+
+//_____________________________________________________________________________
+void TG4BufferedCoutDestination::Append(const G4String& message)
+{
+/// Append the message to the buffer and add the prefix
+/// at the beginning of each line.
+
+  std::string::size_type pos = 0;
+  while ( pos < message.length() ) {
+    if ( fIsNewLine ) fBuffer += fPrefix;
+
+    std::string::size_type end = message.find('\n', pos);
+    fIsNewLine = ( end != std::string::npos );
+    if ( ! fIsNewLine ) end = message.length() - 1;
+
+    fBuffer.append(message, pos, end - pos + 1);
+    pos = end + 1;
+  }
+}
+
+//
+// public methods
+//
+
+//_____________________________________________________________________________
+G4int TG4BufferedCoutDestination::ReceiveG4cout(const G4String& message)
+{
+/// Collect the message; pass the buffer to the writer when it is full.
+
+  Append(message);
+  if ( G4int(fBuffer.size()) >= fBufferSize ) Flush();
+
+  return 0;
+}
+
+//_____________________________________________________________________________
+G4int TG4BufferedCoutDestination::ReceiveG4cerr(const G4String& message)
+{
+/// Pass the collected output and the error message to the writer.
+
+  Flush();
+  Append(message);
+
+  G4AutoLock lm(&queueMutex);
+#ifdef G4MULTITHREADED
+  fgQueue.push_back(std::pair<std::string, G4bool>(std::string(), true));
+  fgQueue.back().first.swap(fBuffer);
+  G4CONDITIONBROADCAST(&queueChanged);
+#else
+  Write(fBuffer, true);
+#endif
+  lm.unlock();
+
+  fBuffer.clear();
+  fBuffer.reserve(fBufferSize + 1000);
+
+  return 0;
+}
+
+//_____________________________________________________________________________
+void TG4BufferedCoutDestination::Flush()
+{
+/// Pass the collected output to the writer thread.
+
+  if ( fBuffer.empty() ) return;
+
+  G4AutoLock lm(&queueMutex);
+#ifdef G4MULTITHREADED
+  fgQueue.push_back(std::pair<std::string, G4bool>(std::string(), false));
+  fgQueue.back().first.swap(fBuffer);
+  G4CONDITIONBROADCAST(&queueChanged);
+#else
+  Write(fBuffer, false);
+#endif
+  lm.unlock();
+
+  fBuffer.clear();
+  fBuffer.reserve(fBufferSize + 1000);
+}
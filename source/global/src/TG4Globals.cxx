@@ -15,9 +15,12 @@
 #include "TG4Globals.h"
 
 #include <stdlib.h>
+#include <ctime>
 
 const TString TG4Globals::fgkEndl = "x\n";
 const char    TG4Globals::fgkTokenSeparator = '+';
+G4int         TG4Globals::fgMaxWarnings = 0;
+G4ThreadLocal std::map<TString, G4int>* TG4Globals::fgWarningCounts = 0;
 
 //_____________________________________________________________________________
 TG4Globals::~TG4Globals() 
@@ -49,16 +52,61 @@ void TG4Globals::Warning(const TString& className,const TString& methodName,
                          const TString& text)
 {
 /// Print warning message.
+/// When the maximum number of warnings is set (via /mcControl/maxWarnings),
+/// only the first fgMaxWarnings warnings from the same method are printed
+/// on each thread; the further warnings are only counted and reported
+/// in PrintWarningsSummary() at the end of run.
+
+  if ( ! fgWarningCounts ) fgWarningCounts = new std::map<TString, G4int>();
+
+  TString method = className + "::" + methodName;
+  G4int count = ++(*fgWarningCounts)[method];
+  if ( fgMaxWarnings > 0 && count > fgMaxWarnings ) return;
 
   TString newText = "++++  TG4Warning:  ++++x\n";
-  newText += className + "::" + methodName + ":x\n";
+  newText += method + ":x\n";
   newText += text + "\n";
+  if ( fgMaxWarnings > 0 && count == fgMaxWarnings ) {
+    newText += "(Further warnings from this method will be suppressed.)\n";
+  }
   newText += "+++++++++++++++++++++++";
   newText.ReplaceAll("x\n", "\n    ");
   
   G4cerr << newText.Data() << G4endl << G4endl;   
 }
 
+//_____________________________________________________________________________
+void TG4Globals::SetMaxWarnings(G4int maxWarnings)
+{
+/// Set the maximum number of printed warnings per method and thread
+/// (0 = no limit, the default).
+
+  fgMaxWarnings = maxWarnings;
+}
+
+//_____________________________________________________________________________
+void TG4Globals::PrintWarningsSummary()
+{
+/// Print the numbers of warnings suppressed on this thread since
+/// the last call and reset the counters.
+
+  if ( ! fgWarningCounts ) return;
+
+  G4bool isFirst = true;
+  std::map<TString, G4int>::const_iterator it;
+  for ( it = fgWarningCounts->begin(); it != fgWarningCounts->end(); ++it ) {
+    if ( fgMaxWarnings <= 0 || it->second <= fgMaxWarnings ) continue;
+
+    if ( isFirst ) {
+      G4cout << "TG4Warning summary (suppressed warnings):" << G4endl;
+      isFirst = false;
+    }  
+    G4cout << "    " << it->first.Data() << ": " 
+           << it->second - fgMaxWarnings << " of " << it->second << G4endl;
+  }
+  fgWarningCounts->clear();
+}
+
 //_____________________________________________________________________________
 void TG4Globals::AppendNumberToString(G4String& s, G4int a)
 {
@@ -153,3 +201,18 @@ G4String TG4Globals::GetToken(Int_t i, const TString& s)
   else
     return tokens[i];
 }        
+
+//_____________________________________________________________________________
+G4double TG4Globals::GetThreadCpuTime()
+{
+/// Return the CPU time (in s) of the calling thread;
+/// the process CPU time is used if not available.
+
+#ifdef __linux__
+  timespec time;
+  if ( clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) == 0 ) {
+    return time.tv_sec + time.tv_nsec * 1e-09;
+  }  
+#endif
+  return double(std::clock())/CLOCKS_PER_SEC;
+}
@@ -675,8 +675,9 @@ void  TG4PhysicsManager::DefineParticles()
 /// Add particles with standard PDG = 0 
 /// and user defined particles to TDatabasePDG
 /// and maps them to G4 particles objects.
+/// The particles name map is shared and so it is filled only on master.
 
-  fParticlesManager->DefineParticles();
+  if ( ! G4Threading::IsWorkerThread() ) fParticlesManager->DefineParticles();
   TG4StateManager::Instance()->SetNewState(kAddIons);
   TVirtualMCApplication::Instance()->AddIons();
   TG4StateManager::Instance()->SetNewState(kNotInApplication);
@@ -0,0 +1,68 @@
+#ifndef TG4_PARALLEL_MERGER_H
+#define TG4_PARALLEL_MERGER_H
+
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2017 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4ParallelMerger.h
+/// \brief Definition of the TG4ParallelMerger class 
+///
+/// \author I. Hrivnacova; IPN Orsay
+
+#include <globals.hh>
+
+#include <vector>
+
+class TVirtualMCApplication;
+
+/// \ingroup run
+/// \brief Pairwise (tree-structured) merging of worker applications 
+/// at the end of run (used in MT mode only)
+///
+/// In each round, the worker with rank r, where r is a multiple of 2*step,
+/// merges the application of the worker r+step, once this one has 
+/// completed the merging of its own subtree, via 
+/// TVirtualMCApplication::Merge(). The merging is thus performed in 
+/// log2(N) parallel rounds and only the worker with rank 0 merges the 
+/// result in the master application. 
+///
+/// The user application Merge() function has to support merging 
+/// a worker application into another worker application.
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+class TG4ParallelMerger
+{
+  public:
+    virtual ~TG4ParallelMerger();
+
+    // static methods
+    static void Reset(G4int nofWorkers);
+    static void Merge(TVirtualMCApplication* localApplication,
+                      TVirtualMCApplication* masterApplication);
+
+  private:
+    /// Not implemented
+    TG4ParallelMerger();
+    /// Not implemented
+    TG4ParallelMerger(const TG4ParallelMerger& right);
+    /// Not implemented
+    TG4ParallelMerger& operator=(const TG4ParallelMerger& right);
+
+    // static data members
+
+    /// The worker applications (indexed by the thread rank)
+    static std::vector<TVirtualMCApplication*>  fgApplications;
+
+    /// The number of applications merged in each worker application 
+    /// (0 if the worker has not yet reached the merging)
+    static std::vector<G4int>  fgNofMerged;
+};
+
+#endif //TG4_PARALLEL_MERGER_H
@@ -48,6 +48,10 @@ class TG4RunAction : public G4UserRunAction,
     void SetSaveRandomStatus(G4bool saveRandomStatus);
     void SetReadRandomStatus(G4bool readRandomStatus);
     void SetRandomStatusFile(G4String RandomStatusFile);
+    void SetParallelMerge(G4bool parallelMerge);
+
+    // get methods
+    G4bool GetParallelMerge() const;
 
   private:
     /// Not implemented
@@ -67,6 +71,7 @@ class TG4RunAction : public G4UserRunAction,
     G4bool    fSaveRandomStatus; ///< control for saving random engine status
     G4bool    fReadRandomStatus; ///< control for reading random engine status
     G4String  fRandomStatusFile; ///< random engine status file name
+    G4bool    fParallelMerge;    ///< control for parallel merging of workers data
 };
 
 inline void TG4RunAction::SetSaveRandomStatus(G4bool saveRandomStatus) {
@@ -84,4 +89,15 @@ inline void TG4RunAction::SetRandomStatusFile(G4String RandomStatusFile) {
   fRandomStatusFile = RandomStatusFile;
 }
 
+inline void TG4RunAction::SetParallelMerge(G4bool parallelMerge) {
+  /// Set option for the pairwise parallel merging of workers data 
+  /// at the end of run (MT mode only)
+  fParallelMerge = parallelMerge;
+}
+
+inline G4bool TG4RunAction::GetParallelMerge() const {
+  /// Return the option for the parallel merging of workers data
+  return fParallelMerge;
+}
+
 #endif //TG4_RUN_ACTION_H
@@ -30,6 +30,7 @@ class G4UIcmdWithABool;
 /// - /mcRun/saveRandom [true|false]
 /// - /mcRun/readRandom [true|false]
 /// - /mcRun/setRandomFile fileName
+/// - /mcRun/parallelMerge [true|false]
 ///
 /// \author I. Hrivnacova; IPN, Orsay
 
@@ -56,6 +57,7 @@ class TG4RunActionMessenger: public G4UImessenger
     G4UIcmdWithABool*    fSaveRandomStatusCmd; ///< command: saveRandom
     G4UIcmdWithABool*    fReadRandomStatusCmd; ///< command: readRandom
     G4UIcmdWithAString*  fRandomStatusFileCmd; ///< command: setRandomFile
+    G4UIcmdWithABool*    fParallelMergeCmd;    ///< command: parallelMerge
 };
 
 #endif //TG4_RUN_ACTION_MESSENGER_H
@@ -91,6 +93,7 @@ class G4UIcmdWithABool;
 /// - /mcRun/saveRandom [true|false]
 /// - /mcRun/readRandom [true|false]
 /// - /mcRun/setRandomFile fileName
+/// - /mcRun/parallelMerge [true|false]
 ///
 /// \author I. Hrivnacova; IPN, Orsay
 
@@ -117,6 +120,7 @@ class TG4RunActionMessenger: public G4UImessenger
     G4UIcmdWithABool*    fSaveRandomStatusCmd; ///< command: saveRandom
     G4UIcmdWithABool*    fReadRandomStatusCmd; ///< command: readRandom
     G4UIcmdWithAString*  fRandomStatusFileCmd; ///< command: setRandomFile
+    G4UIcmdWithABool*    fParallelMergeCmd;    ///< command: parallelMerge
 };
 
 #endif //TG4_RUN_ACTION_MESSENGER_H
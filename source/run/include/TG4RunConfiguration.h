@@ -68,6 +68,16 @@ class G4UImessenger;
 /// When more than one options are selected, they should be separated with '+'
 /// character: eg. stepLimit+specialCuts.
 ///
+/// In MT mode, the worker threads can be pinned to CPUs via 
+/// SetThreadAffinity() (or /mcControl/threadAffinity command):
+/// - none     - threads are not pinned (default)
+/// - compact  - threads are pinned to CPUs filling one NUMA node after another
+/// - scatter  - threads are pinned to CPUs alternating NUMA nodes
+///
+/// In MT mode, the output of worker threads can be buffered per thread
+/// and written asynchronously via SetBufferedOutput() 
+/// (or /mcControl/bufferedOutput command).
+///
 /// \author I. Hrivnacova; IPN, Orsay
 
 class TG4RunConfiguration 
@@ -98,6 +108,8 @@ class TG4RunConfiguration
 
     // set methods
     void  SetMTApplication(Bool_t mtApplication);
+    void  SetThreadAffinity(const TString& threadAffinity);
+    void  SetBufferedOutput(Bool_t bufferedOutput);
 
     // get methods
     TString  GetUserGeometry() const;
@@ -106,6 +118,8 @@ class TG4RunConfiguration
     Bool_t   IsSpecialControls() const;
     Bool_t   IsSpecialCuts() const;
     Bool_t   IsMTApplication() const;
+    TString  GetThreadAffinity() const;
+    Bool_t   IsBufferedOutput() const;
 
   protected:
     // data members
@@ -116,6 +130,8 @@ class TG4RunConfiguration
     Bool_t         fMTApplication;          ///< option for MT mode if available
     Bool_t         fSpecialControls;        ///< option for special controls
     Bool_t         fSpecialCuts;            ///< option for special cuts
+    TString        fThreadAffinity;         ///< option for pinning worker threads
+    Bool_t         fBufferedOutput;         ///< option for buffered worker output
     G4UImessenger* fAGDDMessenger;          //!< XML messenger
     G4UImessenger* fGDMLMessenger;          //!< XML messenger
 
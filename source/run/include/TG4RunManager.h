@@ -38,6 +38,21 @@ class TApplication;
 /// It provides also methods for switching between Geant4 and
 /// Root UIs.
 ///
+/// In sequential mode, the run can be processed in several forked 
+/// processes (see SetNofProcesses()). The geometry and physics tables 
+/// are then initialized once, before forking, and shared copy-on-write
+/// by the child processes. Each child process processes its part of 
+/// events with its own random seed, calling the application 
+/// BeginRunOnWorker() and FinishRunOnWorker(), and writes the Root files
+/// opened by the application in its own files (with "_processN" suffix);
+/// these files are merged by the parent process in the files
+/// with "_merged" suffix. Each child process gets its range of events:
+/// the events numbers (see CurrentEvent()) start from the first event of
+/// the range and the random seed is derived from it, so that the event
+/// numbers in the merged files are unique. The output of each child process
+/// is written in the processN.log file and the child exits with a non-zero
+/// status if processing has failed.
+///
 /// \author I. Hrivnacova; IPN, Orsay
 
 class TG4RunManager : public TG4Verbose
@@ -55,6 +70,7 @@ class TG4RunManager : public TG4Verbose
     void LateInitialize();
     void ProcessEvent();
     Bool_t ProcessRun(G4int nofEvents);
+    Bool_t ReplayEvent(const G4String& randomStatusFile);
 
     // get methods
     Int_t   CurrentEvent() const;
@@ -72,6 +88,9 @@ class TG4RunManager : public TG4Verbose
     void ProcessRootCommand(G4String command);
     void UseG3Defaults();   
     void UseRootRandom(G4bool useRootRandom);   
+    void SetNofProcesses(G4int nofProcesses);
+    void SetThreadAffinity(const G4String& threadAffinity);
+    void SetBufferedOutput(G4bool bufferedOutput);
 
   private:
     /// Not implemented
@@ -87,6 +106,10 @@ class TG4RunManager : public TG4Verbose
     void FilterARGV(const G4String& option);
     void CreateRootUI();
     void SetRandomSeed();
+    Bool_t ProcessRunInProcesses(G4int nofEvents);
+    void ProcessEventsInChild(G4int rank, G4int firstEvent, G4int nofEvents,
+                              UInt_t seed);
+    void MergeProcessOutputFiles();
     
     // static data members
 
@@ -107,6 +130,8 @@ class TG4RunManager : public TG4Verbose
     G4int                 fARGC;             ///< argc 
     char**                fARGV;             ///< argv
     G4bool                fUseRootRandom;    ///< the option to use Root random number seed
+    G4int                 fNofProcesses;     ///< the number of forked processes
+    G4int                 fFirstEvent;       ///< the first event number in a forked process
 };
 
 // inline methods
@@ -121,5 +146,11 @@ inline void TG4RunManager::UseRootRandom(G4bool useRootRandom) {
   fUseRootRandom = useRootRandom;
 }   
 
+inline void TG4RunManager::SetNofProcesses(G4int nofProcesses) {
+  /// Set the number of processes forked to process a run 
+  /// (applied in sequential mode only)
+  fNofProcesses = nofProcesses;
+}   
+
 #endif //TG4_RUN_MANAGER_H
 
@@ -25,6 +25,7 @@ class G4UIdirectory;
 class G4UIcmdWithoutParameter;
 class G4UIcmdWithAString;
 class G4UIcmdWithABool;
+class G4UIcmdWithAnInteger;
 
 /// \ingroup run
 /// \brief Messenger class that defines commands for TG4RunManager
@@ -35,6 +36,11 @@ class G4UIcmdWithABool;
 /// - /mcControl/rootCmd [cmdString]
 /// - /mcControl/useRootRandom [true|false]
 /// - /mcControl/g3Defaults
+/// - /mcControl/replayEvent [randomStatusFile]
+/// - /mcControl/nofProcesses [value]
+/// - /mcControl/threadAffinity [none|compact|scatter]
+/// - /mcControl/bufferedOutput [true|false]
+/// - /mcControl/maxWarnings [value]
 ///
 /// \author I. Hrivnacova; IPN, Orsay
 
@@ -64,6 +70,11 @@ class TG4RunMessenger: public G4UImessenger
     TG4UICmdWithAComplexString* fRootCommandCmd;  ///< command: rootCmd 
     G4UIcmdWithABool*           fUseRootRandomCmd;///< command: useRootRandom   
     G4UIcmdWithoutParameter*    fG3DefaultsCmd;   ///< command: g3Defaults   
+    G4UIcmdWithAString*         fReplayEventCmd;  ///< command: replayEvent
+    G4UIcmdWithAnInteger*       fNofProcessesCmd; ///< command: nofProcesses
+    G4UIcmdWithAString*         fThreadAffinityCmd; ///< command: threadAffinity
+    G4UIcmdWithABool*           fBufferedOutputCmd; ///< command: bufferedOutput
+    G4UIcmdWithAnInteger*       fMaxWarningsCmd;    ///< command: maxWarnings
 };
 
 #endif //TG4_RUN_MESSENGER_H
@@ -15,26 +15,44 @@
 ///
 /// \author I. Hrivnacova; IPN Orsay
 
+#include "TG4Verbose.h"
+
 #include <G4UserWorkerInitialization.hh>
 
+class TG4RunConfiguration;
+
 /// \ingroup run
 /// \brief Actions at start and end of run on a worker (call in MT mode only)
 ///
+/// If selected in TG4RunConfiguration, the worker thread is pinned to 
+/// a CPU when it is started, before the worker run manager and all other 
+/// thread-local objects are created, so that they are allocated
+/// in the memory of the CPU NUMA node.
+///
+/// Only the CPUs allowed for the process are used; the pinning is reported
+/// with the verbose level > 0 (/mcVerbose/workerInitialization).
+///
+/// If selected in TG4RunConfiguration, the worker output is redirected
+/// to TG4BufferedCoutDestination, which is flushed at the end of each run.
+/// The worker output destination in use before is restored when
+/// the worker is stopped.
+///
 /// \author I. Hrivnacova; IPN, Orsay
 
-class TG4WorkerInitialization : public G4UserWorkerInitialization
+class TG4WorkerInitialization : public G4UserWorkerInitialization,
+                                public TG4Verbose
 {
   public:
-    TG4WorkerInitialization();
+    TG4WorkerInitialization(TG4RunConfiguration* runConfiguration);
     virtual ~TG4WorkerInitialization();
 
     // methods 
     //
-    //virtual void WorkerInitialize() const;
+    virtual void WorkerInitialize() const;
     // This method is called after the tread is created but before the
     // G4WorkerRunManager is instantiated.
 
-    //virtual void WorkerStart() const;
+    virtual void WorkerStart() const;
     // This method is called once at the beginning of simulation job
     // when kernel classes and user action classes have already instantiated
     // but geometry and physics have not been yet initialized. This situation
@@ -55,10 +73,15 @@ class TG4WorkerInitialization : public G4UserWorkerInitialization
     // Implement here a clean up action.
  
   private:
+    /// Not implemented
+    TG4WorkerInitialization();
     /// Not implemented
     TG4WorkerInitialization(const TG4WorkerInitialization& right);
     /// Not implemented
     TG4WorkerInitialization& operator=(const TG4WorkerInitialization& right);
+
+    // data members
+    TG4RunConfiguration* fRunConfiguration; ///< run configuration
 };
 
 #endif //TG4_WORKER_INITIALIZATION_H
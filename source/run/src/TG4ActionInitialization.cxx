@@ -127,6 +127,18 @@ void TG4ActionInitialization::Build() const
           = static_cast<TG4EventAction*>(fEventAction);
         tg4EventAction->SetPrintMemory(masterEventAction->GetPrintMemory());
         tg4EventAction->SetSaveRandomStatus(masterEventAction->GetSaveRandomStatus());
+        tg4EventAction->SetSaveSlowEventRandomStatus(
+          masterEventAction->GetSaveSlowEventRandomStatus());
+        tg4EventAction->SetSlowEventTimeThreshold(
+          masterEventAction->GetSlowEventTimeThreshold());
+        tg4EventAction->SetSlowEventMemoryThreshold(
+          masterEventAction->GetSlowEventMemoryThreshold());
+        tg4EventAction->GetWatchdog()->SetMaxCpuTime(
+          masterEventAction->GetWatchdog()->GetMaxCpuTime());
+        tg4EventAction->GetWatchdog()->SetMaxNofSteps(
+          masterEventAction->GetWatchdog()->GetMaxNofSteps());
+        tg4EventAction->GetWatchdog()->SetMaxMemory(
+          masterEventAction->GetWatchdog()->GetMaxMemory());
         tg4EventAction->VerboseLevel(masterEventAction->VerboseLevel());
       }
     }
@@ -0,0 +1,113 @@
+//------------------------------------------------
+// The Geant4 Virtual Monte Carlo package
+// Copyright (C) 2017 Ivana Hrivnacova
+// All rights reserved.
+//
+// For the licensing terms see geant4_vmc/LICENSE.
+// Contact: root-vmc@cern.ch
+//-------------------------------------------------
+
+/// \file TG4ParallelMerger.cxx
+/// \brief Implementation of the TG4ParallelMerger class 
+///
+/// \author I. Hrivnacova; IPN, Orsay
+
+#include "TG4ParallelMerger.h"
+#include "TG4Globals.h"
+
+#include <G4AutoLock.hh>
+#include <G4Threading.hh>
+
+#include <TVirtualMCApplication.h>
+
+// mutex and condition in a file scope
+
+#ifdef G4MULTITHREADED
+namespace {
+  //Mutex to lock the merging state
+  G4Mutex mergeStateMutex = G4MUTEX_INITIALIZER;
+  //Condition to signal a change of the merging state
+  G4Condition mergeStateChanged = G4CONDITION_INITIALIZER;
+}
+#endif
+
+std::vector<TVirtualMCApplication*>  TG4ParallelMerger::fgApplications;
+std::vector<G4int>  TG4ParallelMerger::fgNofMerged;
+
+//_____________________________________________________________________________
+TG4ParallelMerger::~TG4ParallelMerger()
+{
+/// Destructor
+}
+
+//
+// public static methods
+//
+
+//_____________________________________________________________________________
+void TG4ParallelMerger::Reset(G4int nofWorkers)
+{
+/// Reset the merging state for a new run.
+/// This function must be called on master before the workers start 
+/// the run.
+
+#ifdef G4MULTITHREADED
+  G4AutoLock lm(&mergeStateMutex);
+  fgApplications.assign(nofWorkers, 0);
+  fgNofMerged.assign(nofWorkers, 0);
+  lm.unlock();
+#endif
+}
+
+//_____________________________________________________________________________
+void TG4ParallelMerger::Merge(TVirtualMCApplication* localApplication,
+                              TVirtualMCApplication* masterApplication)
+{
+/// Merge the local application with the applications of the partner 
+/// workers and, on the worker with rank 0, merge the result in the master
+/// application. 
+/// This function must be called by all workers.
+
+#ifdef G4MULTITHREADED
+  G4int rank = G4Threading::G4GetThreadId();
+  G4int nofWorkers = fgApplications.size();
+
+  if ( rank < 0 || rank >= nofWorkers ) {
+    TG4Globals::Exception(
+      "TG4ParallelMerger", "Merge",
+      "The merging state was not reset for this run.");
+    return;
+  }  
+
+  G4AutoLock lm(&mergeStateMutex);
+  fgApplications[rank] = localApplication;
+  fgNofMerged[rank] = 1;
+  G4CONDITIONBROADCAST(&mergeStateChanged);
+
+  for ( G4int step = 1; step < nofWorkers; step *= 2 ) {
+    // this worker application was (or will be) merged by its partner
+    if ( rank % (2*step) != 0 ) break;
+
+    G4int partner = rank + step;
+    if ( partner < nofWorkers ) {
+      // wait until the partner has merged its own subtree
+      while ( fgNofMerged[partner] < step ) {
+        G4CONDITIONWAIT(&mergeStateChanged, &mergeStateMutex);
+      }  
+
+      // merge without holding the lock, so that the merging 
+      // in other pairs can proceed in parallel
+      lm.unlock();
+      localApplication->Merge(fgApplications[partner]);
+      lm.lock();
+    }  
+
+    fgNofMerged[rank] = 2*step;
+    G4CONDITIONBROADCAST(&mergeStateChanged);
+  }
+  lm.unlock();
+
+  // the application of the worker with rank 0 holds all merged data
+  if ( rank == 0 ) masterApplication->Merge(localApplication);
+#endif
+}
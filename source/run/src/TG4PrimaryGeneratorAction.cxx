@@ -13,6 +13,7 @@
 /// \author I. Hrivnacova; IPN, Orsay
 
 #include "TG4PrimaryGeneratorAction.h"
+#include "TG4EventAction.h"
 #include "TG4ParticlesManager.h"
 #include "TG4TrackManager.h"
 #include "TG4StateManager.h"
@@ -21,6 +22,7 @@
 #include "TG4Globals.h"
 
 #include <G4Event.hh>
+#include <G4EventManager.hh>
 #include <G4ParticleTable.hh>
 #include <G4IonTable.hh>
 #include <G4ParticleDefinition.hh>
@@ -182,6 +184,13 @@ void TG4PrimaryGeneratorAction::GeneratePrimaries(G4Event* event)
   // Cache pointer to thread-local MC application
   TVirtualMCApplication* mcApplication = TVirtualMCApplication::Instance();
 
+  // Let the event action keep or restore the random status
+  // before generating primaries
+  TG4EventAction* eventAction
+    = dynamic_cast<TG4EventAction*>(
+        G4EventManager::GetEventManager()->GetUserEventAction());
+  if ( eventAction ) eventAction->BeginOfPrimaryGeneration();
+
   // Begin of event
   TG4StateManager::Instance()->SetNewState(kInEvent);
   mcApplication->BeginEvent();
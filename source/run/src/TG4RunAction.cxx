@@ -20,11 +20,22 @@
 #include "TGeant4.h"
 #include "TG4Globals.h"
 #include "TG4RegionsManager.h"
+#include "TG4ParallelMerger.h"
+#include "TG4EventAction.h"
+
+#ifdef USE_G4ROOT
+#include <TG4RootNavMgr.h>
+#include <TG4RootNavigator.h>
+#endif
 
 #include <G4Run.hh>
+#include <G4EventManager.hh>
 #include <Randomize.hh>
 #include <G4UImanager.hh>
 #include "G4AutoLock.hh"
+#ifdef G4MULTITHREADED
+#include <G4MTRunManager.hh>
+#endif
 
 #include <TObjArray.h>
 
@@ -49,7 +60,8 @@ TG4RunAction::TG4RunAction()
     fRunID(-1),
     fSaveRandomStatus(false),
     fReadRandomStatus(false),
-    fRandomStatusFile(fgkDefaultRandomStatusFile)
+    fRandomStatusFile(fgkDefaultRandomStatusFile),
+    fParallelMerge(false)
 {
 /// Default constructor
 
@@ -94,6 +106,12 @@ void TG4RunAction::BeginOfRunAction(const G4Run* run)
     }  
   }  
 
+  // let the event action prepare keeping the random status of events
+  TG4EventAction* eventAction
+    = dynamic_cast<TG4EventAction*>(
+        G4EventManager::GetEventManager()->GetUserEventAction());
+  if ( eventAction ) eventAction->PrepareNewRun();
+
   // activate random number status
   if ( fSaveRandomStatus) {
     G4UImanager::GetUIpointer()->ApplyCommand("/random/setSavingFlag true");
@@ -116,6 +134,15 @@ void TG4RunAction::BeginOfRunAction(const G4Run* run)
     }         
   }  
 
+#ifdef G4MULTITHREADED
+  // Reset the parallel merging state before workers start the run
+  if ( fParallelMerge && ! G4Threading::IsWorkerThread() && 
+       G4MTRunManager::GetMasterRunManager() ) {
+    TG4ParallelMerger::Reset(
+      G4MTRunManager::GetMasterRunManager()->GetNumberOfThreads());
+  }      
+#endif
+
   fTimer->Start();
 }
 
@@ -127,9 +154,15 @@ void TG4RunAction::EndOfRunAction(const G4Run* run)
 
 #ifdef G4MULTITHREADED
   // Merge user application data
-  G4AutoLock lm(&mergeMutex);
-  TGeant4::MasterApplicationInstance()->Merge(TVirtualMCApplication::Instance());
-  lm.unlock();
+  if ( fParallelMerge && G4Threading::IsWorkerThread() ) {
+    TG4ParallelMerger::Merge(TVirtualMCApplication::Instance(),
+                             TGeant4::MasterApplicationInstance());
+  }
+  else {
+    G4AutoLock lm(&mergeMutex);
+    TGeant4::MasterApplicationInstance()->Merge(TVirtualMCApplication::Instance());
+    lm.unlock();
+  }
 #endif
 
   if ( fCrossSectionManager.IsMakeHistograms() ) {
@@ -142,4 +175,18 @@ void TG4RunAction::EndOfRunAction(const G4Run* run)
     G4cout << "Time of this run:   " << *fTimer << G4endl;
     G4cout << "Number of events processed: " << run->GetNumberOfEvent() << G4endl;
   }    
+
+#ifdef USE_G4ROOT
+  // Report the navigation counters of this thread
+  TG4RootNavMgr* rootNavMgr = TG4RootNavMgr::GetInstance();
+  TG4RootNavigator* rootNavigator 
+    = rootNavMgr ? rootNavMgr->GetNavigator() : 0;
+  if ( rootNavigator && rootNavigator->GetNlocate() ) {
+    if ( VerboseLevel() > 0 ) rootNavigator->PrintCounters();
+    rootNavigator->ResetCounters();
+  }  
+#endif
+
+  // Report the warnings suppressed in this run
+  TG4Globals::PrintWarningsSummary();
 }    
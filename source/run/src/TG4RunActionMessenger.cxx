@@ -27,7 +27,8 @@ TG4RunActionMessenger::TG4RunActionMessenger(TG4RunAction* runAction)
     fRunDirectory(0),
     fSaveRandomStatusCmd(0),
     fReadRandomStatusCmd(0),
-    fRandomStatusFileCmd(0)
+    fRandomStatusFileCmd(0),
+    fParallelMergeCmd(0)
 { 
 /// Standard constructor
 
@@ -49,6 +50,13 @@ TG4RunActionMessenger::TG4RunActionMessenger(TG4RunAction* runAction)
   fRandomStatusFileCmd->SetParameterName("RandomFile", false);
   fRandomStatusFileCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
 
+  fParallelMergeCmd = new G4UIcmdWithABool("/mcRun/parallelMerge", this);
+  fParallelMergeCmd->SetGuidance("Merge workers data at the end of run pairwise in parallel");
+  fParallelMergeCmd->SetGuidance("(in log2(nofThreads) rounds) instead of one by one.");
+  fParallelMergeCmd->SetGuidance("The application FinishRunOnWorker() is then not locked and");
+  fParallelMergeCmd->SetGuidance("its Merge() must support merging two worker applications.");
+  fParallelMergeCmd->SetParameterName("ParallelMerge", false);
+  fParallelMergeCmd->AvailableForStates(G4State_PreInit, G4State_Init, G4State_Idle);
 }
 
 //_____________________________________________________________________________
@@ -60,6 +68,7 @@ TG4RunActionMessenger::~TG4RunActionMessenger()
   delete fSaveRandomStatusCmd;
   delete fReadRandomStatusCmd;
   delete fRandomStatusFileCmd;
+  delete fParallelMergeCmd;
 }
 
 //
@@ -84,4 +93,8 @@ void TG4RunActionMessenger::SetNewValue(G4UIcommand* command,
   { 
     fRunAction->SetRandomStatusFile(newValue); 
   }   
+  else if(command == fParallelMergeCmd)
+  { 
+    fRunAction->SetParallelMerge(fParallelMergeCmd->GetNewBoolValue(newValue)); 
+  }   
 }
@@ -50,6 +50,8 @@ TG4RunConfiguration::TG4RunConfiguration(const TString& userGeometry,
     fMTApplication(mtApplication),
     fSpecialControls(false),
     fSpecialCuts(false),
+    fThreadAffinity("none"),
+    fBufferedOutput(false),
     fAGDDMessenger(0),
     fGDMLMessenger(0)
     
@@ -315,6 +317,33 @@ void  TG4RunConfiguration::SetMTApplication(Bool_t mtApplication)
   fMTApplication = mtApplication;
 }
 
+//_____________________________________________________________________________
+void  TG4RunConfiguration::SetThreadAffinity(const TString& threadAffinity)
+{
+/// Select pinning of worker threads to CPUs (none, compact or scatter).
+
+  if ( threadAffinity != "none"  &&
+       threadAffinity != "compact" &&
+       threadAffinity != "scatter" ) {
+
+    TG4Globals::Exception(
+      "TG4RunConfiguration", "SetThreadAffinity",
+      "Thread affinity " + threadAffinity + " not recognized." 
+         + TG4Globals::Endl() +
+      "Available options: none compact scatter");
+  }
+
+  fThreadAffinity = threadAffinity;
+}
+
+//_____________________________________________________________________________
+void  TG4RunConfiguration::SetBufferedOutput(Bool_t bufferedOutput)
+{
+/// Select buffering of the worker threads output
+
+  fBufferedOutput = bufferedOutput;
+}
+
 //_____________________________________________________________________________
 TString TG4RunConfiguration::GetUserGeometry() const
 {
@@ -358,3 +387,19 @@ Bool_t  TG4RunConfiguration::IsMTApplication() const
 
   return fMTApplication;
 }
+
+//_____________________________________________________________________________
+TString  TG4RunConfiguration::GetThreadAffinity() const
+{
+/// Return the option for pinning worker threads to CPUs
+
+  return fThreadAffinity;
+}
+
+//_____________________________________________________________________________
+Bool_t  TG4RunConfiguration::IsBufferedOutput() const
+{
+/// Return true if the output of worker threads is buffered
+
+  return fBufferedOutput;
+}
@@ -56,8 +56,18 @@
 #include <TInterpreter.h>
 #include <TGeoManager.h>
 #include <TRandom.h>
+#include <TFile.h>
+#include <TFileMerger.h>
+#include <TSystem.h>
 #include <TVirtualMCApplication.h>
 
+#include <vector>
+#include <cstdio>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
 namespace {
 
 TG4EventAction* GetEventAction()
@@ -67,6 +77,33 @@ TG4EventAction* GetEventAction()
              G4RunManager::GetRunManager()->GetUserEventAction()));
 }
 
+TString GetProcessFileName(const TString& fileName, const TString& suffix)
+{
+  // Insert the suffix before the ".root" extension
+  TString processFileName(fileName);
+  if ( processFileName.EndsWith(".root") ) {
+    processFileName.Insert(processFileName.Length() - 5, suffix);
+  }
+  else {
+    processFileName += suffix;
+  }
+  return processFileName;
+}
+
+std::vector<TFile*> GetProcessOutputFiles()
+{
+  // Return the local Root files opened in write mode
+  std::vector<TFile*> files;
+  TIter next(gROOT->GetListOfFiles());
+  TFile* file;
+  while ( ( file = static_cast<TFile*>(next()) ) ) {
+    if ( file->IsWritable() && TString(file->ClassName()) == "TFile" ) {
+      files.push_back(file);
+    }
+  }
+  return files;
+}
+
 }
 
 //_____________________________________________________________________________
@@ -86,7 +123,9 @@ TG4RunManager::TG4RunManager(TG4RunConfiguration* runConfiguration,
     fRootUIOwner(false),
     fARGC(argc),
     fARGV(argv),  
-    fUseRootRandom(true) 
+    fUseRootRandom(true),
+    fNofProcesses(0),
+    fFirstEvent(0)
 {
 /// Standard constructor
 
@@ -222,7 +261,7 @@ void TG4RunManager::ConfigureRunManager()
   if (  fRunConfiguration->IsMTApplication() ) {
      fRunManager = new G4MTRunManager();
      fRunManager
-       ->SetUserInitialization(new TG4WorkerInitialization());
+       ->SetUserInitialization(new TG4WorkerInitialization(fRunConfiguration));
    }
    else {
      fRunManager =  new G4RunManager();
@@ -382,6 +421,196 @@ void TG4RunManager::SetRandomSeed()
   CLHEP::HepRandom::setTheSeeds(seeds);
 }
 
+//_____________________________________________________________________________
+Bool_t TG4RunManager::ProcessRunInProcesses(G4int nofEvents)
+{
+/// Initialize physics tables via a run without events and fork 
+/// fNofProcesses child processes which process the events.
+/// The parent process waits for all child processes and merges
+/// their output files.
+
+  // Build physics tables before forking
+  fRunManager->BeamOn(0);
+
+  // Flush the output so that it is not duplicated in the child processes
+  std::vector<TFile*> files = GetProcessOutputFiles();
+  for ( G4int i=0; i<G4int(files.size()); ++i ) files[i]->Flush();
+  G4cout << std::flush;
+  fflush(stdout);
+  fflush(stderr);
+
+  // generate the base seed in the parent to make the run reproducible
+  UInt_t baseSeed = gRandom->Integer(kMaxInt/2) + 1;
+
+  std::vector<pid_t> childPids;
+  G4int firstEvent = 0;
+  for ( G4int rank=0; rank<fNofProcesses; ++rank ) {
+    G4int nofChildEvents = nofEvents/fNofProcesses;
+    if ( rank < nofEvents%fNofProcesses ) ++nofChildEvents;
+
+    pid_t pid = fork();
+    if ( pid < 0 ) {
+      TG4Globals::Exception(
+        "TG4RunManager", "ProcessRunInProcesses", "Failed to fork process.");
+      return false;
+    }
+    if ( pid == 0 ) {
+      // this function does not return 
+      ProcessEventsInChild(rank, firstEvent, nofChildEvents, 
+                           baseSeed + firstEvent);
+    }
+    childPids.push_back(pid);
+    firstEvent += nofChildEvents;
+  }
+
+  // Collect the child processes
+  Bool_t result = true;
+  for ( G4int rank=0; rank<G4int(childPids.size()); ++rank ) {
+    int status = 0;
+    pid_t pid;
+    do {
+      pid = waitpid(childPids[rank], &status, 0);
+    } while ( pid < 0 && errno == EINTR );
+    if ( pid < 0 || ! WIFEXITED(status) || WEXITSTATUS(status) != 0 ) {
+      TString text = "Process ";
+      text += rank;
+      text += " has failed";
+      if ( pid >= 0 && WIFEXITED(status) ) {
+        text += " with status ";
+        text += WEXITSTATUS(status);
+      }  
+      else if ( pid >= 0 && WIFSIGNALED(status) ) {
+        text += " with signal ";
+        text += WTERMSIG(status);
+      }  
+      text += ", see process";
+      text += rank;
+      text += ".log.";
+      TG4Globals::Warning("TG4RunManager", "ProcessRunInProcesses", text);
+      result = false;
+    }
+  }
+
+  MergeProcessOutputFiles();
+
+  return result;
+}
+
+//_____________________________________________________________________________
+void TG4RunManager::ProcessEventsInChild(G4int rank, G4int firstEvent,
+                                         G4int nofEvents, UInt_t seed)
+{
+/// Process the given number of events in the forked child process and exit
+/// with a non-zero status if the processing has failed.
+/// The standard output and error are written in the processN.log file.
+/// The Root files opened by the application are redirected to 
+/// the files with "_processN" suffix; they are written and closed
+/// before exiting. The events are numbered from firstEvent 
+/// (see CurrentEvent()), so that the event numbers in the merged files
+/// are unique.
+
+  G4bool isOK = true;
+
+  TString suffix = "_process";
+  suffix += rank;
+
+  // Open the process log file before running
+  TString logFileName = "process";
+  logFileName += rank;
+  logFileName += ".log";
+  gSystem->Unlink(logFileName);
+  if ( ! freopen(logFileName.Data(), "a", stdout) || 
+       ! freopen(logFileName.Data(), "a", stderr) ) {
+    isOK = false;
+  }  
+
+  // Copy the content written before forking in the process file
+  // and let the application file write in it 
+  std::vector<TFile*> files = GetProcessOutputFiles();
+  for ( G4int i=0; i<G4int(files.size()); ++i ) {
+    TString processFileName = GetProcessFileName(files[i]->GetName(), suffix);
+    gSystem->CopyFile(files[i]->GetName(), processFileName, kTRUE);
+    int fd = open(processFileName.Data(), O_RDWR);
+    if ( fd < 0 || dup2(fd, files[i]->GetFd()) < 0 ) {
+      TG4Globals::Warning(
+        "TG4RunManager", "ProcessEventsInChild", 
+        "Failed to redirect output file " + TString(files[i]->GetName()));
+      isOK = false;
+    }
+    if ( fd >= 0 ) close(fd);
+  }
+
+  // Set the process own event numbering and random seed
+  fFirstEvent = firstEvent;
+  gRandom->SetSeed(seed);
+  SetRandomSeed();
+
+  if ( VerboseLevel() > 0 ) {
+    G4cout << "Process " << rank << " started: events "
+           << firstEvent << " - " << firstEvent + nofEvents - 1 << G4endl;
+  }
+
+  TVirtualMCApplication::Instance()->BeginWorkerRun();  // deprecated
+  TVirtualMCApplication::Instance()->BeginRunOnWorker(); // new
+
+  fRunManager->BeamOn(nofEvents);
+
+  TVirtualMCApplication::Instance()->FinishWorkerRun();  // deprecated
+  TVirtualMCApplication::Instance()->FinishRunOnWorker(); // new
+
+  // Write and close the files not closed by the application,
+  // as the Root cleanup is not called with _exit
+  files = GetProcessOutputFiles();
+  for ( G4int i=0; i<G4int(files.size()); ++i ) {
+    files[i]->Write();
+    if ( files[i]->TestBit(TFile::kWriteError) ) isOK = false;
+    files[i]->Close();
+  }
+
+  if ( TG4SDServices::Instance()->GetIsStopRun() ) isOK = false;
+
+  G4cout << std::flush;
+  fflush(stdout);
+  fflush(stderr);
+
+  // Do not return to the application macro
+  _exit(isOK ? 0 : 1);
+}
+
+//_____________________________________________________________________________
+void TG4RunManager::MergeProcessOutputFiles()
+{
+/// Merge the files written by the child processes in the files
+/// with "_merged" suffix.
+
+  // Get file names first as merger adds its files in the list of files
+  std::vector<TFile*> files = GetProcessOutputFiles();
+  std::vector<TString> fileNames;
+  for ( G4int i=0; i<G4int(files.size()); ++i ) {
+    fileNames.push_back(files[i]->GetName());
+  }
+
+  for ( G4int i=0; i<G4int(fileNames.size()); ++i ) {
+    TFileMerger merger(kFALSE);
+    merger.OutputFile(GetProcessFileName(fileNames[i], "_merged"), "RECREATE");
+    for ( G4int rank=0; rank<fNofProcesses; ++rank ) {
+      TString suffix = "_process";
+      suffix += rank;
+      merger.AddFile(GetProcessFileName(fileNames[i], suffix), kFALSE);
+    }
+
+    if ( ! merger.Merge() ) {
+      TG4Globals::Warning(
+        "TG4RunManager", "MergeProcessOutputFiles", 
+        "Failed to merge output files " + fileNames[i]);
+    }
+    else if ( VerboseLevel() > 0 ) {
+      G4cout << "Merged process output files in " 
+             << GetProcessFileName(fileNames[i], "_merged") << G4endl;
+    }  
+  }
+}
+
 // public methods
 
 //_____________________________________________________________________________
@@ -480,17 +709,52 @@ Bool_t TG4RunManager::ProcessRun(G4int nofEvents)
 {
 /// Process Geant4 run.
 
-  fRunManager->BeamOn(nofEvents); 
+  G4bool isMultiProcess = ( fNofProcesses > 1 );
+#ifdef G4MULTITHREADED
+  if ( isMultiProcess && fRunConfiguration->IsMTApplication() ) {
+    TG4Globals::Warning(
+      "TG4RunManager", "ProcessRun", 
+      "Processing run in forked processes is not available in MT mode.");
+    isMultiProcess = false;
+  }
+#endif
+
+  G4bool isProcessed = true;
+  if ( isMultiProcess ) {
+    isProcessed = ProcessRunInProcesses(nofEvents);
+  }
+  else {
+    fRunManager->BeamOn(nofEvents); 
+  }
 
   // Pring field statistics
   TG4GeometryManager::Instance()->PrintFieldStatistics();
 
-  G4bool result = ! TG4SDServices::Instance()->GetIsStopRun();
+  G4bool result = isProcessed && ! TG4SDServices::Instance()->GetIsStopRun();
   TG4SDServices::Instance()->SetIsStopRun(false);
   
   return result;
 }
     
+//_____________________________________________________________________________
+Bool_t TG4RunManager::ReplayEvent(const G4String& randomStatusFile)
+{
+/// Re-simulate one event with the random engine status restored 
+/// from the given file (saved by TG4EventAction for slow events).
+/// The Geant4 random engine and the Root gRandom (if its status file
+/// is present) are restored before the primary particles are generated.
+/// The command is used in order to be broadcasted to workers in MT mode.
+
+  G4UImanager* pUI = G4UImanager::GetUIpointer();  
+  pUI->ApplyCommand("/mcEvent/replayRandom " + randomStatusFile);
+
+  Bool_t result = ProcessRun(1);
+
+  pUI->ApplyCommand("/mcEvent/replayRandom none");
+
+  return result;
+}
+    
 //_____________________________________________________________________________
 void TG4RunManager::CreateGeantUI()
 {
@@ -606,13 +870,33 @@ void TG4RunManager::UseG3Defaults()
   TG4G3PhysicsManager::Instance()->SetG3DefaultControls();
 }
 
+//_____________________________________________________________________________
+void TG4RunManager::SetThreadAffinity(const G4String& threadAffinity) 
+{
+/// Set the option for pinning worker threads to CPUs
+/// (applied when worker threads are started).
+
+  fRunConfiguration->SetThreadAffinity(threadAffinity.data());
+}
+
+//_____________________________________________________________________________
+void TG4RunManager::SetBufferedOutput(G4bool bufferedOutput) 
+{
+/// Set the option for buffering the output of worker threads
+/// (applied when worker threads are started).
+
+  fRunConfiguration->SetBufferedOutput(bufferedOutput);
+}
+
 //_____________________________________________________________________________
 Int_t TG4RunManager::CurrentEvent() const
 {
-/// Return the number of the current event.
+/// Return the number of the current event;
+/// in a forked child process it is shifted by the number of the first
+/// event of the process.
 
   G4int eventID = fRunManager->GetCurrentEvent()->GetEventID();
-  return eventID;
+  return eventID + fFirstEvent;
 }
 
 //_____________________________________________________________________________
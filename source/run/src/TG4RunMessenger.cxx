@@ -21,6 +21,7 @@
 #include <G4UIcmdWithoutParameter.hh>
 #include <G4UIcmdWithAString.hh>
 #include <G4UIcmdWithABool.hh>
+#include <G4UIcmdWithAnInteger.hh>
 
 //_____________________________________________________________________________
 TG4RunMessenger::TG4RunMessenger(TG4RunManager* runManager)
@@ -31,7 +32,12 @@ TG4RunMessenger::TG4RunMessenger(TG4RunManager* runManager)
     fRootMacroCmd(0),  
     fRootCommandCmd(0),
     fUseRootRandomCmd(0),
-    fG3DefaultsCmd(0)
+    fG3DefaultsCmd(0),
+    fReplayEventCmd(0),
+    fNofProcessesCmd(0),
+    fThreadAffinityCmd(0),
+    fBufferedOutputCmd(0),
+    fMaxWarningsCmd(0)
 { 
 /// Standard constructor
 
@@ -66,6 +72,43 @@ TG4RunMessenger::TG4RunMessenger(TG4RunManager* runManager)
   fG3DefaultsCmd->SetGuidance("Set G3 default parameters (cut values,");
   fG3DefaultsCmd->SetGuidance("tracking media max step values, ...)");
   fG3DefaultsCmd->AvailableForStates(G4State_PreInit);
+
+  fReplayEventCmd = new G4UIcmdWithAString("/mcControl/replayEvent", this);
+  fReplayEventCmd->SetGuidance("Re-simulate one event with the random engine status");
+  fReplayEventCmd->SetGuidance("restored from the given file (eg. slowEvent_run0evt5.rndm)");
+  fReplayEventCmd->SetParameterName("randomStatusFile", false);
+  fReplayEventCmd->AvailableForStates(G4State_Idle);
+
+  fNofProcessesCmd = new G4UIcmdWithAnInteger("/mcControl/nofProcesses", this);
+  fNofProcessesCmd->SetGuidance("Set the number of processes forked to process a run");
+  fNofProcessesCmd->SetGuidance("after geometry and physics initialization");
+  fNofProcessesCmd->SetGuidance("(available in sequential mode only)");
+  fNofProcessesCmd->SetParameterName("NofProcesses", false);
+  fNofProcessesCmd->SetRange("NofProcesses>=0");
+  fNofProcessesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fThreadAffinityCmd = new G4UIcmdWithAString("/mcControl/threadAffinity", this);
+  fThreadAffinityCmd->SetGuidance("Select pinning of worker threads to CPUs (MT mode only):");
+  fThreadAffinityCmd->SetGuidance("none    - threads are not pinned");
+  fThreadAffinityCmd->SetGuidance("compact - fill one NUMA node after another");
+  fThreadAffinityCmd->SetGuidance("scatter - alternate NUMA nodes");
+  fThreadAffinityCmd->SetParameterName("ThreadAffinity", false);
+  fThreadAffinityCmd->SetCandidates("none compact scatter");
+  fThreadAffinityCmd->AvailableForStates(G4State_PreInit);
+
+  fBufferedOutputCmd = new G4UIcmdWithABool("/mcControl/bufferedOutput", this);
+  fBufferedOutputCmd->SetGuidance("(In)Activate buffering of worker threads output");
+  fBufferedOutputCmd->SetGuidance("written asynchronously (MT mode only)");
+  fBufferedOutputCmd->SetParameterName("BufferedOutput", true);
+  fBufferedOutputCmd->AvailableForStates(G4State_PreInit);
+
+  fMaxWarningsCmd = new G4UIcmdWithAnInteger("/mcControl/maxWarnings", this);
+  fMaxWarningsCmd->SetGuidance("Set the maximum number of printed warnings per method");
+  fMaxWarningsCmd->SetGuidance("and thread; the further warnings are only counted");
+  fMaxWarningsCmd->SetGuidance("and reported at the end of run (0 = no limit, default)");
+  fMaxWarningsCmd->SetParameterName("MaxWarnings", false);
+  fMaxWarningsCmd->SetRange("MaxWarnings>=0");
+  fMaxWarningsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
 }
 
 //_____________________________________________________________________________
@@ -79,6 +122,11 @@ TG4RunMessenger::~TG4RunMessenger()
   delete fRootCommandCmd;
   delete fUseRootRandomCmd;
   delete fG3DefaultsCmd;
+  delete fReplayEventCmd;
+  delete fNofProcessesCmd;
+  delete fThreadAffinityCmd;
+  delete fBufferedOutputCmd;
+  delete fMaxWarningsCmd;
 }
 
 //
@@ -105,4 +153,19 @@ void TG4RunMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
   else if (command == fG3DefaultsCmd) {
     fRunManager->UseG3Defaults(); 
   }
+  else if (command == fReplayEventCmd) {
+    fRunManager->ReplayEvent(newValue); 
+  }
+  else if (command == fNofProcessesCmd) {
+    fRunManager->SetNofProcesses(fNofProcessesCmd->GetNewIntValue(newValue)); 
+  }
+  else if (command == fThreadAffinityCmd) {
+    fRunManager->SetThreadAffinity(newValue); 
+  }
+  else if (command == fBufferedOutputCmd) {
+    fRunManager->SetBufferedOutput(fBufferedOutputCmd->GetNewBoolValue(newValue)); 
+  }
+  else if (command == fMaxWarningsCmd) {
+    TG4Globals::SetMaxWarnings(fMaxWarningsCmd->GetNewIntValue(newValue)); 
+  }
 }
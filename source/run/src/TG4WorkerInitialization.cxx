@@ -14,10 +14,27 @@
 
 #include "TG4WorkerInitialization.h"
 #include "TG4RunManager.h"
+#include "TG4RunAction.h"
+#include "TG4RunConfiguration.h"
+#include "TG4BufferedCoutDestination.h"
 
 #include <TVirtualMCApplication.h>
 
 #include <G4AutoLock.hh>
+#include <G4RunManager.hh>
+#include <G4Threading.hh>
+#include <G4Timer.hh>
+#include <G4ios.hh>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 #ifdef G4MULTITHREADED
 namespace {
@@ -30,9 +47,105 @@ namespace {
 }
 #endif
 
+namespace {
+  // Timer measuring the worker startup (from the thread creation
+  // till the end of the first worker run initialization)
+  G4ThreadLocal G4Timer* startupTimer = 0;
+  // The buffered output destination (if selected)
+  G4ThreadLocal TG4BufferedCoutDestination* coutDestination = 0;
+  // The destinations replaced with the buffered output destination
+  G4ThreadLocal G4coutDestination* previousCoutDestination = 0;
+  G4ThreadLocal G4coutDestination* previousCerrDestination = 0;
+}
+
+namespace {
+
+std::vector<G4int> ParseCpuList(const std::string& cpuList)
+{
+  // Parse the cpu list in the Linux format, eg. "0-7,16-23"
+  std::vector<G4int> cpus;
+  std::istringstream input(cpuList);
+  std::string range;
+  while ( std::getline(input, range, ',') ) {
+    G4int first = 0;
+    G4int last = 0;
+    char separator = 0;
+    std::istringstream rangeInput(range);
+    if ( ! ( rangeInput >> first ) ) continue;
+    if ( ! ( rangeInput >> separator >> last ) ) last = first;
+    for ( G4int cpu = first; cpu <= last; ++cpu ) cpus.push_back(cpu);
+  }
+  return cpus;
+}
+
+std::vector<G4int> GetOrderedCpus(const TString& threadAffinity)
+{
+  // Return the CPUs in the order in which the threads are pinned:
+  // compact - CPUs of one NUMA node after another,
+  // scatter - CPUs alternating NUMA nodes
+  // Only the CPUs allowed for the process (eg. by cpusets) are used.
+
+  std::vector< std::vector<G4int> > nodeCpus;
+  std::vector<G4int> allowedCpus;
+#ifdef __linux__
+  cpu_set_t allowedSet;
+  CPU_ZERO(&allowedSet);
+  if ( sched_getaffinity(0, sizeof(cpu_set_t), &allowedSet) == 0 ) {
+    for ( G4int cpu = 0; cpu < CPU_SETSIZE; ++cpu ) {
+      if ( CPU_ISSET(cpu, &allowedSet) ) allowedCpus.push_back(cpu);
+    }
+  }
+
+  for ( G4int node = 0; ; ++node ) {
+    std::ostringstream path;
+    path << "/sys/devices/system/node/node" << node << "/cpulist";
+    std::ifstream input(path.str().c_str());
+    if ( ! input ) break;
+    std::string cpuList;
+    std::getline(input, cpuList);
+    std::vector<G4int> cpus;
+    std::vector<G4int> nodeCpuList = ParseCpuList(cpuList);
+    for ( G4int i = 0; i < G4int(nodeCpuList.size()); ++i ) {
+      if ( CPU_ISSET(nodeCpuList[i], &allowedSet) ) cpus.push_back(nodeCpuList[i]);
+    }
+    if ( ! cpus.empty() ) nodeCpus.push_back(cpus);
+  }
+#endif
+
+  // No NUMA information: all allowed cores in one node 
+  if ( nodeCpus.empty() ) {
+    nodeCpus.push_back(allowedCpus);
+  }
+
+  std::vector<G4int> cpus;
+  if ( threadAffinity == "compact" ) {
+    for ( G4int node = 0; node < G4int(nodeCpus.size()); ++node ) {
+      cpus.insert(cpus.end(), nodeCpus[node].begin(), nodeCpus[node].end());
+    }
+  }
+  else {
+    G4bool isAdded = true;
+    for ( G4int i = 0; isAdded; ++i ) {
+      isAdded = false;
+      for ( G4int node = 0; node < G4int(nodeCpus.size()); ++node ) {
+        if ( i < G4int(nodeCpus[node].size()) ) {
+          cpus.push_back(nodeCpus[node][i]);
+          isAdded = true;
+        }
+      }
+    }
+  }
+  return cpus;
+}
+
+}
+
 //_____________________________________________________________________________
-TG4WorkerInitialization::TG4WorkerInitialization()
-  : G4UserWorkerInitialization()
+TG4WorkerInitialization::TG4WorkerInitialization(
+                                  TG4RunConfiguration* runConfiguration)
+  : G4UserWorkerInitialization(),
+    TG4Verbose("workerInitialization", 0),
+    fRunConfiguration(runConfiguration)
 {
 /// Standard constructor
 }
@@ -47,10 +160,72 @@ TG4WorkerInitialization::~TG4WorkerInitialization()
 // public methods
 //
 
+//_____________________________________________________________________________
+void TG4WorkerInitialization::WorkerInitialize() const
+{
+/// Pin the worker thread to a CPU if selected.
+/// This method is called after the tread is created but before the
+/// G4WorkerRunManager is instantiated.
+/// The worker startup timer is started here.
+
+  startupTimer = new G4Timer();
+  startupTimer->Start();
+
+  TString threadAffinity = fRunConfiguration->GetThreadAffinity();
+  if ( threadAffinity == "none" ) return;
+
+#ifdef __linux__
+  std::vector<G4int> cpus = GetOrderedCpus(threadAffinity);
+  if ( cpus.empty() ) return;
+
+  G4int threadId = G4Threading::G4GetThreadId();
+  G4int cpu = cpus[threadId % cpus.size()];
+
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(cpu, &cpuSet);
+  if ( pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) != 0 ) {
+    G4cerr << "Failed to pin worker thread " << threadId 
+           << " to CPU " << cpu << G4endl;
+    return;
+  }
+
+  if ( VerboseLevel() > 0 ) {
+    G4cout << "Worker thread " << threadId << " pinned to CPU " << cpu 
+           << " (" << threadAffinity << ")" << G4endl;
+  }
+#else
+  if ( VerboseLevel() > 0 ) {
+    G4cout << "Pinning worker threads is available on Linux only." << G4endl;
+  }
+#endif
+}
+
+//_____________________________________________________________________________
+void TG4WorkerInitialization::WorkerStart() const
+{
+/// Install the buffered output destination if selected.
+/// This method is called after the worker G4cout destination
+/// is set up, at the beginning of the simulation job; this destination
+/// is kept and restored in WorkerStop().
+
+  if ( ! fRunConfiguration->IsBufferedOutput() ) return;
+
+  previousCoutDestination = G4coutbuf.GetDestination();
+  previousCerrDestination = G4cerrbuf.GetDestination();
+
+  coutDestination 
+    = new TG4BufferedCoutDestination(G4Threading::G4GetThreadId());
+  G4coutbuf.SetDestination(coutDestination);
+  G4cerrbuf.SetDestination(coutDestination);
+}
+
 //_____________________________________________________________________________
 void TG4WorkerInitialization::WorkerRunStart() const
 {
-/// Call post initialization on workers
+/// Call post initialization on workers.
+/// At the first run, the worker startup time is reported
+/// with the verbose level > 0.
 
   //G4cout << "TG4WorkerInitialization::WorkerRunStart() " << G4endl;
 
@@ -59,6 +234,16 @@ void TG4WorkerInitialization::WorkerRunStart() const
   TVirtualMCApplication::Instance()->BeginWorkerRun();  // deprecated
   TVirtualMCApplication::Instance()->BeginRunOnWorker(); // new
 #endif
+
+  if ( startupTimer ) {
+    startupTimer->Stop();
+    if ( VerboseLevel() > 0 ) {
+      G4cout << "Worker thread " << G4Threading::G4GetThreadId() 
+             << " startup time: " << *startupTimer << G4endl;
+    }
+    delete startupTimer;
+    startupTimer = 0;
+  }
   //G4cout << "TG4WorkerInitialization::WorkerRunStart() end " << G4endl;
 }   
 
@@ -72,12 +257,28 @@ void TG4WorkerInitialization::WorkerRunEnd() const
   //G4cout << "TG4WorkerInitialization::WorkerRunEnd() " << G4endl;
 
 #ifdef G4MULTITHREADED
-  G4AutoLock lm(&finishRunMutex);
-  TVirtualMCApplication::Instance()->FinishWorkerRun();  // deprecated
-  TVirtualMCApplication::Instance()->FinishRunOnWorker(); // new
-  lm.unlock();
+  // The application finish run is not locked when the parallel merging
+  // is activated
+  const TG4RunAction* runAction
+    = dynamic_cast<const TG4RunAction*>(
+        G4RunManager::GetRunManager()->GetUserRunAction());
+  G4bool isParallelMerge = runAction && runAction->GetParallelMerge();
+
+  if ( isParallelMerge ) {
+    TVirtualMCApplication::Instance()->FinishWorkerRun();  // deprecated
+    TVirtualMCApplication::Instance()->FinishRunOnWorker(); // new
+  }
+  else {
+    G4AutoLock lm(&finishRunMutex);
+    TVirtualMCApplication::Instance()->FinishWorkerRun();  // deprecated
+    TVirtualMCApplication::Instance()->FinishRunOnWorker(); // new
+    lm.unlock();
+  }
 #endif
 
+  // Pass the output of this run to the writer
+  if ( coutDestination ) coutDestination->Flush();
+
   //G4cout << "TG4WorkerInitialization::WorkerRunEnd() end " << G4endl;
 }
 
@@ -98,5 +299,15 @@ void TG4WorkerInitialization::WorkerStop() const
   lm.unlock();
 #endif
 
+  // Write all buffered output and restore the worker output destination
+  if ( coutDestination ) {
+    G4coutbuf.SetDestination(previousCoutDestination);
+    G4cerrbuf.SetDestination(previousCerrDestination);
+    delete coutDestination;
+    coutDestination = 0;
+    previousCoutDestination = 0;
+    previousCerrDestination = 0;
+  }  
+
   //G4cout << "TG4WorkerInitialization::WorkerStop() end " << G4endl;
 }
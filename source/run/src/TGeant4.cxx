@@ -17,6 +17,7 @@
 #include "TG4RunConfiguration.h"
 #include "TG4StateManager.h" 
 #include "TG4GeometryManager.h" 
+#include "TG4LegoScanner.h"
 #include "TG4OpGeometryManager.h" 
 #include "TG4SDManager.h" 
 #include "TG4PhysicsManager.h" 
@@ -1351,8 +1352,8 @@ void TGeant4::Gdman(Double_t /*u*/, Double_t /*v*/, const char* /*type*/)
 //_____________________________________________________________________________
 void TGeant4::InitLego() 
 { 
-/// Function not implemented.
-/// Return warning.
+/// Perform the material budget (lego) scan defined via /mcLego commands.
+/// The scan navigates the geometry directly, without running events.
 
-  TG4Globals:: Warning("TGeant4", "InitLego", "Not implemented."); 
+  fGeometryManager->GetLegoScanner()->Scan();
 }